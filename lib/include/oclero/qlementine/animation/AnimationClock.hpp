@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QAnimationDriver>
+#include <QElapsedTimer>
+#include <QTimer>
+
+namespace oclero::qlementine {
+/// A virtual clock that replaces the wall clock for all the animations of the GUI thread
+/// (QVariantAnimation, WidgetAnimation, LoadingSpinner...) once installed.
+/// By default, it is frozen: time only advances when step() or fastForward() are called,
+/// which allows to render specific animation frames deterministically (tests, screenshots, benchmarks).
+class AnimationClock : public QAnimationDriver {
+  Q_OBJECT
+
+public:
+  explicit AnimationClock(QObject* parent = nullptr);
+  ~AnimationClock() override;
+
+  /// Makes this clock drive all the animations, instead of the wall clock.
+  void install();
+  void uninstall();
+  bool isInstalled() const;
+
+  /// The clock currently driving the animations, if any.
+  static AnimationClock* installedClock();
+
+  /// When frozen, time only advances with step() and fastForward(). Otherwise, it follows the wall clock.
+  bool frozen() const;
+  void setFrozen(bool frozen);
+
+  /// Virtual time, in milliseconds, since the clock has been created.
+  qint64 currentTime() const;
+  Q_SIGNAL void currentTimeChanged();
+
+  /// Advances time by the given milliseconds.
+  /// Pending queued calls (animations to start, repaints...) are processed first.
+  void step(int milliseconds);
+
+  /// Advances time, frame by frame, until no animation is running anymore, or until maxDuration is reached
+  /// (looping animations never end).
+  void fastForward(int maxDuration = 10000);
+
+public: // QAnimationDriver override.
+  qint64 elapsed() const override;
+
+protected: // QAnimationDriver override.
+  void start() override;
+  void stop() override;
+
+private:
+  qint64 _currentTime{ 0 };
+  qint64 _startTime{ 0 };
+  bool _frozen{ true };
+  QTimer _wallClockTimer;
+  QElapsedTimer _wallClock;
+};
+} // namespace oclero::qlementine
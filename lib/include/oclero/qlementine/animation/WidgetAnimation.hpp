@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <oclero/qlementine/utils/WidgetUtils.hpp>
+
 #include <QObject>
 #include <QEvent>
 #include <QWidget>
@@ -20,10 +22,16 @@ public:
     if (parentWidget) {
       _qVariantAnimation.setEasingCurve(QEasingCurve::Type::OutCubic);
       QObject::connect(
-        &_qVariantAnimation, &QVariantAnimation::valueChanged, parentWidget,
-        [parentWidget](const QVariant&) {
-          // Force widget repaint.
-          parentWidget->update();
+        &_qVariantAnimation, &QVariantAnimation::valueChanged, this,
+        [this, parentWidget](const QVariant&) {
+          if (isWidgetVisibleOnScreen(parentWidget)) {
+            // Force widget repaint.
+            parentWidget->update();
+          } else {
+            // Nobody can see the widget: no need to keep ticking.
+            // The next paint event will resume the animation where it was.
+            pause();
+          }
         },
         Qt::ConnectionType::QueuedConnection);
       parentWidget->installEventFilter(this);
@@ -47,6 +55,18 @@ public:
     }
   }
 
+  void pause() {
+    if (isRunning()) {
+      _qVariantAnimation.pause();
+    }
+  }
+
+  void resume() {
+    if (isPaused()) {
+      _qVariantAnimation.resume();
+    }
+  }
+
   void setLoopEnabled(bool enabled) {
     _loopEnabled = enabled;
   }
@@ -72,7 +92,7 @@ public:
   }
 
   void restartIfNeeded(T const& value) {
-    if (value != finalValue() || !hasFinalValue() || (loopEnabled() && !isRunning())) {
+    if (value != finalValue() || !hasFinalValue() || (loopEnabled() && !isRunning() && !isPaused())) {
       restart(value);
     }
   }
@@ -81,6 +101,10 @@ public:
     return _qVariantAnimation.state() == QVariantAnimation::Running;
   }
 
+  bool isPaused() const {
+    return _qVariantAnimation.state() == QVariantAnimation::Paused;
+  }
+
   void setDuration(int const milliseconds) {
     if (milliseconds != _qVariantAnimation.duration()) {
       stop();
@@ -120,7 +144,7 @@ public:
   }
 
   T value() const {
-    if (isRunning()) {
+    if (isRunning() || isPaused()) {
       const auto variant = _qVariantAnimation.currentValue();
       return variant.template canConvert<T>() ? variant.template value<T>() : _finalValue;
     } else {
@@ -134,8 +158,22 @@ public:
 
 protected:
   bool eventFilter(QObject* obj, QEvent* evt) override {
-    if (evt->type() == QEvent::Hide) {
-      stop();
+    switch (evt->type()) {
+      case QEvent::Hide:
+        // A spontaneous hide event means the window has been minimized: we'll resume later.
+        if (evt->spontaneous()) {
+          pause();
+        } else {
+          stop();
+        }
+        break;
+      case QEvent::Show:
+      case QEvent::Paint:
+        // The widget may be seen again: continue from the logical time the animation was paused at.
+        resume();
+        break;
+      default:
+        break;
     }
     return QObject::eventFilter(obj, evt);
   }
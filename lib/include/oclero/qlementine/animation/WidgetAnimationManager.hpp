@@ -4,6 +4,9 @@
 #pragma once
 
 #include <oclero/qlementine/animation/WidgetAnimator.hpp>
+#include <oclero/qlementine/animation/AnimationClock.hpp>
+
+#include <QPointer>
 
 #include <unordered_map>
 #include <optional>
@@ -36,6 +39,10 @@ public:
   bool enabled() const;
   void setEnabled(bool enabled);
 
+  /// Replaces the wall clock by a virtual clock for all the animations, or restores it if nullptr.
+  AnimationClock* clock() const;
+  void setClock(AnimationClock* clock);
+
   const WidgetAnimator* getAnimator(const QWidget* w) const;
   WidgetAnimator* getOrCreateAnimator(const QWidget* w);
   void stopAll();
@@ -65,6 +72,7 @@ private:
 
 private:
   bool _animationsEnabled{ true };
+  QPointer<AnimationClock> _clock;
   QEasingCurve _focusEasingCurve;
   QEasingCurve _defaultEasingCurve;
   QEasingCurve _linearEasingCurve;
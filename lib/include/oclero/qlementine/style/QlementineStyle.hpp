@@ -13,8 +13,9 @@ class QAbstractItemView;
 class QStyleOptionTab;
 
 namespace oclero::qlementine {
+class AnimationClock;
 class CommandLinkButtonPaintEventFilter;
-class LineEditButtonEventFilter;
+class StyleEventDispatcher;
 struct QlementineStyleImpl;
 
 class QlementineStyle : public QCommonStyle {
@@ -51,14 +52,38 @@ public:
   ~QlementineStyle() override;
 
   Theme const& theme() const;
+  /// The current theme, that can be kept without copying it.
+  SharedTheme const& sharedTheme() const;
   void setTheme(Theme const& theme);
+  /// Only copies a pointer, so switching between already loaded themes doesn't allocate.
+  void setTheme(SharedTheme const& theme);
   void setThemeJsonPath(QString const& jsonPath);
   Q_SIGNAL void themeChanged();
 
+  // Reloads the theme each time the file set with setThemeJsonPath() is saved, e.g. while designing a theme.
+  // Only what depends on the modified values is updated. Disabled by default.
+  bool themeHotReloadEnabled() const;
+  void setThemeHotReloadEnabled(bool enabled);
+  // Emitted when the theme JSON file can't be loaded, e.g. with the line and column of a syntax error.
+  // The current theme stays active.
+  Q_SIGNAL void themeLoadFailed(QString const& error);
+
+  // Increases each time the rendering may change (i.e. at each triggerCompleteRepaint()), and is unique among styles.
+  // Caches of generated content can use it in their keys, instead of being cleared.
+  quint64 themeGeneration() const;
+
   bool animationsEnabled() const;
   void setAnimationsEnabled(bool enabled);
   Q_SIGNAL void animationsEnabledChanged();
 
+  // Draws rounded backgrounds and borders with cached nine-patches (see NinePatchRoundedRectsScope). Disabled by default.
+  bool ninePatchRoundedRectsEnabled() const;
+  void setNinePatchRoundedRectsEnabled(bool enabled);
+
+  // Allows to drive all the animations with a virtual clock, e.g. for tests. Pass nullptr to restore the wall clock.
+  AnimationClock* animationClock() const;
+  void setAnimationClock(AnimationClock* clock);
+
   virtual void triggerCompleteRepaint();
 
   void setAutoIconColor(AutoIconColor autoIconColor);
@@ -138,6 +163,10 @@ public: // QStyle extended enums.
   virtual int pixelMetricExt(PixelMetricExt m, const QStyleOption* opt = nullptr, const QWidget* w = nullptr) const;
 
 public: // Theme-related methods.
+  // NB: To paint faster, the results of most color getters that only take enums are stored in tables when the theme
+  // changes, and the getters are not called anymore while painting. Overrides of these getters can't be detected,
+  // so the tables are not used by subclasses, unless they call setColorTablesEnabled(true) because they don't
+  // override any of them.
   virtual QColor const& color(MouseState const mouse, ColorRole const role) const;
 
   virtual QColor const& frameBackgroundColor(MouseState const mouse) const;
@@ -267,7 +296,7 @@ public: // Theme-related methods.
   virtual QColor const& colorForTextRole(TextRole role, MouseState const mouse) const;
   virtual int pixelSizeForTextRole(TextRole role) const;
   virtual QFont const& fontForTextRole(TextRole role) const;
-  virtual QPalette paletteForTextRole(TextRole role) const;
+  virtual QPalette const& paletteForTextRole(TextRole role) const;
 
   virtual QColor const& switchGrooveColor(MouseState const mouse, CheckState const checked) const;
   virtual QColor const& switchGrooveBorderColor(
@@ -281,7 +310,7 @@ public: // Theme-related methods.
   virtual Status widgetStatus(QWidget const* widget) const;
 
   friend class CommandLinkButtonPaintEventFilter;
-  friend class LineEditButtonEventFilter;
+  friend class StyleEventDispatcher;
 
   virtual QColor const& statusBarBackgroundColor() const;
   virtual QColor const& statusBarBorderColor() const;
@@ -289,6 +318,10 @@ public: // Theme-related methods.
 
   virtual QColor const& splitterColor(MouseState const mouse) const;
 
+protected:
+  /// Allows a subclass to use the color tables, if it doesn't override the color getters that only take enums.
+  void setColorTablesEnabled(bool enabled);
+
 private:
   std::unique_ptr<QlementineStyleImpl> _impl;
 };
@@ -3,11 +3,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <memory>
 #include <optional>
 
 #include <oclero/qlementine/Common.hpp>
 
 #include <QString>
+#include <QByteArray>
 #include <QRgb>
 #include <QJsonDocument>
 #include <QColor>
@@ -36,8 +39,33 @@ public: // Ctor.
   Theme();
 
   static std::optional<Theme> fromJsonPath(const QString& jsonPath);
+  /// Same as above, but describes why the theme can't be loaded (e.g. line and column of a JSON syntax error).
+  static std::optional<Theme> fromJsonPath(const QString& jsonPath, QString& error);
   static std::optional<Theme> fromJsonDoc(const QJsonDocument& jsonDoc);
 
+  /// Loads a theme compiled with convertJsonToBinary(). The file is mapped in memory, read-only.
+  /// If the file is invalid (unknown format, corrupted, etc.), falls back to the JSON file with the same base name, if any.
+  static std::optional<Theme> fromBinaryPath(const QString& binaryPath);
+  static std::optional<Theme> fromBinary(const QByteArray& data);
+
+  /// Reads only the metadata of the theme, which is much faster than loading the whole theme.
+  static std::optional<ThemeMeta> metaFromJsonPath(const QString& jsonPath);
+  static std::optional<ThemeMeta> metaFromBinaryPath(const QString& binaryPath);
+
+  /// Same as fromJsonPath() and fromBinaryPath(), but only reads the values, so it can be called from any thread.
+  /// Fonts and palette need the GUI thread: call generateFontsAndPalette() there before using the theme.
+  static std::optional<Theme> valuesFromJsonPath(const QString& jsonPath);
+  static std::optional<Theme> valuesFromJsonPath(const QString& jsonPath, QString& error);
+  static std::optional<Theme> valuesFromBinaryPath(const QString& binaryPath);
+
+  /// Compiles the JSON theme to the binary format, where all the values are resolved and at fixed offsets.
+  static bool convertJsonToBinary(const QString& jsonPath, const QString& binaryPath);
+
+  /// Extension of compiled theme files.
+  static constexpr auto binaryFileSuffix = "qltheme";
+  /// Version of the binary format. Binary themes with another version are rejected.
+  static constexpr quint32 binaryFormatVersion = 1;
+
   Theme(Theme const& other) = default;
   Theme(Theme&& other) noexcept = default;
   virtual ~Theme() = default;
@@ -45,9 +73,17 @@ public: // Ctor.
 public: // Operators.
   Theme& operator=(Theme const& other) = default;
   Theme& operator=(Theme&& other) = default;
+  /// Compares the content hashes first, so themes that differ are told apart in O(1).
   bool operator==(const Theme& other) const;
   bool operator!=(const Theme& other) const;
 
+public: // Identity.
+  /// Hash of all the values and metadata, computed when the theme is loaded.
+  /// Fonts and palette are not part of it, since they are generated from the other values.
+  std::size_t contentHash() const;
+  /// Must be called after modifying values directly, for operator== and caches to see the change.
+  void updateContentHash();
+
 public: // Values.
   ThemeMeta meta;
 
@@ -201,10 +237,72 @@ public: // Values.
 
 public:
   QJsonDocument toJson() const;
+  QByteArray toBinary() const;
+
+  /// Generates the fonts and the palette from the values. Must be called in the GUI thread.
+  void generateFontsAndPalette();
 
 private:
+  struct ValuesOnly {};
+  explicit Theme(ValuesOnly);
+
+  static std::optional<Theme> valuesFromJsonDoc(const QJsonDocument& jsonDoc);
+  static std::optional<Theme> valuesFromBinary(const QByteArray& data);
+
   void initializeFonts();
   void initializePalette();
   bool initializeFromJson(QJsonDocument const& jsonDoc);
+
+  std::size_t _contentHash{ 0 };
+};
+
+/// Implicitly shared, immutable Theme: copying it only copies a pointer, with an atomic reference count.
+/// Use ThemeBuilder to make a modified version.
+class SharedTheme {
+public:
+  /// Holds a new default Theme.
+  SharedTheme();
+  explicit SharedTheme(const Theme& theme);
+  explicit SharedTheme(Theme&& theme);
+
+  const Theme& get() const {
+    return *_d;
+  }
+  const Theme& operator*() const {
+    return *_d;
+  }
+  const Theme* operator->() const {
+    return _d.get();
+  }
+
+  /// Same shared theme, or equal theme values (the content hash is only a fast reject).
+  bool operator==(const SharedTheme& other) const;
+  bool operator!=(const SharedTheme& other) const;
+
+private:
+  friend class ThemeBuilder;
+  explicit SharedTheme(std::shared_ptr<const Theme> d);
+
+  std::shared_ptr<const Theme> _d;
+};
+
+/// Makes a modified version of a SharedTheme.
+/// The base theme is only copied when first accessed for modification, and is never modified itself.
+class ThemeBuilder {
+public:
+  explicit ThemeBuilder(SharedTheme base = {});
+
+  /// Values to modify. Detaches from the base theme.
+  Theme& theme();
+  Theme* operator->() {
+    return &theme();
+  }
+
+  /// Shares the result, with its content hash up to date. The builder can then be used for further modifications.
+  SharedTheme build();
+
+private:
+  SharedTheme _base;
+  std::shared_ptr<Theme> _theme;
 };
 } // namespace oclero::qlementine
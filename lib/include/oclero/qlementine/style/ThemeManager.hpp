@@ -6,6 +6,8 @@
 #include <QObject>
 #include <QPointer>
 
+#include <future>
+#include <optional>
 #include <vector>
 
 #include <oclero/qlementine/style/Theme.hpp>
@@ -15,6 +17,19 @@ namespace oclero::qlementine {
 class ThemeManager : public QObject {
   Q_OBJECT
 
+public:
+  /// How loadDirectory() loads the themes.
+  enum class LoadingMode {
+    /// All themes are fully loaded immediately.
+    Eager,
+    /// Only the metadata is read immediately. A theme is fully loaded when it is needed.
+    Lazy,
+    /// Only the metadata is read immediately. Theme files are parsed in background threads,
+    /// and waited for when needed before they are ready. Fonts and palette are then generated in the GUI thread.
+    Parallel,
+  };
+  Q_ENUM(LoadingMode)
+
   Q_PROPERTY(QString currentTheme READ currentTheme WRITE setCurrentTheme NOTIFY currentThemeChanged)
   Q_PROPERTY(int themeCount READ themeCount NOTIFY themeCountChanged)
 
@@ -26,10 +41,19 @@ public:
   QlementineStyle* style() const;
   void setStyle(QlementineStyle* style);
 
-  const std::vector<Theme>& themes() const;
+  /// Fully loads all the themes, if not already done. Prefer themeMeta() to only list the themes,
+  /// and theme() to get one theme. Only pointers are copied: themes are shared with the manager.
+  std::vector<SharedTheme> themes() const;
+  /// The theme at this index, loaded if not already done. Other themes are not loaded.
+  const SharedTheme& theme(int index) const;
   void addTheme(const Theme& theme);
+  void addTheme(const SharedTheme& theme);
+
+  /// Metadata of the theme at this index. Doesn't need the theme to be fully loaded.
+  const ThemeMeta& themeMeta(int index) const;
 
-  void loadDirectory(const QString& path);
+  /// Loads all the themes (*.json and compiled *.qltheme) in the directory, sorted by file name.
+  void loadDirectory(const QString& path, LoadingMode mode = LoadingMode::Eager);
 
   QString currentTheme() const;
   void setCurrentTheme(const QString& key);
@@ -47,10 +71,21 @@ public:
   void setCurrentThemeIndex(int index);
 
 private:
+  struct Entry {
+    ThemeMeta meta;
+    // Source file, to load the theme from when needed.
+    QString path;
+    std::optional<SharedTheme> theme;
+    // Set when the theme values are being read in background.
+    std::shared_future<std::optional<Theme>> pendingTheme;
+  };
+
+  void addEntry(Entry&& entry);
+  const SharedTheme& ensureLoaded(int index) const;
   void synchronizeThemeOnStyle();
 
 private:
-  std::vector<Theme> _themes;
+  mutable std::vector<Entry> _entries;
   QPointer<QlementineStyle> _style{ nullptr };
   int _currentIndex{ -1 };
 };
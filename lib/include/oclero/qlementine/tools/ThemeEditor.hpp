@@ -18,7 +18,9 @@ public:
 
 public:
   const Theme& theme() const;
+  const SharedTheme& sharedTheme() const;
   void setTheme(const Theme& theme);
+  void setTheme(const SharedTheme& theme);
 
 Q_SIGNALS:
   void themeChanged(const oclero::qlementine::Theme& theme);
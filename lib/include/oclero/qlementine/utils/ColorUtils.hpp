@@ -21,6 +21,9 @@ QColor colorWithAlpha(QColor const& color, int alpha);
 /// Gets the resulting color by applying the foreground color over the background color with 'SourceOver' composition mode.
 QColor getColorSourceOver(const QColor& bg, const QColor& fg);
 
+/// Gets the color between 'from' and 'to' at the given progress (from 0.0 to 1.0), like QVariantAnimation does.
+QColor interpolateColor(const QColor& from, const QColor& to, qreal progress);
+
 /// Attempts to parse the QVariant array to get a QColor from the array's values.
 /// The order is R, G, B, A.
 std::optional<QColor> tryGetColorFromVariantList(QVariantList const& variantList);
@@ -28,6 +28,21 @@ void drawEllipseBorder(QPainter* p, QRectF const& rect, QColor const& color, qre
 /// Generates a QPainterPath that contains a rounded rectangle with different radiuses for each angle.
 QPainterPath getMultipleRadiusesRectPath(QRectF const& rect, RadiusesF const& radiuses);
 
+/// While it exists, rounded rects and their borders drawn in the GUI thread are drawn by stretching a nine-patch
+/// rendered once per radius, border width, color and device pixel ratio, instead of filling antialiased shapes each time.
+/// This is faster with the software rasterizer. Shapes that are not on whole pixels are still drawn as shapes.
+/// QlementineStyle creates one while it draws, if enabled (see QlementineStyle::setNinePatchRoundedRectsEnabled()).
+class NinePatchRoundedRectsScope {
+public:
+  explicit NinePatchRoundedRectsScope(bool enabled);
+  ~NinePatchRoundedRectsScope();
+  NinePatchRoundedRectsScope(const NinePatchRoundedRectsScope&) = delete;
+  NinePatchRoundedRectsScope& operator=(const NinePatchRoundedRectsScope&) = delete;
+
+private:
+  bool _previous{ false };
+};
+
 /// Draws an antialiased rect.
 void drawRoundedRect(QPainter* p, QRectF const& rect, QBrush const& brush, qreal const radius = 0.);
 
@@ -92,6 +107,9 @@ void updateUncheckableButtonIconPixmap(QIcon& icon, const QSize& size, Theme con
 /// Gets the path to draw the menu arrow in a Button.
 QPainterPath getMenuIndicatorPath(const QRect& rect);
 
+/// Draws the menu arrow in a Button.
+void drawMenuIndicator(const QRect& rect, QPainter* p);
+
 /// Draws the combobox double arrow.
 void drawComboBoxIndicator(const QRect& rect, QPainter* p);
 
@@ -192,8 +210,8 @@ QString displayedShortcutString(const QKeySequence& shortcut);
 void drawShortcut(QPainter& p, const QKeySequence& shortcut, const QRect& rect, const Theme& theme, bool enabled,
   Qt::Alignment alignment = { Qt::AlignLeft | Qt::AlignVCenter });
 
-/// Gets the necessary size to display the whole shortcut.
-QSize shortcutSizeHint(const QKeySequence& shortcut, const Theme& theme);
+/// Gets the necessary size to display the whole shortcut, on the device (e.g. the widget) if any, or the primary screen.
+QSize shortcutSizeHint(const QKeySequence& shortcut, const Theme& theme, const QPaintDevice* device = nullptr);
 
 /// Gets the QPixmap that corresponds to the state and matches the best the desired iconSize.
 /// NB: the QPixmap may not be equal to iconSize: it can be smaller, but never larger.
@@ -19,6 +19,10 @@ QWindow* getWindow(const QWidget* widget);
 
 void clearFocus(QWidget* widget, bool recursive);
 
+/// Returns true if the widget can actually be seen by the user: it must be visible, its window must be
+/// neither minimized nor unexposed, and it must not be entirely clipped by its parents (e.g. a scroll area's viewport).
+bool isWidgetVisibleOnScreen(const QWidget* widget);
+
 template<class T>
 T* findFirstParentOfType(QWidget* child) {
   auto* parent = child;
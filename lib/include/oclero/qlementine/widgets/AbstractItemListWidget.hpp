@@ -92,6 +92,21 @@ protected: // QWidget override.
   void changeEvent(QEvent* e) override;
 
 protected: // Available to child classes.
+  struct ItemColors {
+    QColor bg;
+    QColor fg;
+    QColor badgeBg;
+    QColor badgeFg;
+
+    bool operator==(const ItemColors& other) const {
+      return bg == other.bg && fg == other.fg && badgeBg == other.badgeBg && badgeFg == other.badgeFg;
+    }
+
+    bool operator!=(const ItemColors& other) const {
+      return !(*this == other);
+    }
+  };
+
   struct Item {
     bool enabled{ true };
     QString text;
@@ -100,10 +115,11 @@ protected: // Available to child classes.
     QVariant data;
     QRect rect;
     QSize sizeHint;
-    QVariantAnimation* bgColorAnimation{ nullptr };
-    QVariantAnimation* fgColorAnimation{ nullptr };
-    QVariantAnimation* badgeBgAnimation{ nullptr };
-    QVariantAnimation* badgeFgAnimation{ nullptr };
+    // Animation state, stepped by the widget's single animation tick.
+    ItemColors colors;
+    ItemColors startColors;
+    ItemColors endColors;
+    int animationStartTime{ -1 }; // -1 means the item is not transitioning.
   };
 
   virtual QMargins getItemPadding() const;
@@ -138,8 +154,10 @@ protected: // Available to child classes.
 protected:
   int itemAtPos(const QPoint& pos) const;
   bool hitTestItemRect(const QPoint& pos, const QRect& itemRect, int leftPadding, int rightPadding) const;
+  QSize computeItemSizeHint(const Item& item) const;
   void updateItemsSizeHints();
   void updateItemRects();
+  void invalidateItemsLayout();
   MouseState getItemMouseState(int index, const Item& item) const;
   std::tuple<QColor, QColor, QColor, QColor> getItemBgAndFgColor(int index, MouseState mouse) const;
   const QColor& getCurrentItemIndicatorColor() const;
@@ -149,6 +167,8 @@ protected:
   QRect getAnimatedCurrentItemRect() const;
   void updateCurrentIndexAnimation(bool immediate = false);
   void updateItemsAnimations();
+  void updateItemAnimation(int index);
+  void stepItemsAnimations();
   void setFocusedIndex(int index);
   void setHoveredIndex(int index, bool updateAnims = true);
   void setPressedIndex(int index, bool updateAnims = true);
@@ -156,6 +176,8 @@ protected:
   const QRect& actualRect() const;
 
 private:
+  void connectToThemeChanges();
+
   QRect _actualRect;
   bool _itemsShouldExpand{ false };
   int _currentIndex{ -1 };
@@ -164,7 +186,14 @@ private:
   int _pressedIndex{ -1 };
   QSize _iconSize;
   std::vector<Item> _items;
+  bool _itemsSizeHintsValid{ false };
+  mutable QSize _sizeHintCache;
+  QMetaObject::Connection _themeChangedConnection;
+  int _hitTestPadding{ 0 };
   QVariantAnimation _currentIndexAnimation;
+  QRect _currentItemIndicatorRect;
+  QVariantAnimation _itemsAnimation;
+  int _itemsAnimationDuration{ 0 };
   RoundedFocusFrame* _focusFrame{ nullptr };
   QFont _badgeFont;
   bool _firstShow{ false };
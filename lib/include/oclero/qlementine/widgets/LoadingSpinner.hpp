@@ -19,6 +19,7 @@ class LoadingSpinner : public QWidget {
 
 public:
   explicit LoadingSpinner(QWidget* parent = nullptr);
+  ~LoadingSpinner() override;
 
   bool spinning() const;
   Q_SLOT void setSpinning(bool);
@@ -29,13 +30,10 @@ public:
 
 protected:
   void paintEvent(QPaintEvent* evt) override;
-  void timerEvent(QTimerEvent* evt) override;
   void showEvent(QShowEvent* evt) override;
   void hideEvent(QHideEvent* evt) override;
 
 private:
-  int _timerId{ -1 };
   bool _spinning{ false };
-  int _i{ 0 };
 };
 } // namespace oclero::qlementine
@@ -53,6 +53,7 @@ protected:
 private:
   void setupAnimation();
   void startAnimation();
+  void updateAnimationState(double progress);
   QRect getSwitchRect() const;
 
   const QColor& getBgColor() const;
@@ -68,12 +69,19 @@ private:
   bool _blockRefresh{ false };
   bool _showAccessibilitySymbols{ false };
   Qt::CheckState _publishedState{ Qt::CheckState::Unchecked };
-  QVariantAnimation _handleAnimation;
-  QVariantAnimation _handlePaddingAnimation;
-  QVariantAnimation _bgAnimation;
-  QVariantAnimation _borderAnimation;
-  QVariantAnimation _fgAnimation;
-  QVariantAnimation _symbolAnimation;
+  struct AnimationState {
+    QColor bgColor;
+    QColor borderColor;
+    QColor fgColor;
+    double handleXRatio{ 0. };
+    double handlePadding{ 0. };
+    double symbolProgress{ 0. };
+  };
+  AnimationState _animationStartState;
+  AnimationState _animationEndState;
+  AnimationState _animationState;
+  // A single timeline for all the animated values.
+  QVariantAnimation _animation;
   RoundedFocusFrame* _focusFrame{ nullptr };
 };
 } // namespace oclero::qlementine
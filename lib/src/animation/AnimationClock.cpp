@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <oclero/qlementine/animation/AnimationClock.hpp>
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QPointer>
+
+#include <algorithm>
+
+namespace oclero::qlementine {
+// Duration of a frame when fast-forwarding, or when following the wall clock.
+constexpr auto frameDuration = 16;
+
+static QPointer<AnimationClock> installedAnimationClock;
+
+AnimationClock::AnimationClock(QObject* parent)
+  : QAnimationDriver(parent) {
+  _wallClockTimer.setTimerType(Qt::PreciseTimer);
+  _wallClockTimer.setInterval(frameDuration);
+  QObject::connect(&_wallClockTimer, &QTimer::timeout, this, [this]() {
+    step(static_cast<int>(_wallClock.restart()));
+  });
+}
+
+AnimationClock::~AnimationClock() {
+  uninstall();
+}
+
+void AnimationClock::install() {
+  if (!isInstalled()) {
+    QAnimationDriver::install();
+    installedAnimationClock = this;
+  }
+}
+
+void AnimationClock::uninstall() {
+  if (isInstalled()) {
+    _wallClockTimer.stop();
+    installedAnimationClock = nullptr;
+    QAnimationDriver::uninstall();
+  }
+}
+
+bool AnimationClock::isInstalled() const {
+  return installedAnimationClock == this;
+}
+
+AnimationClock* AnimationClock::installedClock() {
+  return installedAnimationClock.data();
+}
+
+bool AnimationClock::frozen() const {
+  return _frozen;
+}
+
+void AnimationClock::setFrozen(bool frozen) {
+  if (frozen != _frozen) {
+    _frozen = frozen;
+    if (!_frozen && isRunning()) {
+      _wallClock.start();
+      _wallClockTimer.start();
+    } else {
+      _wallClockTimer.stop();
+    }
+  }
+}
+
+qint64 AnimationClock::currentTime() const {
+  return _currentTime;
+}
+
+void AnimationClock::step(int milliseconds) {
+  // Animations are registered to Qt's animation timer with queued calls.
+  QCoreApplication::sendPostedEvents(nullptr, QEvent::MetaCall);
+
+  if (milliseconds <= 0)
+    return;
+
+  _currentTime += milliseconds;
+  if (isRunning()) {
+    advance();
+  }
+  Q_EMIT currentTimeChanged();
+}
+
+void AnimationClock::fastForward(int maxDuration) {
+  QCoreApplication::sendPostedEvents(nullptr, QEvent::MetaCall);
+
+  auto remainingDuration = maxDuration;
+  while (isRunning() && remainingDuration > 0) {
+    const auto duration = std::min(frameDuration, remainingDuration);
+    step(duration);
+    remainingDuration -= duration;
+  }
+}
+
+qint64 AnimationClock::elapsed() const {
+  // Qt expects the time elapsed since the driver started.
+  return _currentTime - _startTime;
+}
+
+void AnimationClock::start() {
+  _startTime = _currentTime;
+  QAnimationDriver::start();
+
+  if (!_frozen) {
+    _wallClock.start();
+    _wallClockTimer.start();
+  }
+}
+
+void AnimationClock::stop() {
+  _wallClockTimer.stop();
+  QAnimationDriver::stop();
+}
+} // namespace oclero::qlementine
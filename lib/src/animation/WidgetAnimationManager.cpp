@@ -19,6 +19,22 @@ void WidgetAnimationManager::setEnabled(bool enabled) {
   }
 }
 
+AnimationClock* WidgetAnimationManager::clock() const {
+  return _clock.data();
+}
+
+void WidgetAnimationManager::setClock(AnimationClock* clock) {
+  if (clock != _clock) {
+    if (_clock) {
+      _clock->uninstall();
+    }
+    _clock = clock;
+    if (_clock) {
+      _clock->install();
+    }
+  }
+}
+
 const WidgetAnimator* WidgetAnimationManager::getAnimator(const QWidget* w) const {
   const auto* res = findWidget(w);
   return res;
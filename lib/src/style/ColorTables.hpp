@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <oclero/qlementine/Common.hpp>
+#include <oclero/qlementine/style/QlementineStyle.hpp>
+
+#include <QColor>
+#include <QtGlobal>
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+// Color getters of QlementineStyle that only depend on the theme and on enum values, with the types of their arguments.
+#define QLEMENTINE_TABLE_COLOR_GETTERS(X)                                                                              \
+  X(color, MouseState, ColorRole)                                                                                      \
+  X(frameBackgroundColor, MouseState)                                                                                  \
+  X(toolButtonBackgroundColor, MouseState, ColorRole)                                                                  \
+  X(toolButtonForegroundColor, MouseState, ColorRole)                                                                  \
+  X(toolButtonSeparatorColor, MouseState, ColorRole)                                                                   \
+  X(commandButtonBackgroundColor, MouseState, ColorRole)                                                               \
+  X(commandButtonTextColor, MouseState, ColorRole)                                                                     \
+  X(commandButtonDescriptionColor, MouseState, ColorRole)                                                              \
+  X(commandButtonIconColor, MouseState, ColorRole)                                                                     \
+  X(checkButtonBackgroundColor, MouseState, CheckState)                                                                \
+  X(checkButtonForegroundColor, MouseState, CheckState)                                                                \
+  X(checkButtonBorderColor, MouseState, FocusState, CheckState)                                                        \
+  X(radioButtonBackgroundColor, MouseState, CheckState)                                                                \
+  X(radioButtonForegroundColor, MouseState, CheckState)                                                                \
+  X(radioButtonBorderColor, MouseState, FocusState, CheckState)                                                        \
+  X(comboBoxBackgroundColor, MouseState)                                                                               \
+  X(comboBoxForegroundColor, MouseState)                                                                               \
+  X(spinBoxBackgroundColor, MouseState)                                                                                \
+  X(spinBoxBorderColor, MouseState, FocusState)                                                                        \
+  X(spinBoxButtonBackgroundColor, MouseState)                                                                          \
+  X(spinBoxButtonForegroundColor, MouseState)                                                                          \
+  X(listItemRowBackgroundColor, MouseState, AlternateState)                                                            \
+  X(listItemForegroundColor, MouseState, SelectionState, FocusState, ActiveState)                                      \
+  X(listItemCaptionForegroundColor, MouseState, SelectionState, FocusState, ActiveState)                               \
+  X(listItemCheckButtonBackgroundColor, MouseState, CheckState, SelectionState, ActiveState)                           \
+  X(listItemCheckButtonBorderColor, MouseState, CheckState, SelectionState, ActiveState)                               \
+  X(listItemCheckButtonForegroundColor, MouseState, CheckState, SelectionState, ActiveState)                           \
+  X(cellItemFocusBorderColor, FocusState, SelectionState, ActiveState)                                                 \
+  X(menuItemBackgroundColor, MouseState)                                                                               \
+  X(menuItemForegroundColor, MouseState)                                                                               \
+  X(menuItemSecondaryForegroundColor, MouseState)                                                                      \
+  X(menuBarItemBackgroundColor, MouseState, SelectionState)                                                            \
+  X(menuBarItemForegroundColor, MouseState, SelectionState)                                                            \
+  X(tabBarBackgroundColor, MouseState)                                                                                 \
+  X(tabBackgroundColor, MouseState, SelectionState)                                                                    \
+  X(tabForegroundColor, MouseState, SelectionState)                                                                    \
+  X(tabCloseButtonBackgroundColor, MouseState, SelectionState)                                                         \
+  X(tabCloseButtonForegroundColor, MouseState, SelectionState)                                                         \
+  X(tabBarScrollButtonBackgroundColor, MouseState)                                                                     \
+  X(progressBarGrooveColor, MouseState)                                                                                \
+  X(progressBarValueColor, MouseState)                                                                                 \
+  X(textFieldBackgroundColor, MouseState, Status)                                                                      \
+  X(textFieldBorderColor, MouseState, FocusState, Status)                                                              \
+  X(textFieldForegroundColor, MouseState)                                                                              \
+  X(sliderGrooveColor, MouseState)                                                                                     \
+  X(sliderValueColor, MouseState)                                                                                      \
+  X(sliderHandleColor, MouseState)                                                                                     \
+  X(sliderTickColor, MouseState)                                                                                       \
+  X(dialHandleColor, MouseState)                                                                                       \
+  X(dialGrooveColor, MouseState)                                                                                       \
+  X(dialValueColor, MouseState)                                                                                        \
+  X(dialTickColor, MouseState)                                                                                         \
+  X(dialMarkColor, MouseState)                                                                                         \
+  X(dialBackgroundColor, MouseState)                                                                                   \
+  X(labelCaptionForegroundColor, MouseState)                                                                           \
+  X(iconForegroundColor, MouseState, ColorRole)                                                                        \
+  X(scrollBarGrooveColor, MouseState)                                                                                  \
+  X(scrollBarHandleColor, MouseState)                                                                                  \
+  X(groupBoxBorderColor, MouseState)                                                                                   \
+  X(statusColor, Status, MouseState)                                                                                   \
+  X(statusColorForeground, Status, MouseState)                                                                         \
+  X(switchGrooveColor, MouseState, CheckState)                                                                         \
+  X(switchGrooveBorderColor, MouseState, FocusState, CheckState)                                                       \
+  X(switchHandleColor, MouseState, CheckState)                                                                         \
+  X(tableHeaderBgColor, MouseState, CheckState)                                                                        \
+  X(tableHeaderFgColor, MouseState, CheckState)                                                                        \
+  X(splitterColor, MouseState)
+
+namespace oclero::qlementine {
+/// Number of values of the enum, used to size the tables.
+template<typename Enum>
+constexpr std::size_t enumValueCount = 0;
+template<>
+constexpr std::size_t enumValueCount<MouseState> = 5;
+template<>
+constexpr std::size_t enumValueCount<ColorRole> = 2;
+template<>
+constexpr std::size_t enumValueCount<CheckState> = 3;
+template<>
+constexpr std::size_t enumValueCount<FocusState> = 2;
+template<>
+constexpr std::size_t enumValueCount<ActiveState> = 2;
+template<>
+constexpr std::size_t enumValueCount<SelectionState> = 2;
+template<>
+constexpr std::size_t enumValueCount<AlternateState> = 2;
+template<>
+constexpr std::size_t enumValueCount<Status> = 5;
+
+/// Dense table of all the results of a color getter, indexed by the values of its enum arguments.
+template<typename... Enums>
+class ColorTable {
+public:
+  static constexpr std::size_t size = (enumValueCount<Enums> * ...);
+
+  template<typename Getter>
+  void fill(Getter&& getter) {
+    for (std::size_t i = 0; i < size; ++i) {
+      _colors[i] = std::apply(getter, arguments(i, std::index_sequence_for<Enums...>{}));
+    }
+  }
+
+  QColor const& get(Enums... values) const {
+    const auto i = index(values...);
+    Q_ASSERT(i < size);
+    return _colors[i];
+  }
+
+private:
+  static std::size_t index(Enums... values) {
+    // Values outside of enumValueCount would read another color, or past the table.
+    Q_ASSERT(((static_cast<std::size_t>(values) < enumValueCount<Enums>) && ...));
+    std::size_t result = 0;
+    ((result = result * enumValueCount<Enums> + static_cast<std::size_t>(values)), ...);
+    return result;
+  }
+
+  /// Inverse of index().
+  template<std::size_t... Is>
+  static std::tuple<Enums...> arguments(std::size_t i, std::index_sequence<Is...>) {
+    constexpr std::array<std::size_t, sizeof...(Enums)> counts{ enumValueCount<Enums>... };
+    std::array<std::size_t, sizeof...(Enums)> digits{};
+    for (auto n = sizeof...(Enums); n > 0; --n) {
+      digits[n - 1] = i % counts[n - 1];
+      i /= counts[n - 1];
+    }
+    return { static_cast<Enums>(digits[Is])... };
+  }
+
+  std::array<QColor, size> _colors;
+};
+
+/// Results of all the color getters for the current theme, so painting doesn't evaluate the getters' switches.
+struct ColorTables {
+#define QLEMENTINE_DECLARE_COLOR_TABLE(NAME, ...) ColorTable<__VA_ARGS__> NAME;
+  QLEMENTINE_TABLE_COLOR_GETTERS(QLEMENTINE_DECLARE_COLOR_TABLE)
+#undef QLEMENTINE_DECLARE_COLOR_TABLE
+
+  /// Calls QlementineStyle's implementation of the getters, not the ones of a subclass.
+  void build(const QlementineStyle& style) {
+#define QLEMENTINE_FILL_COLOR_TABLE(NAME, ...)                                                                         \
+  NAME.fill([&style](auto... args) -> QColor const& {                                                                  \
+    return style.QlementineStyle::NAME(args...);                                                                       \
+  });
+    QLEMENTINE_TABLE_COLOR_GETTERS(QLEMENTINE_FILL_COLOR_TABLE)
+#undef QLEMENTINE_FILL_COLOR_TABLE
+  }
+};
+} // namespace oclero::qlementine
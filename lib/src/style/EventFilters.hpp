@@ -3,12 +3,5 @@
 
 #pragma once
 
-#include "eventFilters/ComboboxItemViewFilter.hpp"
 #include "eventFilters/CommandLinkButtonEventFilter.hpp"
-#include "eventFilters/LineEditButtonEventFilter.hpp"
-#include "eventFilters/LineEditMenuEventFilter.hpp"
-#include "eventFilters/MenuEventFilter.hpp"
-#include "eventFilters/MouseWheelBlockerEventFilter.hpp"
-#include "eventFilters/TabBarEventFilter.hpp"
-#include "eventFilters/TextEditEventFilter.hpp"
-#include "eventFilters/WidgetWithFocusFrameEventFilter.hpp"
+#include "eventFilters/LineEditMenuIconsBehavior.hpp"
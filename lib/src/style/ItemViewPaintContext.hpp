@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QStyle>
+#include <QStyleOptionViewItem>
+#include <QAbstractItemView>
+#include <QListView>
+#include <QTableView>
+#include <QHeaderView>
+
+namespace oclero::qlementine {
+// Facts about an item view that are identical for all the cells painted during a paint pass.
+struct ItemViewPaintContext {
+  bool isList{ false };
+  bool isTable{ false };
+  bool hasFocus{ false };
+  bool drawLeftGridLine{ false };
+  bool drawTopGridLine{ false };
+};
+
+inline ItemViewPaintContext makeItemViewPaintContext(const QWidget* w) {
+  ItemViewPaintContext context;
+  const auto* tableView = qobject_cast<const QTableView*>(w);
+  const auto showGrid = tableView && tableView->showGrid();
+  context.isList = qobject_cast<const QListView*>(w) != nullptr;
+  context.isTable = tableView != nullptr;
+  context.hasFocus = w && w->hasFocus();
+  context.drawLeftGridLine = showGrid && tableView->verticalHeader()->isHidden();
+  context.drawTopGridLine = showGrid && tableView->horizontalHeader()->isHidden();
+  return context;
+}
+
+// Resolves the ItemViewPaintContext once per paint pass of the item view's viewport,
+// so the style doesn't query the view again for every cell.
+class ItemViewPaintContextCache {
+public:
+  explicit ItemViewPaintContextCache(QAbstractItemView* view)
+    : _view(view) {}
+
+  // To be called when a new paint pass starts: the view state may have changed since the previous one.
+  void invalidate() {
+    _valid = false;
+  }
+
+  // The painter is part of the key, so cells painted outside of a paint event
+  // (e.g. drag pixmaps) don't use a context resolved for another pass.
+  const ItemViewPaintContext& context(const QPainter* painter) {
+    if (!_valid || painter != _painter) {
+      _context = makeItemViewPaintContext(_view);
+      _painter = painter;
+      _valid = true;
+    }
+    return _context;
+  }
+
+  // Cells of a same column generally share their decoration geometry, so the last one is kept.
+  QRect decorationRect(const QStyle* style, const QStyleOptionViewItem* opt) {
+    const auto position = opt->decorationPosition;
+    const auto isHorizontal =
+      position == QStyleOptionViewItem::Left || position == QStyleOptionViewItem::Right;
+    if (!isHorizontal || !opt->rect.isValid()) {
+      return style->subElementRect(QStyle::SE_ItemViewItemDecoration, opt, _view);
+    }
+
+    // When the decoration is on the side, its vertical geometry only depends on these values.
+    if (!_decorationKeyValid || opt->rect.height() != _decorationRectHeight
+        || opt->decorationSize != _decorationSize || opt->decorationAlignment != _decorationAlignment
+        || position != _decorationPosition) {
+      _decorationRectHeight = opt->rect.height();
+      _decorationSize = opt->decorationSize;
+      _decorationAlignment = opt->decorationAlignment;
+      _decorationPosition = position;
+      _decorationRect = style->subElementRect(QStyle::SE_ItemViewItemDecoration, opt, _view);
+      _decorationRect.translate(-opt->rect.topLeft());
+      _decorationKeyValid = true;
+    }
+    return _decorationRect.translated(opt->rect.topLeft());
+  }
+
+private:
+  QAbstractItemView* _view{ nullptr };
+  bool _valid{ false };
+  const QPainter* _painter{ nullptr };
+  ItemViewPaintContext _context;
+
+  bool _decorationKeyValid{ false };
+  int _decorationRectHeight{ 0 };
+  QSize _decorationSize;
+  Qt::Alignment _decorationAlignment;
+  QStyleOptionViewItem::Position _decorationPosition{ QStyleOptionViewItem::Left };
+  QRect _decorationRect;
+};
+} // namespace oclero::qlementine
@@ -25,11 +25,17 @@
 #include <oclero/qlementine/widgets/PlainTextEdit.hpp>
 
 #include "EventFilters.hpp"
+#include "ColorTables.hpp"
+#include "StyleEventDispatcher.hpp"
+#include "ThemeDiff.hpp"
+#include "ThemeFileWatcher.hpp"
+#include "utils/FontMetricsCache.hpp"
+#include "utils/GlyphAtlas.hpp"
+#include "WidgetTraits.hpp"
 
 #include <QResizeEvent>
 #include <QFontDatabase>
 #include <QToolTip>
-#include <QPixmapCache>
 #include <QApplication>
 #include <QMenuBar>
 #include <QToolBar>
@@ -57,9 +63,16 @@
 #include <QSpinBox>
 #include <QFontComboBox>
 #include <QTreeView>
+#include <QPointer>
+#include <QThreadPool>
 
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <typeinfo>
 
 namespace oclero::qlementine {
 
@@ -70,6 +83,68 @@ QlementineStyle* appStyle() {
 /// Used to initializeResources from .qrc only once.
 static std::once_flag qlementineOnceFlag;
 
+/// Registers all the embedded fonts to Qt's font database.
+static void installFonts() {
+  const auto regularFontPath = QString(":/qlementine/resources/fonts/inter/%1.ttf");
+  QFontDatabase::addApplicationFont(regularFontPath.arg(QStringLiteral("Inter-Regular")));
+  QFontDatabase::addApplicationFont(regularFontPath.arg(QStringLiteral("Inter-Italic")));
+  QFontDatabase::addApplicationFont(regularFontPath.arg(QStringLiteral("Inter-Bold")));
+  QFontDatabase::addApplicationFont(regularFontPath.arg(QStringLiteral("Inter-BoldItalic")));
+
+  const auto fixedFontPath = QString(":/qlementine/resources/fonts/roboto-mono/%1.ttf");
+  QFontDatabase::addApplicationFont(fixedFontPath.arg(QStringLiteral("RobotoMono-Regular")));
+  QFontDatabase::addApplicationFont(fixedFontPath.arg(QStringLiteral("RobotoMono-Italic")));
+  QFontDatabase::addApplicationFont(fixedFontPath.arg(QStringLiteral("RobotoMono-Bold")));
+  QFontDatabase::addApplicationFont(fixedFontPath.arg(QStringLiteral("RobotoMono-BoldItalic")));
+
+  const auto titleFontPath = QString(":/qlementine/resources/fonts/inter/%1.ttf");
+  QFontDatabase::addApplicationFont(titleFontPath.arg(QStringLiteral("InterDisplay-Regular")));
+  QFontDatabase::addApplicationFont(titleFontPath.arg(QStringLiteral("InterDisplay-Italic")));
+  QFontDatabase::addApplicationFont(titleFontPath.arg(QStringLiteral("InterDisplay-Bold")));
+  QFontDatabase::addApplicationFont(titleFontPath.arg(QStringLiteral("InterDisplay-BoldItalic")));
+}
+
+/// The embedded fonts are registered only once, in a background thread, so the application can continue to start meanwhile.
+static std::once_flag qlementineFontsOnceFlag;
+static std::shared_future<void> qlementineFontsInstalled;
+static std::promise<void> qlementineFontsPromise;
+// Taken by the first one to install the fonts: the background task, or the GUI thread if the task hasn't started yet.
+static std::atomic_flag qlementineFontsTaken = ATOMIC_FLAG_INIT;
+// Set once waited for, so later checks only read it.
+static std::atomic<bool> qlementineFontsReady{ false };
+
+static void installFontsIfNotTaken() {
+  if (!qlementineFontsTaken.test_and_set()) {
+    installFonts();
+    qlementineFontsPromise.set_value();
+  }
+}
+
+static void startInstallingFonts() {
+  std::call_once(qlementineFontsOnceFlag, []() {
+    qlementineFontsInstalled = qlementineFontsPromise.get_future().share();
+    // QFontDatabase is thread-safe, and the resources are already initialized.
+    QThreadPool::globalInstance()->start([]() {
+      installFontsIfNotTaken();
+    });
+  });
+}
+
+/// Blocks until the embedded fonts are registered.
+static void waitForFonts() {
+  if (qlementineFontsReady.load(std::memory_order_acquire))
+    return;
+
+  startInstallingFonts();
+  // The pool may be busy with other tasks: don't wait for the task to start, install the fonts now instead.
+  installFontsIfNotTaken();
+  qlementineFontsInstalled.wait();
+  qlementineFontsReady.store(true, std::memory_order_release);
+}
+
+/// Shared by all styles, so two styles never have the same generation.
+static std::atomic<quint64> qlementineNextThemeGeneration{ 1 };
+
 constexpr auto hardcodedButtonSpacing = 4; // qpushbutton.cpp line 410, qcombobox.cpp line 418/437
 //constexpr auto hardcodedLineEditVMargin = 1; // qlinedit_p.cpp line 68
 constexpr auto hardcodedLineEditHMargin = 2; // qlinedit_p.cpp line 69
@@ -81,43 +156,184 @@ constexpr auto iconPenWidth = 1.01;
 // Used to determine if the icon must be colorized according to the Theme's colors or not.
 constexpr auto Property_AutoIconColor = "autoIconColor";
 
+// TextRole values go from Caption (-1) to H5.
+constexpr auto firstTextRole = static_cast<int>(TextRole::Caption);
+constexpr auto textRoleCount = static_cast<std::size_t>(static_cast<int>(TextRole::H5) - firstTextRole + 1);
+
+struct TextRoleStyle {
+  QFont font;
+  QPalette palette;
+  int pixelSize{ 0 };
+};
+
 struct QlementineStyleImpl {
   explicit QlementineStyleImpl(QlementineStyle& o)
     : owner(o) {
     updatePalette();
     std::call_once(qlementineOnceFlag, qlementine::resources::initializeResources);
-    installFonts();
+    // Started as early as possible, and waited for only when the fonts are first used.
+    startInstallingFonts();
   }
 
-  /// Registers all the theme fonts to Qt's font database.
-  void installFonts() {
-    const auto regularFontPath = QString(":/qlementine/resources/fonts/inter/%1.ttf");
-    QFontDatabase::addApplicationFont(regularFontPath.arg(QStringLiteral("Inter-Regular")));
-    QFontDatabase::addApplicationFont(regularFontPath.arg(QStringLiteral("Inter-Italic")));
-    QFontDatabase::addApplicationFont(regularFontPath.arg(QStringLiteral("Inter-Bold")));
-    QFontDatabase::addApplicationFont(regularFontPath.arg(QStringLiteral("Inter-BoldItalic")));
-
-    const auto fixedFontPath = QString(":/qlementine/resources/fonts/roboto-mono/%1.ttf");
-    QFontDatabase::addApplicationFont(fixedFontPath.arg(QStringLiteral("RobotoMono-Regular")));
-    QFontDatabase::addApplicationFont(fixedFontPath.arg(QStringLiteral("RobotoMono-Italic")));
-    QFontDatabase::addApplicationFont(fixedFontPath.arg(QStringLiteral("RobotoMono-Bold")));
-    QFontDatabase::addApplicationFont(fixedFontPath.arg(QStringLiteral("RobotoMono-BoldItalic")));
-
-    const auto titleFontPath = QString(":/qlementine/resources/fonts/inter/%1.ttf");
-    QFontDatabase::addApplicationFont(titleFontPath.arg(QStringLiteral("InterDisplay-Regular")));
-    QFontDatabase::addApplicationFont(titleFontPath.arg(QStringLiteral("InterDisplay-Italic")));
-    QFontDatabase::addApplicationFont(titleFontPath.arg(QStringLiteral("InterDisplay-Bold")));
-    QFontDatabase::addApplicationFont(titleFontPath.arg(QStringLiteral("InterDisplay-BoldItalic")));
+  /// Makes sure the embedded fonts are registered before they are resolved, if the theme needs them.
+  /// Only blocks the first time: afterwards, it only reads a flag.
+  void ensureFontsInstalled() const {
+    if (!theme->useSystemFonts) {
+      waitForFonts();
+    }
   }
 
   /// Some widgets need to have a QPalette explicitely set.
   void updatePalette() const {
-    QToolTip::setPalette(theme.palette);
+    QToolTip::setPalette(theme->palette);
+  }
+
+  /// Lighter version of triggerCompleteRepaint(), when only colors have changed.
+  void triggerColorRepaint() {
+    themeGeneration = qlementineNextThemeGeneration++;
+    updatePalette();
+
+    // Clear generated icons because they depend on colors.
+    standardIconCache.clear();
+    GlyphAtlas::instance().clear();
+
+    QApplication::setPalette(owner.standardPalette());
+
+    const auto topLevelWidgets = QApplication::topLevelWidgets();
+    for (auto* widget : topLevelWidgets) {
+      widget->update();
+    }
+  }
+
+  /// Lighter version of triggerCompleteRepaint(), when metrics have changed but not fonts.
+  void triggerMetricsRepaint() {
+    triggerColorRepaint();
+
+    // Size hints depend on the metrics. Setting the application font would relayout widgets too,
+    // but would also make each widget resolve its font again.
+    const auto allWidgets = QApplication::allWidgets();
+    for (auto* widget : allWidgets) {
+      widget->updateGeometry();
+    }
+  }
+
+  /// Color tables of the current theme, or nullptr if the getters must be called.
+  const ColorTables* colorTables() const {
+    if (colorTablesGeneration != themeGeneration) {
+      colorTablesGeneration = themeGeneration;
+      // A subclass may override any getter, and its overrides must be used.
+      colorTablesEnabled = false;
+      if (subclassColorTablesEnabled || typeid(owner) == typeid(QlementineStyle)) {
+        colorTableCache.build(owner);
+        colorTablesEnabled = true;
+      }
+    }
+    return colorTablesEnabled ? &colorTableCache : nullptr;
+  }
+
+  /// Font, palette and pixel size of each TextRole, computed once per theme generation.
+  /// Returned by reference, so widgets get the same QPalette each time and can detect that it hasn't changed.
+  const TextRoleStyle& textRoleStyle(TextRole role) const {
+    if (textRoleStylesGeneration != themeGeneration) {
+      textRoleStylesGeneration = themeGeneration;
+      for (std::size_t i = 0; i < textRoleCount; ++i) {
+        const auto textRole = static_cast<TextRole>(static_cast<int>(i) + firstTextRole);
+        auto& style = textRoleStyles[i];
+        style.font = themeFont(textRole);
+        style.palette = makeTextRolePalette(textRole);
+        style.pixelSize = themePixelSize(textRole);
+      }
+    }
+    // Unknown values are handled as TextRole::Default, like in the switches.
+    auto index = static_cast<int>(role) - firstTextRole;
+    if (index < 0 || index >= static_cast<int>(textRoleCount)) {
+      index = static_cast<int>(TextRole::Default) - firstTextRole;
+    }
+    return textRoleStyles[static_cast<std::size_t>(index)];
+  }
+
+  const QFont& themeFont(TextRole role) const {
+    switch (role) {
+      case TextRole::Caption:
+        return theme->fontCaption;
+      case TextRole::H1:
+        return theme->fontH1;
+      case TextRole::H2:
+        return theme->fontH2;
+      case TextRole::H3:
+        return theme->fontH3;
+      case TextRole::H4:
+        return theme->fontH4;
+      case TextRole::H5:
+        return theme->fontH5;
+      default:
+        return theme->fontRegular;
+    }
   }
 
+  int themePixelSize(TextRole role) const {
+    switch (role) {
+      case TextRole::Caption:
+        return theme->fontSizeS1;
+      case TextRole::H1:
+        return theme->fontSizeH1;
+      case TextRole::H2:
+        return theme->fontSizeH2;
+      case TextRole::H3:
+        return theme->fontSizeH3;
+      case TextRole::H4:
+        return theme->fontSizeH4;
+      case TextRole::H5:
+        return theme->fontSizeH5;
+      default:
+        return theme->fontSize;
+    }
+  }
+
+  QPalette makeTextRolePalette(TextRole role) const {
+    auto result = QPalette{ theme->palette };
+
+    // Subclasses may override the text colors.
+    const auto& textColor = owner.colorForTextRole(role, MouseState::Normal);
+    const auto& textColorDisabled = owner.colorForTextRole(role, MouseState::Disabled);
+
+    result.setColor(QPalette::ColorGroup::All, QPalette::ColorRole::Text, textColor);
+    result.setColor(QPalette::ColorGroup::All, QPalette::ColorRole::WindowText, textColor);
+    result.setColor(QPalette::ColorGroup::All, QPalette::ColorRole::BrightText, textColor);
+
+    result.setColor(QPalette::ColorGroup::Disabled, QPalette::ColorRole::Text, textColorDisabled);
+    result.setColor(QPalette::ColorGroup::Disabled, QPalette::ColorRole::WindowText, textColorDisabled);
+    result.setColor(QPalette::ColorGroup::Disabled, QPalette::ColorRole::BrightText, textColorDisabled);
+
+    return result;
+  }
+
+  // Same as the QlementineStyle's getters, but read from the color tables when possible.
+#define QLEMENTINE_COLOR_TABLE_ACCESSOR(NAME, ...)                                                                     \
+  template<typename... Args>                                                                                           \
+  QColor const& NAME(Args... args) const {                                                                             \
+    if (const auto* tables = colorTables()) {                                                                          \
+      return tables->NAME.get(args...);                                                                                \
+    }                                                                                                                  \
+    return owner.NAME(args...);                                                                                        \
+  }
+  QLEMENTINE_TABLE_COLOR_GETTERS(QLEMENTINE_COLOR_TABLE_ACCESSOR)
+#undef QLEMENTINE_COLOR_TABLE_ACCESSOR
+
   /// Updates the font cache.
   void updateFonts() {
-    fontMetricsBold = std::make_unique<QFontMetrics>(theme.fontBold);
+    // The application font is set right after, and polished widgets resolve it again.
+    ensureFontsInstalled();
+    // Also needed when the theme is the same, since system fonts or screens may have changed.
+    // Other caches of the same metrics, e.g. for shortcuts, must be cleared too.
+    FontMetricsCache::invalidateAll();
+  }
+
+  /// Metrics of a theme font on the widget's screen.
+  const QFontMetrics& fontMetrics(FontMetricsCache::Font font, const QWidget* w) const {
+    // May be the first time a font is resolved, e.g. when painting in an image without any polished widget.
+    ensureFontsInstalled();
+    return fontMetricsCache.get(*theme, font, w);
   }
 
   /// Gets (or create if not existing yet) an icon from the cache.
@@ -160,16 +376,16 @@ struct QlementineStyleImpl {
           updateUncheckableButtonIconPixmap(icon, size, owner, makeArrowRightPixmap);
           break;
         case QlementineStyle::SP_MessageBoxWarning:
-          updateMessageBoxWarningIcon(icon, size, theme);
+          updateMessageBoxWarningIcon(icon, size, *theme);
           break;
         case QlementineStyle::SP_MessageBoxCritical:
-          updateMessageBoxCriticalIcon(icon, size, theme);
+          updateMessageBoxCriticalIcon(icon, size, *theme);
           break;
         case QlementineStyle::SP_MessageBoxInformation:
-          updateMessageBoxInformationIcon(icon, size, theme);
+          updateMessageBoxInformationIcon(icon, size, *theme);
           break;
         case QlementineStyle::SP_MessageBoxQuestion:
-          updateMessageBoxQuestionIcon(icon, size, theme);
+          updateMessageBoxQuestionIcon(icon, size, *theme);
           break;
         default:
           break;
@@ -198,7 +414,7 @@ struct QlementineStyleImpl {
   // Returns the extra padding around the tab.
   // We add extra padding so we have some space to draw nice curve ends.
   QMargins tabExtraPadding(const QStyleOptionTab* optTab, const QWidget*) const {
-    const auto spacing = theme.spacing;
+    const auto spacing = theme->spacing;
     const auto paddingTop = spacing / 2;
 
     const auto isFirst = optTab->position == QStyleOptionTab::TabPosition::OnlyOneTab
@@ -244,14 +460,34 @@ struct QlementineStyleImpl {
     }
   }
 
+  /// Gets the paint context of an item view, resolved once per paint pass when possible.
+  ItemViewPaintContext itemViewPaintContext(const QWidget* w, const QPainter* p) const {
+    if (auto* cache = events.itemViewPaintContextCache(w)) {
+      return cache->context(p);
+    }
+    return makeItemViewPaintContext(w);
+  }
+
   QlementineStyle& owner;
-  Theme theme{};
-  std::unique_ptr<QFontMetrics> fontMetricsBold{ nullptr };
+  SharedTheme theme{};
+  quint64 themeGeneration{ qlementineNextThemeGeneration++ };
+  mutable ColorTables colorTableCache;
+  mutable quint64 colorTablesGeneration{ 0 };
+  mutable bool colorTablesEnabled{ false };
+  bool subclassColorTablesEnabled{ false };
+  mutable std::array<TextRoleStyle, textRoleCount> textRoleStyles;
+  mutable quint64 textRoleStylesGeneration{ 0 };
+  mutable FontMetricsCache fontMetricsCache;
+  QString themeJsonPath;
+  std::unique_ptr<ThemeFileWatcher> themeFileWatcher;
   WidgetAnimationManager animations;
+  bool ninePatchRoundedRects{ false };
+  StyleEventDispatcher events{ owner, animations };
   std::unordered_map<QStyle::StandardPixmap, QIcon> standardIconCache;
   std::unordered_map<QlementineStyle::StandardPixmapExt, QIcon> standardIconExtCache;
   AutoIconColor autoIconColor{ AutoIconColor::None };
   std::function<QString(QString)> iconPathFunc;
+  WidgetTraitsTable widgetTraits;
 };
 
 QlementineStyle::QlementineStyle(QObject* parent)
@@ -268,22 +504,86 @@ QlementineStyle::QlementineStyle(QObject* parent)
 QlementineStyle::~QlementineStyle() = default;
 
 Theme const& QlementineStyle::theme() const {
+  return *_impl->theme;
+}
+
+SharedTheme const& QlementineStyle::sharedTheme() const {
   return _impl->theme;
 }
 
 void QlementineStyle::setTheme(Theme const& theme) {
+  // Compare first, to not copy the theme when it is the same.
+  if (*_impl->theme != theme) {
+    setTheme(SharedTheme(theme));
+  }
+}
+
+void QlementineStyle::setTheme(SharedTheme const& theme) {
   if (_impl->theme != theme) {
+    const auto changes = diffThemes(*_impl->theme, *theme);
     _impl->theme = theme;
+
+    if (changes.testFlag(ThemeChange::Fonts)) {
+      triggerCompleteRepaint();
+    } else if (changes.testFlag(ThemeChange::Metrics)) {
+      _impl->triggerMetricsRepaint();
+    } else if (changes.testFlag(ThemeChange::Colors)) {
+      // Avoid setting the application font, which would cause a relayout of all widgets.
+      _impl->triggerColorRepaint();
+    }
+
+    // Emitted once the generation has changed, so slots get values of the new theme (e.g. textRoleStyle()).
     Q_EMIT themeChanged();
+  }
+}
 
-    triggerCompleteRepaint();
+void QlementineStyle::setColorTablesEnabled(bool enabled) {
+  if (enabled != _impl->subclassColorTablesEnabled) {
+    _impl->subclassColorTablesEnabled = enabled;
+    // Build the tables again, or stop using them.
+    _impl->colorTablesGeneration = 0;
   }
 }
 
+quint64 QlementineStyle::themeGeneration() const {
+  return _impl->themeGeneration;
+}
+
 void QlementineStyle::setThemeJsonPath(QString const& jsonPath) {
-  const auto themeOpt = Theme::fromJsonPath(jsonPath);
+  _impl->themeJsonPath = jsonPath;
+  if (_impl->themeFileWatcher) {
+    _impl->themeFileWatcher->setPath(jsonPath);
+  }
+
+  QString error;
+  auto themeOpt = Theme::fromJsonPath(jsonPath, error);
   if (themeOpt.has_value()) {
-    setTheme(themeOpt.value());
+    setTheme(SharedTheme(std::move(themeOpt.value())));
+  } else {
+    Q_EMIT themeLoadFailed(error);
+  }
+}
+
+bool QlementineStyle::themeHotReloadEnabled() const {
+  return _impl->themeFileWatcher != nullptr;
+}
+
+void QlementineStyle::setThemeHotReloadEnabled(bool enabled) {
+  if (enabled == themeHotReloadEnabled())
+    return;
+
+  if (enabled) {
+    _impl->themeFileWatcher = std::make_unique<ThemeFileWatcher>(
+      [this](const SharedTheme& theme) {
+        // Only invalidates what depends on the modified values.
+        setTheme(theme);
+      },
+      [this](const QString& error) {
+        Q_EMIT themeLoadFailed(error);
+      });
+    _impl->themeFileWatcher->setPath(_impl->themeJsonPath);
+  } else {
+    _impl->themeFileWatcher.reset();
   }
 }
 
@@ -299,20 +599,43 @@ void QlementineStyle::setAnimationsEnabled(bool enabled) {
   }
 }
 
+bool QlementineStyle::ninePatchRoundedRectsEnabled() const {
+  return _impl->ninePatchRoundedRects;
+}
+
+void QlementineStyle::setNinePatchRoundedRectsEnabled(bool enabled) {
+  if (enabled != _impl->ninePatchRoundedRects) {
+    _impl->ninePatchRoundedRects = enabled;
+    triggerCompleteRepaint();
+  }
+}
+
+AnimationClock* QlementineStyle::animationClock() const {
+  return _impl->animations.clock();
+}
+
+void QlementineStyle::setAnimationClock(AnimationClock* clock) {
+  _impl->animations.setClock(clock);
+}
+
 void QlementineStyle::triggerCompleteRepaint() {
+  // Pixmaps in QPixmapCache that depend on the theme have the generation in their key,
+  // so they are not found anymore and will be evicted by the cache itself.
+  _impl->themeGeneration = qlementineNextThemeGeneration++;
+
   _impl->updateFonts();
   _impl->updatePalette();
 
   // Clear generated icons because they depend on colors.
   _impl->standardIconCache.clear();
-  QPixmapCache::clear();
+  GlyphAtlas::instance().clear();
 
   // Update the palette.
   const auto palette = standardPalette();
   QApplication::setPalette(palette);
 
   // Update the application font.
-  QApplication::setFont(_impl->theme.fontRegular);
+  QApplication::setFont(_impl->theme->fontRegular);
 
   // Repaint all top-level widgets.
   const auto topLevelWidgets = QApplication::topLevelWidgets();
@@ -384,6 +707,7 @@ void QlementineStyle::setIconPathGetter(const std::function<QString(QString)>& f
 /* QStyle overrides. */
 
 void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt, QPainter* p, const QWidget* w) const {
+  const NinePatchRoundedRectsScope ninePatchScope(_impl->ninePatchRoundedRects);
   switch (pe) {
     case PE_Frame:
       //qDebug() << pe;
@@ -408,9 +732,9 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         const auto focused = optFocus->state.testFlag(State_HasFocus);
         const auto progress = focused ? 1. : 0.;
         const auto currentProgress =
-          _impl->animations.animateFocusBorderProgress(w, progress, _impl->theme.focusAnimationDuration);
-        const auto currentBorderW = currentProgress * _impl->theme.focusBorderWidth;
-        const auto margin = (1. - currentProgress) * _impl->theme.focusBorderWidth;
+          _impl->animations.animateFocusBorderProgress(w, progress, _impl->theme->focusAnimationDuration);
+        const auto currentBorderW = currentProgress * _impl->theme->focusBorderWidth;
+        const auto margin = (1. - currentProgress) * _impl->theme->focusBorderWidth;
         const auto currentFocusRect = QRectF(optFocus->rect).marginsRemoved(QMarginsF(margin, margin, margin, margin));
         const auto currentRadius = borderRadiuses + currentBorderW;
 
@@ -423,10 +747,10 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
       if (const auto* frameOpt = qstyleoption_cast<const QStyleOptionFrame*>(opt)) {
         const auto mouse = qlementine::getMouseState(frameOpt->state);
         const auto& bgColor = groupBoxBackgroundColor(mouse);
-        const auto& borderColor = groupBoxBorderColor(mouse);
-        const auto borderW = _impl->theme.borderWidth;
-        drawRoundedRect(p, frameOpt->rect, bgColor, _impl->theme.borderRadius);
-        drawRoundedRectBorder(p, frameOpt->rect, borderColor, borderW, _impl->theme.borderRadius);
+        const auto& borderColor = _impl->groupBoxBorderColor(mouse);
+        const auto borderW = _impl->theme->borderWidth;
+        drawRoundedRect(p, frameOpt->rect, bgColor, _impl->theme->borderRadius);
+        drawRoundedRectBorder(p, frameOpt->rect, borderColor, borderW, _impl->theme->borderRadius);
       }
       return;
     case PE_FrameLineEdit:
@@ -435,8 +759,8 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
       return; // Let PE_PanelMenu do the drawing.
     case PE_FrameStatusBarItem: {
       const auto rect = opt->rect;
-      const auto penColor = _impl->theme.borderColor;
-      const auto penWidth = _impl->theme.borderWidth;
+      const auto penColor = _impl->theme->borderColor;
+      const auto penWidth = _impl->theme->borderWidth;
       const auto p1 = QPoint{ rect.x() + 1 + penWidth, rect.y() + rect.x() };
       const auto p2 = QPoint{ rect.x() + 1 + penWidth, rect.y() + rect.height() };
       p->setPen(QPen(penColor, penWidth, Qt::SolidLine, Qt::FlatCap, Qt::MiterJoin));
@@ -455,14 +779,14 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
       if (!documentMode && tabBar) {
         // Draw a border around the content.
         const auto mouse = getMouseState(opt->state);
-        const auto radius = _impl->theme.borderRadius * 1.5;
-        const auto borderColor = tabBarBackgroundColor(mouse);
-        const auto borderW = _impl->theme.borderWidth;
+        const auto radius = _impl->theme->borderRadius * 1.5;
+        const auto borderColor = _impl->tabBarBackgroundColor(mouse);
+        const auto borderW = _impl->theme->borderWidth;
         drawRoundedRectBorder(
           p, opt->rect.adjusted(0, -borderW, 0, 0), borderColor, borderW, RadiusesF(0., 0., radius, radius));
 
         // Draw the background of the tab bar.
-        const auto tabBarHeight = _impl->theme.controlHeightLarge + _impl->theme.spacing;
+        const auto tabBarHeight = _impl->theme->controlHeightLarge + _impl->theme->spacing;
         QStyleOptionTabBarBase tabBarOpt;
         tabBarOpt.initFrom(tabBar);
         tabBarOpt.rect = QRect(0, 0, opt->rect.width(), tabBarHeight);
@@ -486,10 +810,10 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         const auto isFlat = optButton->features.testFlag(QStyleOptionButton::Flat);
         const auto mouse = isFlat ? getToolButtonMouseState(opt->state) : getMouseState(opt->state);
         const auto role = getColorRole(opt->state, isDefault);
-        const auto& bgColor = isFlat ? toolButtonBackgroundColor(mouse, role) : buttonBackgroundColor(mouse, role, w);
+        const auto& bgColor = isFlat ? _impl->toolButtonBackgroundColor(mouse, role) : buttonBackgroundColor(mouse, role, w);
         const auto& currentBgColor =
-          _impl->animations.animateBackgroundColor(w, bgColor, _impl->theme.animationDuration);
-        const auto radiuses = optRoundedButton ? optRoundedButton->radiuses : RadiusesF{ _impl->theme.borderRadius };
+          _impl->animations.animateBackgroundColor(w, bgColor, _impl->theme->animationDuration);
+        const auto radiuses = optRoundedButton ? optRoundedButton->radiuses : RadiusesF{ _impl->theme->borderRadius };
         drawRoundedRect(p, optButton->rect, currentBgColor, radiuses);
       }
       return;
@@ -497,11 +821,11 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
     case PE_FrameTabBarBase:
       if (const auto* optTabBar = qstyleoption_cast<const QStyleOptionTabBarBase*>(opt)) {
         const auto mouse = getMouseState(opt->state);
-        const auto& bgColor = tabBarBackgroundColor(mouse);
+        const auto& bgColor = _impl->tabBarBackgroundColor(mouse);
         if (optTabBar->documentMode) {
           p->fillRect(opt->rect, bgColor);
         } else {
-          const auto radius = _impl->theme.borderRadius * 1.5;
+          const auto radius = _impl->theme->borderRadius * 1.5;
           drawRoundedRect(p, opt->rect, bgColor, RadiusesF(radius, radius, 0., 0.));
         }
       }
@@ -517,14 +841,15 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         const auto& rect = optToolButton->rect;
 
         // Special case/hack for buttons in TabBar.
+        const auto traits = _impl->widgetTraits.traits(w);
         const auto isTabBarScrollButton =
-          qobject_cast<const QTabBar*>(w->parentWidget()) != nullptr && optToolButton->arrowType != Qt::NoArrow;
+          traits.testFlag(WidgetTrait::ParentIsTabBar) && optToolButton->arrowType != Qt::NoArrow;
         const auto hasMenu = optToolButton->features.testFlag(QStyleOptionToolButton::HasMenu);
         const auto menuIsOnSeparateButton =
           hasMenu && optToolButton->features.testFlag(QStyleOptionToolButton::ToolButtonFeature::MenuButtonPopup);
 
-        const auto isMenuBarExtensionButton = qobject_cast<const QMenuBar*>(w->parentWidget()) != nullptr;
-        const auto radius = isMenuBarExtensionButton ? _impl->theme.menuBarItemBorderRadius : _impl->theme.borderRadius;
+        const auto isMenuBarExtensionButton = traits.testFlag(WidgetTrait::ParentIsMenuBar);
+        const auto radius = isMenuBarExtensionButton ? _impl->theme->menuBarItemBorderRadius : _impl->theme->borderRadius;
 
         // Radiuses depend on the type of ToolButton.
         const auto& buttonRadiuses =
@@ -542,15 +867,15 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
 
         // Draw background.
         const auto& bgColor =
-          isTabBarScrollButton ? tabBarScrollButtonBackgroundColor(mouse) : toolButtonBackgroundColor(mouse, role);
-        const auto& currentColor = _impl->animations.animateBackgroundColor(w, bgColor, _impl->theme.animationDuration);
+          isTabBarScrollButton ? _impl->tabBarScrollButtonBackgroundColor(mouse) : _impl->toolButtonBackgroundColor(mouse, role);
+        const auto& currentColor = _impl->animations.animateBackgroundColor(w, bgColor, _impl->theme->animationDuration);
         drawRoundedRect(p, rect, currentColor, buttonRadiuses);
       }
       return;
     case PE_PanelMenuBar: {
       const auto& bgColor = menuBarBackgroundColor();
       const auto& borderColor = menuBarBorderColor();
-      const auto lineWidth = _impl->theme.borderWidth;
+      const auto lineWidth = _impl->theme->borderWidth;
       const auto x1 = static_cast<double>(opt->rect.x());
       const auto x2 = static_cast<double>(x1 + opt->rect.width());
       const auto y = opt->rect.y() + opt->rect.height() - lineWidth / 2.;
@@ -568,7 +893,7 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         const auto& rect = optToolBar->rect;
         p->fillRect(rect, bgColor);
 
-        const auto lineW = _impl->theme.borderWidth;
+        const auto lineW = _impl->theme->borderWidth;
         const auto& lineColor = toolBarBorderColor();
         p->setPen(QPen(lineColor, lineW, Qt::SolidLine, Qt::FlatCap));
         p->setBrush(Qt::NoBrush);
@@ -616,27 +941,25 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
       return;
     case PE_PanelLineEdit:
       if (const auto* optPanelLineEdit = qstyleoption_cast<const QStyleOptionFrame*>(opt)) {
-        const auto* parentWidget = w ? w->parentWidget() : nullptr;
-        const auto* parentParentWidget = parentWidget ? parentWidget->parentWidget() : nullptr;
-        const auto isTabCellEditor =
-          parentParentWidget && qobject_cast<const QAbstractItemView*>(parentParentWidget->parentWidget());
+        const auto traits = _impl->widgetTraits.traits(w);
+        const auto isTabCellEditor = traits.testFlag(WidgetTrait::GreatGrandParentIsItemView);
 
-        const auto isComboBoxLineEdit = qobject_cast<const QComboBox*>(w->parentWidget());
-        const auto qPlainTextEdit = qobject_cast<const QPlainTextEdit*>(w);
+        const auto isComboBoxLineEdit = traits.testFlag(WidgetTrait::ParentIsComboBox);
+        const auto* qPlainTextEdit =
+          traits.testFlag(WidgetTrait::PlainTextEdit) ? static_cast<const QPlainTextEdit*>(w) : nullptr;
         const auto isPlainQPlainTextEdit = qPlainTextEdit && qPlainTextEdit->frameShadow() == QFrame::Shadow::Plain;
         const auto isPlainLineEdit = !isComboBoxLineEdit && !qPlainTextEdit && optPanelLineEdit->lineWidth == 0;
         const auto isPlain = isPlainQPlainTextEdit || isPlainLineEdit;
 
-        const auto radiusF = static_cast<double>(_impl->theme.borderRadius);
+        const auto radiusF = static_cast<double>(_impl->theme->borderRadius);
         auto radiuses = RadiusesF{ radiusF };
-        if (isPlain || isTabCellEditor || (w && w->metaObject()->className() == QStringLiteral("QExpandingLineEdit"))) {
+        if (isPlain || isTabCellEditor || traits.testFlag(WidgetTrait::ExpandingLineEdit)) {
           // The QExpandingLineEdit class is used by QStyleItemDelegate when the cell context type is text.
           radiuses.topRight = 0.;
           radiuses.bottomRight = 0.;
           radiuses.topLeft = 0.;
           radiuses.bottomLeft = 0.;
-        } else if (qobject_cast<const QAbstractSpinBox*>(parentWidget) != nullptr
-                   || qobject_cast<const QComboBox*>(parentWidget) != nullptr) {
+        } else if (traits.testFlag(WidgetTrait::ParentIsSpinBox) || isComboBoxLineEdit) {
           radiuses.topRight = 0.;
           radiuses.bottomRight = 0.;
         }
@@ -649,11 +972,11 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         const auto status = widgetStatus(w);
         const auto mouse = getMouseState(fixedState);
         const auto focus = getFocusState(optPanelLineEdit->state);
-        const auto& bgColor = textFieldBackgroundColor(mouse, status);
-        const auto& borderColor = textFieldBorderColor(mouse, focus, status);
-        const auto borderW = _impl->theme.borderWidth;
+        const auto& bgColor = _impl->textFieldBackgroundColor(mouse, status);
+        const auto& borderColor = _impl->textFieldBorderColor(mouse, focus, status);
+        const auto borderW = _impl->theme->borderWidth;
         const auto& currentBorderColor =
-          _impl->animations.animateBorderColor(w, borderColor, _impl->theme.animationDuration);
+          _impl->animations.animateBorderColor(w, borderColor, _impl->theme->animationDuration);
 
         // Background.
         drawRoundedRect(p, rect, bgColor, radiuses);
@@ -677,8 +1000,8 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         // Arrow.
         if (opt->state.testFlag(State_Children)) {
           const auto open = opt->state & State_Open;
-          const auto indicatorSize = _impl->theme.iconSize;
-          const auto hShift = _impl->theme.spacing / 4;
+          const auto indicatorSize = _impl->theme->iconSize;
+          const auto hShift = _impl->theme->spacing / 4;
           const auto indicatorRect =
             QRect(QPoint{ hShift + optItem->rect.x() + (optItem->rect.width() - indicatorSize.width()) / 2,
                     optItem->rect.y() + (optItem->rect.height() - indicatorSize.height()) / 2 },
@@ -690,7 +1013,7 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
           const auto widgetHasFocus = w->hasFocus();
           const auto focus =
             widgetHasFocus && selection == SelectionState::Selected ? FocusState::Focused : FocusState::NotFocused;
-          const auto& fgColor = listItemForegroundColor(mouse, selection, focus, active);
+          const auto& fgColor = _impl->listItemForegroundColor(mouse, selection, focus, active);
           p->setRenderHint(QPainter::Antialiasing, true);
           p->setBrush(Qt::NoBrush);
           p->setPen(QPen(fgColor, iconPenWidth, Qt::SolidLine, Qt::RoundCap));
@@ -707,11 +1030,11 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         const auto mouse = getMouseState(optItem->state);
         const auto selected = getSelectionState(optItem->state);
         const auto active = getActiveState(optItem->state);
-        const auto& checkBoxFgColor = listItemCheckButtonForegroundColor(mouse, checkState, selected, active);
-        const auto& checkBoxBgColor = listItemCheckButtonBackgroundColor(mouse, checkState, selected, active);
-        const auto& checkBoxBorderColor = listItemCheckButtonBorderColor(mouse, checkState, selected, active);
-        const auto radius = _impl->theme.checkBoxBorderRadius;
-        const auto borderWidth = _impl->theme.borderWidth;
+        const auto& checkBoxFgColor = _impl->listItemCheckButtonForegroundColor(mouse, checkState, selected, active);
+        const auto& checkBoxBgColor = _impl->listItemCheckButtonBackgroundColor(mouse, checkState, selected, active);
+        const auto& checkBoxBorderColor = _impl->listItemCheckButtonBorderColor(mouse, checkState, selected, active);
+        const auto radius = _impl->theme->checkBoxBorderRadius;
+        const auto borderWidth = _impl->theme->borderWidth;
         // Ensure the rect is a perfect square, centered in optButton->rect;.
         const auto indicatorSize = std::max(optItem->rect.width(), optItem->rect.height());
         const auto indicatorX = optItem->rect.x() + (optItem->rect.width() - indicatorSize);
@@ -727,10 +1050,10 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         const auto checkState = getCheckState(optButton->state);
         const auto mouse = getMouseState(optButton->state);
         const auto focus = getFocusState(optButton->state);
-        const auto& bgColor = checkButtonBackgroundColor(mouse, checkState);
-        const auto& fgColor = checkButtonForegroundColor(mouse, checkState);
-        const auto& borderColor = checkButtonBorderColor(mouse, focus, checkState);
-        const auto borderW = _impl->theme.borderWidth;
+        const auto& bgColor = _impl->checkButtonBackgroundColor(mouse, checkState);
+        const auto& fgColor = _impl->checkButtonForegroundColor(mouse, checkState);
+        const auto& borderColor = _impl->checkButtonBorderColor(mouse, focus, checkState);
+        const auto borderW = _impl->theme->borderWidth;
 
         // Ensure the rect is a perfect square, centered in optButton->rect.
         const auto indicatorSize = std::max(optButton->rect.width(), optButton->rect.height());
@@ -741,16 +1064,16 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         // Animations.
         const auto progress = checkState == CheckState::NotChecked ? 0. : 1.;
         const auto& currentBgColor =
-          _impl->animations.animateBackgroundColor(w, bgColor, _impl->theme.animationDuration);
+          _impl->animations.animateBackgroundColor(w, bgColor, _impl->theme->animationDuration);
         const auto& currentBorderColor =
-          _impl->animations.animateBorderColor(w, borderColor, _impl->theme.animationDuration);
-        const auto currentProgress = _impl->animations.animateProgress(w, progress, _impl->theme.animationDuration);
+          _impl->animations.animateBorderColor(w, borderColor, _impl->theme->animationDuration);
+        const auto currentProgress = _impl->animations.animateProgress(w, progress, _impl->theme->animationDuration);
 
         const auto isRadio = pe == PE_IndicatorRadioButton;
         if (isRadio) {
           drawRadioButton(p, indicatorRect, currentBgColor, currentBorderColor, fgColor, borderW, currentProgress);
         } else {
-          const auto radius = _impl->theme.checkBoxBorderRadius;
+          const auto radius = _impl->theme->checkBoxBorderRadius;
           drawCheckButton(p, indicatorRect, radius, currentBgColor, currentBorderColor, fgColor, borderW,
             currentProgress, checkState);
         }
@@ -763,7 +1086,7 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         const auto indicatorType = optHeader->sortIndicator;
         const auto mouse = getMouseState(optHeader->state);
         const auto checked = getCheckState(optHeader->state);
-        const auto& fgColor = tableHeaderFgColor(mouse, checked);
+        const auto& fgColor = _impl->tableHeaderFgColor(mouse, checked);
         p->setRenderHint(QPainter::Antialiasing, true);
         p->setBrush(Qt::NoBrush);
         p->setPen(QPen(fgColor, 1.001, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
@@ -798,8 +1121,8 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
       const auto& rect = opt->rect;
       const auto& color = toolBarSeparatorColor();
       const auto horizontal = opt->state.testFlag(State_Horizontal);
-      const auto lineW = _impl->theme.borderWidth;
-      constexpr auto padding = 0; //_impl->theme.spacing / 2;
+      const auto lineW = _impl->theme->borderWidth;
+      constexpr auto padding = 0; //_impl->theme->spacing / 2;
       p->setBrush(Qt::NoBrush);
       p->setPen(QPen(color, lineW, Qt::SolidLine, Qt::FlatCap));
       if (horizontal) {
@@ -819,7 +1142,7 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
       const auto& bgColor = toolTipBackgroundColor();
       const auto& borderColor = toolTipBorderColor();
       constexpr auto radius = 0.;
-      const auto borderW = _impl->theme.borderWidth;
+      const auto borderW = _impl->theme->borderWidth;
       p->setRenderHint(QPainter::Antialiasing, true);
       p->setPen(Qt::NoPen);
       p->setBrush(bgColor);
@@ -833,14 +1156,14 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
       const auto documentMode = tabBar && tabBar->documentMode();
       const auto& rect = opt->rect;
       const auto startPos = QPointF(rect.topLeft());
-      const auto shadowW = _impl->theme.spacing * 3;
+      const auto shadowW = _impl->theme->spacing * 3;
       const auto endPos = QPointF(rect.topLeft()) + QPointF{ static_cast<double>(shadowW), 0. };
       auto gradient = QLinearGradient(startPos, endPos);
       const auto& startColor = tabBarShadowColor();
-      const auto& endColor = _impl->theme.shadowColorTransparent;
+      const auto& endColor = _impl->theme->shadowColorTransparent;
       gradient.setColorAt(0., startColor);
       gradient.setColorAt(1., endColor);
-      const auto radius = _impl->theme.borderRadius * 1.5;
+      const auto radius = _impl->theme->borderRadius * 1.5;
       const auto compModeBackup = p->compositionMode();
       p->setCompositionMode(QPainter::CompositionMode_Multiply);
 
@@ -854,27 +1177,27 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
       const auto documentMode = tabBar && tabBar->documentMode();
       const auto& rect = opt->rect;
 
-      const auto scrollButtonsW = _impl->theme.controlHeightMedium * 2 + _impl->theme.spacing * 3;
-      const auto shadowW = _impl->theme.spacing * 3;
+      const auto scrollButtonsW = _impl->theme->controlHeightMedium * 2 + _impl->theme->spacing * 3;
+      const auto shadowW = _impl->theme->spacing * 3;
 
       // Shadow gradient.
       const auto startPos = QPointF(rect.topLeft());
       const auto endPos = QPointF(rect.topLeft()) + QPointF{ static_cast<double>(shadowW), 0. };
       auto gradient = QLinearGradient(startPos, endPos);
-      const auto& startColor = _impl->theme.shadowColorTransparent;
+      const auto& startColor = _impl->theme->shadowColorTransparent;
       const auto& endColor = tabBarShadowColor();
       gradient.setColorAt(0., startColor);
       gradient.setColorAt(1., endColor);
       const auto compModeBackup = p->compositionMode();
       p->setCompositionMode(QPainter::CompositionMode_Multiply);
-      const auto radius = _impl->theme.borderRadius * 1.5;
+      const auto radius = _impl->theme->borderRadius * 1.5;
       drawRoundedRect(p, rect, gradient, documentMode ? RadiusesF(0.) : RadiusesF(0., radius, 0., 0.));
       p->setCompositionMode(compModeBackup);
 
       // Filled rectangle below scroll buttons.
       // We need to fill the whole surface to ensure tabs are not visible below.
       const auto mouse = getMouseState(opt->state);
-      const auto& tabBarBgColor = tabBarBackgroundColor(mouse);
+      const auto& tabBarBgColor = _impl->tabBarBackgroundColor(mouse);
       const auto filledRect = QRect(rect.x() + rect.width() - scrollButtonsW, rect.y(), scrollButtonsW, rect.height());
       drawRoundedRect(p, filledRect, tabBarBgColor, documentMode ? RadiusesF(0.) : RadiusesF(0., radius, 0., 0.));
     }
@@ -898,46 +1221,37 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         const auto itemState = optItem->state;
         const auto mouse = getMouseState(itemState);
         const auto selection = getSelectionState(itemState);
-        const auto widgetHasFocus = (w && w->hasFocus());
+        const auto viewContext = _impl->itemViewPaintContext(w, p);
         const auto focus =
-          widgetHasFocus && selection == SelectionState::Selected ? FocusState::Focused : FocusState::NotFocused;
+          viewContext.hasFocus && selection == SelectionState::Selected ? FocusState::Focused : FocusState::NotFocused;
         const auto active = getActiveState(itemState);
         const auto& color = listItemBackgroundColor(mouse, selection, focus, active, optItem->index, w);
         p->fillRect(rect, color);
 
         // Border on the left if necessary.
-        if (column == 0) {
-          if (const auto* tableView = qobject_cast<const QTableView*>(w)) {
-            if (tableView->showGrid() && tableView->verticalHeader()->isHidden()) {
-              const auto lineW = _impl->theme.borderWidth;
-              const auto p1 = QPointF(rect.x() + lineW * .5, rect.y());
-              const auto p2 = QPointF(rect.x() + lineW * .5, rect.y() + rect.height());
-              const auto& lineColor = tableLineColor();
-              p->setRenderHint(QPainter::Antialiasing, false);
-              p->setPen(QPen(lineColor, lineW));
-              p->drawLine(p1, p2);
-            }
-          }
+        if (column == 0 && viewContext.drawLeftGridLine) {
+          const auto lineW = _impl->theme->borderWidth;
+          const auto p1 = QPointF(rect.x() + lineW * .5, rect.y());
+          const auto p2 = QPointF(rect.x() + lineW * .5, rect.y() + rect.height());
+          const auto& lineColor = tableLineColor();
+          p->setRenderHint(QPainter::Antialiasing, false);
+          p->setPen(QPen(lineColor, lineW));
+          p->drawLine(p1, p2);
         }
         // Border on the top if necessary.
-        if (row == 0) {
-          if (const auto* tableView = qobject_cast<const QTableView*>(w)) {
-            if (tableView->showGrid() && tableView->horizontalHeader()->isHidden()) {
-              const auto lineW = _impl->theme.borderWidth;
-              const auto p1 = QPointF(rect.x(), rect.y() + lineW * .5);
-              const auto p2 = QPointF(rect.x() + rect.width(), rect.y() + lineW * .5);
-              const auto& lineColor = tableLineColor();
-              p->setRenderHint(QPainter::Antialiasing, false);
-              p->setPen(QPen(lineColor, lineW));
-              p->drawLine(p1, p2);
-            }
-          }
+        if (row == 0 && viewContext.drawTopGridLine) {
+          const auto lineW = _impl->theme->borderWidth;
+          const auto p1 = QPointF(rect.x(), rect.y() + lineW * .5);
+          const auto p2 = QPointF(rect.x() + rect.width(), rect.y() + lineW * .5);
+          const auto& lineColor = tableLineColor();
+          p->setRenderHint(QPainter::Antialiasing, false);
+          p->setPen(QPen(lineColor, lineW));
+          p->drawLine(p1, p2);
         }
 
         // Border that indicates which cell has focus.
         // We don't show this border in the first column of a table/tree (the column with the arrow).
-        const auto isTable = qobject_cast<const QTableView*>(w) != nullptr;
-        if (isTable && row < 0)
+        if (viewContext.isTable && row < 0)
           return;
 
 #if 0
@@ -949,8 +1263,8 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         //const auto multiSelection = itemView ? itemView->selectionMode() != QAbstractItemView::SelectionMode::SingleSelection : false;
         const auto showCellFocus = true; //multiColumn ? isCurrentCell : multiSelection;
         const auto cellFocus = showCellFocus ? focus : FocusState::NotFocused;
-        const auto& borderColor = cellItemFocusBorderColor(cellFocus, selection, active);
-        const auto borderW = _impl->theme.borderWidth * 2;
+        const auto& borderColor = _impl->cellItemFocusBorderColor(cellFocus, selection, active);
+        const auto borderW = _impl->theme->borderWidth * 2;
         auto borderRect = optItem->rect;
         borderRect.setLeft(0);
         drawRectBorder(p, borderRect, borderColor, borderW);
@@ -962,7 +1276,7 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
         // Draw alternate row color.
         const auto alternate = getAlternateState(optItem->features);
         const auto mouse = optItem->state.testFlag(State_Enabled) ? MouseState::Normal : MouseState::Disabled;
-        const auto& color = listItemRowBackgroundColor(mouse, alternate);
+        const auto& color = _impl->listItemRowBackgroundColor(mouse, alternate);
         p->fillRect(optItem->rect, color);
 
         // Draw selection color in the arrow area,
@@ -977,7 +1291,7 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
     case PE_PanelStatusBar: {
       const auto& bgColor = statusBarBackgroundColor();
       const auto& borderColor = statusBarBorderColor();
-      const auto borderW = _impl->theme.borderWidth;
+      const auto borderW = _impl->theme->borderWidth;
       p->fillRect(opt->rect, bgColor);
 
       const auto lineRect = QRect(opt->rect.x(), opt->rect.y(), opt->rect.width(), borderW);
@@ -1004,13 +1318,13 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
           const auto visible = (!tabBarPressed && tabHovered) || tabSelected;
 
           // Avoid animation (t=0) if mouse not over.
-          const auto duration = visible ? _impl->theme.animationDuration : 0;
+          const auto duration = visible ? _impl->theme->animationDuration : 0;
 
           // Background.
           const auto radius = static_cast<double>(rect.height()) / 2.;
           const auto mouse = getTabItemMouseState(opt->state, tabHovered);
           const auto selected = getSelectionState(opt->state);
-          const auto& bgColor = tabCloseButtonBackgroundColor(mouse, selected);
+          const auto& bgColor = _impl->tabCloseButtonBackgroundColor(mouse, selected);
           const auto currentBgColor = _impl->animations.animateBackgroundColor(button, bgColor, duration);
           p->setRenderHint(QPainter::Antialiasing, true);
           p->setPen(Qt::NoPen);
@@ -1018,11 +1332,11 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
           p->drawRoundedRect(rect, radius, radius);
 
           // Foreground.
-          const auto& fgColor = tabCloseButtonForegroundColor(mouse, selected);
+          const auto& fgColor = _impl->tabCloseButtonForegroundColor(mouse, selected);
           const auto currentFgColor = _impl->animations.animateForegroundColor(button, fgColor, duration);
           p->setPen(QPen(currentFgColor, iconPenWidth, Qt::SolidLine, Qt::FlatCap, Qt::RoundJoin));
           p->setBrush(Qt::NoBrush);
-          const auto& iconSize = _impl->theme.iconSize;
+          const auto& iconSize = _impl->theme->iconSize;
           const auto closeRect = QRect(rect.x() + (rect.width() - iconSize.width()) / 2,
             rect.y() + (rect.height() - iconSize.height()) / 2, iconSize.width(), iconSize.height());
           drawCloseIndicator(closeRect, p);
@@ -1030,18 +1344,18 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
       }
       return;
     case PE_PanelMenu: {
-      const auto radius = _impl->theme.borderRadius;
+      const auto radius = _impl->theme->borderRadius;
       const auto& bgColor = menuBackgroundColor();
       const auto& borderColor = menuBorderColor();
-      const auto borderW = _impl->theme.borderWidth;
+      const auto borderW = _impl->theme->borderWidth;
       p->setRenderHint(QPainter::Antialiasing, true);
       const auto totalRect = opt->rect;
       const auto shadowPadding = pixelMetric(PM_MenuPanelWidth);
       const auto frameRect = totalRect.marginsRemoved({ shadowPadding, shadowPadding, shadowPadding, shadowPadding });
-      const auto dropShadowRadius = _impl->theme.spacing;
+      const auto dropShadowRadius = _impl->theme->spacing;
       const auto dropShadowOffsetY = shadowPadding / 3;
       const auto dropShadowPixmap =
-        getDropShadowPixmap(frameRect.size(), radius, dropShadowRadius, _impl->theme.shadowColor1);
+        getDropShadowPixmap(frameRect.size(), radius, dropShadowRadius, _impl->theme->shadowColor1);
       const auto dropShadowX = frameRect.x() + (frameRect.width() - dropShadowPixmap.width()) / 2;
       const auto dropShadowY = frameRect.y() + (frameRect.height() - dropShadowPixmap.height()) / 2 + dropShadowOffsetY;
 
@@ -1064,6 +1378,7 @@ void QlementineStyle::drawPrimitive(PrimitiveElement pe, const QStyleOption* opt
 }
 
 void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QPainter* p, const QWidget* w) const {
+  const NinePatchRoundedRectsScope ninePatchScope(_impl->ninePatchRoundedRects);
   switch (ce) {
     case CE_PushButton:
       if (const auto* optButton = qstyleoption_cast<const QStyleOptionButton*>(opt)) {
@@ -1097,9 +1412,9 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         const auto role = getColorRole(optButton->state, isDefault);
         const auto& fgColor = buttonForegroundColor(mouse, role);
         const auto& currentFgColor =
-          _impl->animations.animateForegroundColor(w, fgColor, _impl->theme.animationDuration);
+          _impl->animations.animateForegroundColor(w, fgColor, _impl->theme->animationDuration);
         const auto indicatorSize = pixelMetric(PM_MenuButtonIndicator, opt, w);
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto hasMenu = optButton->features.testFlag(QStyleOptionButton::HasMenu);
         const auto centered = !hasMenu;
         const auto checked = getCheckState(optButton->state);
@@ -1156,10 +1471,9 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
           const auto indicatorX = optButton->rect.x() + optButton->rect.width() - indicatorW;
           const auto indicatorY = optButton->rect.y() + (optButton->rect.height() - indicatorH) / 2;
           const auto indicatorRect = QRect{ indicatorX, indicatorY, indicatorW, indicatorH };
-          const auto path = getMenuIndicatorPath(indicatorRect);
           p->setBrush(Qt::NoBrush);
           p->setPen(QPen(currentFgColor, iconPenWidth, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-          p->drawPath(path);
+          drawMenuIndicator(indicatorRect, p);
         }
       }
       return;
@@ -1185,7 +1499,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         // Draw text and icon.
         const auto mouse = getMouseState(optButton->state);
         const auto& fgColor = labelForegroundColor(mouse, w);
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto checked = getCheckState(optButton->state);
         const auto pixmap = getPixmap(optButton->icon, optButton->iconSize, mouse, checked, w);
         const auto& colorizedPixmap = getColorizedPixmap(pixmap, autoIconColor(w), fgColor, fgColor);
@@ -1250,9 +1564,9 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         // Avoid drawing the tab if the mouse is over scroll buttons.
         const auto* tabBar = qobject_cast<const QTabBar*>(w);
         const auto cursorPos = tabBar->mapFromGlobal(QCursor::pos());
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto buttonsVisible = QlementineStyleImpl::areTabBarScrollButtonsVisible(tabBar);
-        const auto buttonsW = buttonsVisible ? _impl->theme.controlHeightMedium * 2 + spacing * 3 : 0;
+        const auto buttonsW = buttonsVisible ? _impl->theme->controlHeightMedium * 2 + spacing * 3 : 0;
         const auto mouseOverButtons = cursorPos.x() > tabBar->width() - buttonsW;
 
         // The tab shape must be drawn in these cases:
@@ -1261,11 +1575,11 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         const auto drawShape = tabIsSelected || (!mouseOverButtons && mouseOverTab);
         const auto drawShadow = tabIsSelected && !mousePressed;
         if (drawShape) {
-          const auto radius = _impl->theme.borderRadius;
-          const auto& bgColor = tabBackgroundColor(mouse, selection);
+          const auto radius = _impl->theme->borderRadius;
+          const auto& bgColor = _impl->tabBackgroundColor(mouse, selection);
           const auto& radiuses =
             tabIsSelected ? RadiusesF(radius, radius, radius, radius) : RadiusesF(radius, radius, 0., 0.);
-          drawTab(p, optTab->rect, radiuses, bgColor, drawShadow, _impl->theme.shadowColor2);
+          drawTab(p, optTab->rect, radiuses, bgColor, drawShadow, _impl->theme->shadowColor2);
         }
       }
       return;
@@ -1282,9 +1596,9 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
         const auto mouse = getMouseState(optTab->state);
         const auto selection = getSelectionState(optTab->state);
-        const auto& fgColor = tabForegroundColor(mouse, selection);
+        const auto& fgColor = _impl->tabForegroundColor(mouse, selection);
 
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto& icon = optTab->icon;
         const auto& iconSize = icon.isNull() ? QSize{ 0, 0 } : optTab->iconSize;
         const auto& fm = optTab->fontMetrics;
@@ -1360,7 +1674,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         // Background.
         const auto radius = optProgressBar->rect.height() / 2.;
         const auto mouse = getMouseState(optProgressBar->state);
-        const auto& color = progressBarGrooveColor(mouse);
+        const auto& color = _impl->progressBarGrooveColor(mouse);
         drawRoundedRect(p, optProgressBar->rect, color, radius);
       }
       return;
@@ -1369,13 +1683,13 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         // Draw foreground rect.
         const auto radius = optProgressBar->rect.height() / 2.;
         const auto mouse = getMouseState(optProgressBar->state);
-        const auto& color = progressBarValueColor(mouse);
+        const auto& color = _impl->progressBarValueColor(mouse);
         const auto indeterminate = optProgressBar->maximum == 0 && optProgressBar->minimum == 0;
 
         if (indeterminate) {
           // Goes from 0 to 1.
           const auto currentProgress =
-            _impl->animations.animateProgress3(w, 1., _impl->theme.animationDuration * 8, true);
+            _impl->animations.animateProgress3(w, 1., _impl->theme->animationDuration * 8, true);
           // Bell that goes from 0 to 1 then 1 to 0, centered on 0.5.
           const auto currentRatio = std::pow(std::sin(QLEMENTINE_PI * currentProgress), 2);
 
@@ -1390,7 +1704,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         } else {
           _impl->animations.animateProgress3(w, 0., 0, false); // Stop loop, just in case.
           const auto progress = optProgressBar->progress;
-          const auto currentProgress = _impl->animations.animateProgress(w, progress, _impl->theme.animationDuration);
+          const auto currentProgress = _impl->animations.animateProgress(w, progress, _impl->theme->animationDuration);
           drawProgressBarValueRect(p, optProgressBar->rect, color, optProgressBar->minimum, optProgressBar->maximum,
             currentProgress, radius, optProgressBar->invertedAppearance);
         }
@@ -1413,7 +1727,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
           const auto& color = menuSeparatorColor();
           const auto hMargin = 0;
           const auto rect = optMenuItem->rect.marginsRemoved(QMargins(hMargin, 0, hMargin, 0));
-          const auto separatorThickness = _impl->theme.borderWidth;
+          const auto separatorThickness = _impl->theme->borderWidth;
           drawMenuSeparator(p, rect, color, separatorThickness);
 
         } else if (optMenuItem->menuItemType == QStyleOptionMenuItem::Normal
@@ -1422,21 +1736,21 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
           // Background.
           const auto& bgRect = optMenuItem->rect;
-          const auto& bgColor = menuItemBackgroundColor(mouse);
-          const auto menuItemRadius = _impl->theme.menuItemBorderRadius;
+          const auto& bgColor = _impl->menuItemBackgroundColor(mouse);
+          const auto menuItemRadius = _impl->theme->menuItemBorderRadius;
           p->setRenderHint(QPainter::Antialiasing, true);
           p->setPen(Qt::NoPen);
           p->setBrush(bgColor);
           p->drawRoundedRect(bgRect, menuItemRadius, menuItemRadius);
 
           // Foreground.
-          const auto spacing = _impl->theme.spacing;
-          const auto& fgColor = menuItemForegroundColor(mouse);
+          const auto spacing = _impl->theme->spacing;
+          const auto& fgColor = _impl->menuItemForegroundColor(mouse);
           const auto menuHasCheckable = optMenuItem->menuHasCheckableItems;
           const auto checkable = optMenuItem->checkType != QStyleOptionMenuItem::NotCheckable;
           const auto checkState = optMenuItem->checked ? CheckState::Checked : CheckState::NotChecked;
-          const auto arrowW = _impl->theme.iconSize.width();
-          const auto hPadding = _impl->theme.spacing;
+          const auto arrowW = _impl->theme->iconSize.width();
+          const auto hPadding = _impl->theme->spacing;
           const auto fgRect = bgRect.marginsRemoved(QMargins{ hPadding, 0, hPadding, 0 });
           const auto [label, shortcut] = getMenuLabelAndShortcut(optMenuItem->text);
           const auto useMnemonic = styleHint(SH_UnderlineShortcut, opt, w);
@@ -1449,7 +1763,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
           // Check.
           if (menuHasCheckable || checkable) {
-            const auto checkBoxSize = _impl->theme.iconSize;
+            const auto checkBoxSize = _impl->theme->iconSize;
 
             if (checkable) {
               const auto checkBoxX = availableX;
@@ -1457,18 +1771,18 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
               const auto checkboxRect = QRect{ QPoint{ checkBoxX, checkBoxY }, checkBoxSize };
               const auto isRadio = optMenuItem->checkType == QStyleOptionMenuItem::Exclusive;
               const auto progress = checkState == CheckState::Checked ? 1. : 0.;
-              const auto borderW = _impl->theme.borderWidth;
+              const auto borderW = _impl->theme->borderWidth;
               const auto selected = getSelectionState(optMenuItem->state);
               const auto active = getActiveState(optMenuItem->state);
-              const auto& boxFgColor = listItemCheckButtonForegroundColor(mouse, checkState, selected, active);
-              const auto& boxBgColor = listItemCheckButtonBackgroundColor(mouse, checkState, selected, active);
-              const auto& boxBorderColor = listItemCheckButtonBorderColor(mouse, checkState, selected, active);
+              const auto& boxFgColor = _impl->listItemCheckButtonForegroundColor(mouse, checkState, selected, active);
+              const auto& boxBgColor = _impl->listItemCheckButtonBackgroundColor(mouse, checkState, selected, active);
+              const auto& boxBorderColor = _impl->listItemCheckButtonBorderColor(mouse, checkState, selected, active);
 
               // TODO draw smaller checks.
               if (isRadio) {
                 drawRadioButton(p, checkboxRect, boxBgColor, boxBorderColor, boxFgColor, borderW, progress);
               } else {
-                const auto checkBoxRadius = _impl->theme.checkBoxBorderRadius;
+                const auto checkBoxRadius = _impl->theme->checkBoxBorderRadius;
                 drawCheckButton(p, checkboxRect, checkBoxRadius, boxBgColor, boxBorderColor, boxFgColor, borderW,
                   progress, checkState);
               }
@@ -1484,7 +1798,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
             !QCoreApplication::testAttribute(Qt::AA_DontShowIconsInMenus) && optMenuItem->maxIconWidth > 0
               ? optMenuItem->maxIconWidth + spacing
               : 0;
-          const auto pixmap = getPixmap(optMenuItem->icon, _impl->theme.iconSize, mouse, checkState, w);
+          const auto pixmap = getPixmap(optMenuItem->icon, _impl->theme->iconSize, mouse, checkState, w);
           if (!pixmap.isNull()) {
             const auto& colorizedPixmap = getColorizedPixmap(pixmap, autoIconColor(w), fgColor, fgColor);
             const auto targetPxRatio = colorizedPixmap.devicePixelRatio();
@@ -1507,7 +1821,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
               const auto shortcutRect = QRect{ shortcutX, fgRect.y(), shortcutW, fgRect.height() };
               constexpr auto shortcutFlags =
                 Qt::AlignVCenter | Qt::AlignBaseline | Qt::TextSingleLine | Qt::AlignRight | Qt::TextHideMnemonic;
-              const auto& shortcutColor = menuItemSecondaryForegroundColor(mouse);
+              const auto& shortcutColor = _impl->menuItemSecondaryForegroundColor(mouse);
               p->setPen(shortcutColor);
               p->drawText(shortcutRect, shortcutFlags, shortcut);
 
@@ -1539,7 +1853,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
           // Menu indicator.
           if (hasSubMenu) {
             const auto arrowRightMargin = spacing;
-            const auto arrowSize = _impl->theme.iconSize;
+            const auto arrowSize = _impl->theme->iconSize;
             const auto arrowX = bgRect.x() + bgRect.width() - arrowSize.width() - arrowRightMargin;
             const auto arrowY = bgRect.y() + (bgRect.height() - arrowSize.height()) / 2;
             const auto arrowRect = QRect(arrowX, arrowY, arrowSize.width(), arrowSize.height());
@@ -1554,14 +1868,14 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
       if (const auto* optMenuItem = qstyleoption_cast<const QStyleOptionMenuItem*>(opt)) {
         // Background .
         const auto mouse = getMenuItemMouseState(optMenuItem->state);
-        const auto& bgColor = menuItemBackgroundColor(mouse);
-        const auto radius = _impl->theme.menuItemBorderRadius;
+        const auto& bgColor = _impl->menuItemBackgroundColor(mouse);
+        const auto radius = _impl->theme->menuItemBorderRadius;
         drawRoundedRect(p, opt->rect, bgColor, radius);
 
         // Foreground.
         const auto isDownArrow = optMenuItem->state.testFlag(State_DownArrow);
-        const auto& fgColor = menuItemForegroundColor(mouse);
-        const auto iconSize = _impl->theme.iconSize;
+        const auto& fgColor = _impl->menuItemForegroundColor(mouse);
+        const auto iconSize = _impl->theme->iconSize;
         const auto iconX = opt->rect.x() + (opt->rect.width() - iconSize.width()) / 2;
         const auto iconY = opt->rect.y() + (opt->rect.height() - iconSize.height()) / 2;
         const auto iconRect = QRect{ QPoint(iconX, iconY), iconSize };
@@ -1587,13 +1901,13 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
       if (const auto* optMenuItem = qstyleoption_cast<const QStyleOptionMenuItem*>(opt)) {
         // Background .
         const auto mouse = getMenuItemMouseState(optMenuItem->state);
-        const auto& bgColor = menuItemBackgroundColor(mouse);
-        const auto radius = _impl->theme.menuItemBorderRadius;
+        const auto& bgColor = _impl->menuItemBackgroundColor(mouse);
+        const auto radius = _impl->theme->menuItemBorderRadius;
         drawRoundedRect(p, opt->rect, bgColor, radius);
 
         // Foreground.
-        const auto& fgColor = menuItemForegroundColor(mouse);
-        const auto iconSize = _impl->theme.iconSize;
+        const auto& fgColor = _impl->menuItemForegroundColor(mouse);
+        const auto iconSize = _impl->theme->iconSize;
         const auto iconX = opt->rect.x() + (opt->rect.width() - iconSize.width()) / 2;
         const auto iconY = opt->rect.y() + (opt->rect.height() - iconSize.height()) / 2;
         const auto iconRect = QRect{ QPoint(iconX, iconY), iconSize };
@@ -1612,8 +1926,8 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         // Item.
         const auto mouse = getMenuItemMouseState(optMenuItem->state);
         const auto selected = getSelectionState(optMenuItem->state);
-        const auto& bgColor = menuBarItemBackgroundColor(mouse, selected);
-        const auto& fgColor = menuBarItemForegroundColor(mouse, selected);
+        const auto& bgColor = _impl->menuBarItemBackgroundColor(mouse, selected);
+        const auto& fgColor = _impl->menuBarItemForegroundColor(mouse, selected);
         int textFlags = Qt::AlignVCenter | Qt::AlignBaseline | Qt::TextSingleLine | Qt::AlignHCenter;
         if (styleHint(SH_UnderlineShortcut, opt, w)) {
           textFlags |= Qt::TextShowMnemonic;
@@ -1621,7 +1935,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         if (w && !w->hasFocus()) {
           textFlags |= Qt::TextHideMnemonic;
         }
-        const auto radius = _impl->theme.menuBarItemBorderRadius;
+        const auto radius = _impl->theme->menuBarItemBorderRadius;
         p->setPen(Qt::NoPen);
         p->setBrush(bgColor);
         p->setRenderHint(QPainter::Antialiasing, true);
@@ -1658,8 +1972,8 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         const auto mouse = getToolButtonMouseState(buttonState);
         const auto role = getColorRole(buttonState, false);
         const auto checked = getCheckState(buttonState);
-        const auto& fgColor = toolButtonForegroundColor(mouse, role);
-        const auto spacing = _impl->theme.spacing;
+        const auto& fgColor = _impl->toolButtonForegroundColor(mouse, role);
+        const auto spacing = _impl->theme->spacing;
         const auto hasMenu = optToolButton->features.testFlag(QStyleOptionToolButton::HasMenu);
         const auto leftPadding = buttonStyle == Qt::ToolButtonTextOnly ? spacing * 2 : spacing;
         const auto hasIcon = showIcon && !iconSize.isEmpty();
@@ -1753,12 +2067,12 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         // Background.
         const auto mouse = getMouseState(opt->state);
         const auto checked = getCheckState(opt->state);
-        const auto& bgColor = tableHeaderBgColor(mouse, checked);
+        const auto& bgColor = _impl->tableHeaderBgColor(mouse, checked);
         p->fillRect(rect, bgColor);
 
         // Lines.
         const auto& lineColor = tableLineColor();
-        const auto lineW = _impl->theme.borderWidth;
+        const auto lineW = _impl->theme->borderWidth;
         p->setRenderHint(QPainter::Antialiasing, false);
         p->setBrush(Qt::NoBrush);
         p->setPen(QPen(lineColor, lineW));
@@ -1822,7 +2136,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         const auto& rect = optHeader->rect;
 
         const auto iconExtent = pixelMetric(PM_SmallIconSize, opt);
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
 
         const auto hasArrow = optHeader->sortIndicator != QStyleOptionHeader::SortIndicator::None;
         const auto arrowSpace = spacing / 2 + iconExtent;
@@ -1860,7 +2174,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
         const auto mouse = getMouseState(optHeader->state);
         const auto checked = getCheckState(optHeader->state);
-        const auto& fgColor = tableHeaderFgColor(mouse, checked);
+        const auto& fgColor = _impl->tableHeaderFgColor(mouse, checked);
 
         // Icon.
         if (hasIcon && availableW > iconExtent) {
@@ -1898,7 +2212,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
       }
       return;
     case CE_HeaderEmptyArea: {
-      const auto& bgColor = tableHeaderBgColor(MouseState::Normal, CheckState::NotChecked);
+      const auto& bgColor = _impl->tableHeaderBgColor(MouseState::Normal, CheckState::NotChecked);
       p->fillRect(opt->rect, bgColor);
     }
       return;
@@ -1911,7 +2225,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
       constexpr auto minSplitterThickness = 1;
       const auto& rect = opt->rect;
       const auto mouse = getMouseState(opt->state);
-      const auto& lineColor = splitterColor(mouse);
+      const auto& lineColor = _impl->splitterColor(mouse);
       const auto isHorizontal = opt->state.testFlag(QStyle::State_Horizontal);
       const auto lineThickness =
         std::clamp(isHorizontal ? rect.width() : rect.height(), minSplitterThickness, maxSplitterThickness);
@@ -1952,7 +2266,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
       if (const auto* focusFrame = qobject_cast<const QFocusFrame*>(w)) {
         const auto* monitoredWidget = focusFrame->widget();
         const auto hasFocus = monitoredWidget ? monitoredWidget->hasFocus() : false;
-        const auto borderW = _impl->theme.focusBorderWidth;
+        const auto borderW = _impl->theme->focusBorderWidth;
 
         QStyleOptionFocusRoundedRect optFocus;
         optFocus.QStyleOption::operator=(*opt);
@@ -1967,7 +2281,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
           // PushButton: placed around the button itself.
           optFocus.rect = subElementRect(SE_PushButtonFocusRect, &optButton, button);
-          optFocus.radiuses = _impl->theme.borderRadius;
+          optFocus.radiuses = _impl->theme->borderRadius;
         } else if (const auto* toolButton = qobject_cast<const QToolButton*>(monitoredWidget)) {
           // Prepare monitored widget QStyleOption.
           QStyleOptionToolButton optToolButton;
@@ -1976,7 +2290,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
           // ToolButton: placed around the button itself.
           optFocus.rect = subElementRect(SE_PushButtonFocusRect, &optToolButton, toolButton);
-          optFocus.radiuses = _impl->theme.borderRadius;
+          optFocus.radiuses = _impl->theme->borderRadius;
         } else if (const auto* checkBox = qobject_cast<const QCheckBox*>(monitoredWidget)) {
           // Prepare monitored widget QStyleOption.
           QStyleOptionButton optCheckBox;
@@ -1985,7 +2299,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
           // Checkbox: placed around the check button.
           optFocus.rect = subElementRect(SE_CheckBoxFocusRect, &optCheckBox, checkBox);
-          optFocus.radiuses = _impl->theme.checkBoxBorderRadius;
+          optFocus.radiuses = _impl->theme->checkBoxBorderRadius;
         } else if (const auto* radioButton = qobject_cast<const QRadioButton*>(monitoredWidget)) {
           // Prepare monitored widget QStyleOption.
           QStyleOptionButton optRadioButton;
@@ -2014,7 +2328,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
           // AbstractButton (fallback): placed around the button.
           optFocus.rect = subElementRect(SE_PushButtonFocusRect, &optAbstractButton, abstractButton);
-          optFocus.radiuses = _impl->theme.borderRadius;
+          optFocus.radiuses = _impl->theme->borderRadius;
         } else if (const auto* slider = qobject_cast<const QSlider*>(monitoredWidget)) {
           // Prepare monitored widget QStyleOption.
           const auto currentPos = _impl->animations.getAnimatedProgress(slider);
@@ -2065,7 +2379,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
           const auto margin = isPlainLineEdit ? borderW * 2 : borderW;
           optFocus.rect = optFocus.rect.marginsRemoved(QMargins(margin, margin, margin, margin));
-          optFocus.radiuses = _impl->theme.borderRadius;
+          optFocus.radiuses = _impl->theme->borderRadius;
 
           // Check if the QLineEdit is inside a QSpinBox and +/- buttons are visible,
           // or inside an editable QComboBox.
@@ -2093,7 +2407,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
             const auto deltaX = pixelMetric(PM_FocusFrameHMargin, opt, w);
             const auto deltaY = pixelMetric(PM_FocusFrameVMargin, opt, w);
             optFocus.rect = checkRect.translated(deltaX, deltaY);
-            optFocus.radiuses = _impl->theme.checkBoxBorderRadius;
+            optFocus.radiuses = _impl->theme->checkBoxBorderRadius;
           }
         } else if (const auto* comboBox = qobject_cast<const QComboBox*>(monitoredWidget)) {
           // Check if the QLineEdit is within a QComboBox.
@@ -2114,7 +2428,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
           // ComboBox: placed around the button itself.
           optFocus.rect = subElementRect(SE_ComboBoxFocusRect, &optComboBox, comboBox);
-          optFocus.radiuses = isTabCellEditor ? 0. : _impl->theme.borderRadius;
+          optFocus.radiuses = isTabCellEditor ? 0. : _impl->theme->borderRadius;
         } else if (const auto* abstractItemListWidget = qobject_cast<const AbstractItemListWidget*>(monitoredWidget)) {
           abstractItemListWidget->initStyleOptionFocus(optFocus);
         } else {
@@ -2128,7 +2442,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
                                               .marginsAdded(QMargins(borderW, borderW, borderW, borderW))
                                           : QRect();
 
-          optFocus.radiuses = customRadius >= 0 ? customRadius : RadiusesF(_impl->theme.borderRadius);
+          optFocus.radiuses = customRadius >= 0 ? customRadius : RadiusesF(_impl->theme->borderRadius);
         }
 
         // Draw the focus border.
@@ -2143,11 +2457,11 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
         const auto& totalRect = optComboBox->rect;
         // Draw text and icon.
         const auto mouse = getMouseState(optComboBox->state);
-        const auto& fgColor = comboBoxForegroundColor(mouse);
+        const auto& fgColor = _impl->comboBoxForegroundColor(mouse);
         const auto& currentFgColor =
-          _impl->animations.animateForegroundColor(w, fgColor, _impl->theme.animationDuration);
-        const auto indicatorSize = _impl->theme.iconSize;
-        const auto spacing = _impl->theme.spacing;
+          _impl->animations.animateForegroundColor(w, fgColor, _impl->theme->animationDuration);
+        const auto indicatorSize = _impl->theme->iconSize;
+        const auto spacing = _impl->theme->spacing;
         const auto contentLeftPadding = spacing;
         const auto contentRightPadding = 2 * spacing + indicatorSize.width();
         const auto contentRect = totalRect.marginsRemoved({ contentLeftPadding, 0, contentRightPadding, 0 });
@@ -2220,15 +2534,15 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
         // Foreground.
         const auto& features = optItem->features;
-        const auto isList = qobject_cast<const QListView*>(w) != nullptr;
-        const auto spacing = _impl->theme.spacing;
-        const auto hPadding = isList ? spacing : spacing / 2;
+        const auto viewContext = _impl->itemViewPaintContext(w, p);
+        const auto spacing = _impl->theme->spacing;
+        const auto hPadding = viewContext.isList ? spacing : spacing / 2;
         const auto hasIcon = features.testFlag(QStyleOptionViewItem::HasDecoration) && !optItem->icon.isNull();
         const auto& iconSize = hasIcon ? optItem->decorationSize : QSize{ 0, 0 };
         const auto fgRect = optItem->rect.marginsRemoved(QMargins{ hPadding, 0, hPadding, 0 });
         const auto selected = getSelectionState(optItem->state);
         const auto hasCheck = features.testFlag(QStyleOptionViewItem::HasCheckIndicator);
-        const auto checkBoxSize = _impl->theme.iconSize;
+        const auto checkBoxSize = _impl->theme->iconSize;
         const auto checkBoxSpace = hasCheck ? checkBoxSize.width() + spacing : 0;
         const auto isChecked = hasCheck && optItem->checkState == Qt::Checked;
         const auto checked = isChecked ? CheckState::Checked : CheckState::NotChecked;
@@ -2236,9 +2550,8 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
         // We show the selected color on the whole row, not only the cell.
         // Make it consistent with the background color in PE_PanelItemViewItem.
-        const auto widgetHasFocus = (w && w->hasFocus());
         const auto focus =
-          widgetHasFocus && selected == SelectionState::Selected ? FocusState::Focused : FocusState::NotFocused;
+          viewContext.hasFocus && selected == SelectionState::Selected ? FocusState::Focused : FocusState::NotFocused;
 
         // Checkbox, if any.
         if (hasCheck) {
@@ -2267,7 +2580,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
 
         // Actual content.
         const auto itemMouse = getMouseState(optItem->state);
-        const auto& fgColor = listItemForegroundColor(itemMouse, selected, focus, active);
+        const auto& fgColor = _impl->listItemForegroundColor(itemMouse, selected, focus, active);
         constexpr auto paletteColorRole = QPalette::ColorRole::Text;
         const auto paletteColorGroup = getPaletteColorGroup(optItem->state);
         const auto& textColor =
@@ -2304,7 +2617,9 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
             p->setOpacity(backupOpacity);
           } else {
             const auto& colorizedPixmap = getColorizedPixmap(pixmap, autoIconColor, fgColor, textColor);
-            auto iconRect = subElementRect(SE_ItemViewItemDecoration, optItem, w);
+            auto* contextCache = _impl->events.itemViewPaintContextCache(w);
+            auto iconRect = contextCache ? contextCache->decorationRect(this, optItem)
+                                         : subElementRect(SE_ItemViewItemDecoration, optItem, w);
             iconRect.moveLeft(pixmapRect.left());
             p->drawPixmap(iconRect, colorizedPixmap);
           }
@@ -2329,7 +2644,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
     case CE_ShapedFrame:
       if (const auto* frameOpt = qstyleoption_cast<const QStyleOptionFrame*>(opt)) {
         const auto frameShape = frameOpt->frameShape;
-        const auto lineW = _impl->theme.borderWidth;
+        const auto lineW = _impl->theme->borderWidth;
 
         switch (frameShape) {
           case QFrame::HLine:
@@ -2354,7 +2669,7 @@ void QlementineStyle::drawControl(ControlElement ce, const QStyleOption* opt, QP
               const auto& pen = QPen(borderColor, lineW, Qt::PenStyle::SolidLine, Qt::PenCapStyle::SquareCap);
               const auto bgRole = w->backgroundRole();
               if (bgRole != QPalette::NoRole && w->autoFillBackground()) {
-                const auto& palette = _impl->theme.palette;
+                const auto& palette = _impl->theme->palette;
                 const auto& bgColor = palette.color(QPalette::ColorGroup::Normal, bgRole);
                 p->setPen(pen);
                 p->setBrush(bgColor);
@@ -2387,7 +2702,7 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
     case SE_PushButtonBevel:
       return opt->rect;
     case SE_PushButtonFocusRect: {
-      const auto borderW = _impl->theme.focusBorderWidth;
+      const auto borderW = _impl->theme->focusBorderWidth;
       return opt->rect.translated(borderW * 2, borderW * 2).marginsAdded(QMargins(borderW, borderW, borderW, borderW));
     }
     case SE_RadioButtonIndicator:
@@ -2398,7 +2713,7 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
     }
     case SE_RadioButtonFocusRect:
     case SE_CheckBoxFocusRect: {
-      const auto borderW = _impl->theme.focusBorderWidth;
+      const auto borderW = _impl->theme->focusBorderWidth;
       const auto checkRect =
         subElementRect(SE_CheckBoxIndicator, opt, w).marginsAdded(QMargins(borderW, borderW, borderW, borderW));
       const auto deltaX = pixelMetric(PM_FocusFrameHMargin, opt, w);
@@ -2416,13 +2731,13 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
       // Make the whole widget clickable, not only the check/radio indicator.
       return opt->rect;
     case SE_ComboBoxFocusRect: {
-      const auto borderW = _impl->theme.focusBorderWidth;
+      const auto borderW = _impl->theme->focusBorderWidth;
       return opt->rect.translated(borderW * 2, borderW * 2).marginsAdded(QMargins(borderW, borderW, borderW, borderW));
     }
     case SE_SliderFocusRect:
       // Also used for Dial.
       if (const auto* optSlider = qstyleoption_cast<const QStyleOptionSlider*>(opt)) {
-        const auto* isDial = qobject_cast<const QDial*>(w);
+        const auto isDial = _impl->widgetTraits.traits(w).testFlag(WidgetTrait::Dial);
         const auto complexControl = isDial ? CC_Dial : CC_Slider;
         const auto subControl = isDial ? SC_DialHandle : SC_SliderHandle;
         const auto handleRect = subControlRect(complexControl, optSlider, subControl, w);
@@ -2441,9 +2756,9 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
                                          .boundingRect(optProgressBar->rect, Qt::AlignRight, QStringLiteral("100%"))
                                          .width()
                                      : 0;
-        const auto spacing = showText ? _impl->theme.spacing : 0;
+        const auto spacing = showText ? _impl->theme->spacing : 0;
         const auto barW = opt->rect.width() - labelW - spacing;
-        const auto barH = _impl->theme.progressBarGrooveHeight;
+        const auto barH = _impl->theme->progressBarGrooveHeight;
         const auto barY = opt->rect.y() + (opt->rect.height() - barH) / 2;
         return QRect{ opt->rect.x(), barY, barW, barH };
       }
@@ -2499,7 +2814,7 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
     case SE_LineEditContents:
       if (const auto* optFrame = qstyleoption_cast<const QStyleOptionFrame*>(opt)) {
         const auto borderW = optFrame->lineWidth;
-        const auto hMargin = _impl->theme.spacing / 2;
+        const auto hMargin = _impl->theme->spacing / 2;
         const auto rect = optFrame->rect.adjusted(borderW + hMargin, borderW, -borderW - hMargin, -borderW);
         //r = visualRect(opt->direction, opt->rect, r);
         return rect;
@@ -2546,7 +2861,7 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
     // TabBar
     case SE_TabBarTearIndicatorLeft: {
       const auto& rect = opt->rect;
-      const auto shadowW = _impl->theme.spacing * 3;
+      const auto shadowW = _impl->theme->spacing * 3;
       const auto x = rect.x();
       const auto y = rect.y();
       const auto width = shadowW;
@@ -2555,8 +2870,8 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
     }
     case SE_TabBarTearIndicatorRight: {
       const auto& rect = opt->rect;
-      const auto scrollButtonsW = _impl->theme.controlHeightMedium * 2 + _impl->theme.spacing * 3;
-      const auto shadowW = _impl->theme.spacing * 3;
+      const auto scrollButtonsW = _impl->theme->controlHeightMedium * 2 + _impl->theme->spacing * 3;
+      const auto shadowW = _impl->theme->spacing * 3;
       const auto x = rect.x() + rect.width() - shadowW - scrollButtonsW;
       const auto y = rect.y();
       const auto width = shadowW + scrollButtonsW;
@@ -2568,8 +2883,8 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
       if (const auto* optTab = qstyleoption_cast<const QStyleOptionTab*>(opt)) {
         const auto& rect = optTab->rect;
         const auto buttonSize = optTab->leftButtonSize;
-        const auto paddingTop = _impl->theme.tabBarPaddingTop;
-        const auto spacing = _impl->theme.spacing;
+        const auto paddingTop = _impl->theme->tabBarPaddingTop;
+        const auto spacing = _impl->theme->spacing;
         const auto padding = _impl->tabExtraPadding(optTab, w);
         const auto x = rect.x() + spacing + padding.left();
         const auto y = rect.y() + paddingTop + (rect.height() - paddingTop - buttonSize.height()) / 2;
@@ -2581,8 +2896,8 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
       if (const auto* optTab = qstyleoption_cast<const QStyleOptionTab*>(opt)) {
         const auto& rect = optTab->rect;
         const auto buttonSize = optTab->rightButtonSize;
-        const auto spacing = _impl->theme.spacing;
-        const auto paddingTop = _impl->theme.tabBarPaddingTop;
+        const auto spacing = _impl->theme->spacing;
+        const auto paddingTop = _impl->theme->tabBarPaddingTop;
         const auto padding = _impl->tabExtraPadding(optTab, w);
         const auto x = rect.x() + rect.width() - spacing - buttonSize.width() - padding.right();
         const auto y = rect.y() + paddingTop + (rect.height() - paddingTop - buttonSize.height()) / 2;
@@ -2592,33 +2907,33 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
     case SE_TabBarTabText:
       if (const auto* optTab = qstyleoption_cast<const QStyleOptionTab*>(opt)) {
         const auto& rect = optTab->rect;
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto leftButtonWidth = optTab->leftButtonSize.width();
         const auto rightButtonWidth = optTab->rightButtonSize.width();
         const auto leftButtonW = leftButtonWidth > 0 ? leftButtonWidth + spacing : 0;
         const auto rightButtonW = rightButtonWidth > 0 ? rightButtonWidth + spacing : 0;
         const auto padding = _impl->tabExtraPadding(optTab, w);
         const auto x = rect.x() + padding.left() + spacing + leftButtonW;
-        const auto y = rect.y() + _impl->theme.tabBarPaddingTop;
+        const auto y = rect.y() + _impl->theme->tabBarPaddingTop;
         const auto width = rect.width() - leftButtonW - padding.left() - rightButtonW - padding.right() - spacing * 2;
-        const auto height = rect.height() - _impl->theme.tabBarPaddingTop;
+        const auto height = rect.height() - _impl->theme->tabBarPaddingTop;
         return { x, y, width, height };
       }
       return {};
     case SE_TabBarScrollLeftButton: {
       const auto& rect = opt->rect;
-      const auto spacing = _impl->theme.spacing;
-      const auto width = _impl->theme.controlHeightMedium + static_cast<int>(spacing * 1.5);
-      const auto height = _impl->theme.controlHeightLarge + spacing;
+      const auto spacing = _impl->theme->spacing;
+      const auto width = _impl->theme->controlHeightMedium + static_cast<int>(spacing * 1.5);
+      const auto height = _impl->theme->controlHeightLarge + spacing;
       const auto x = rect.x() + rect.width() - 2 * width;
       const auto y = rect.y();
       return { x, y, width, height };
     }
     case SE_TabBarScrollRightButton: {
       const auto& rect = opt->rect;
-      const auto spacing = _impl->theme.spacing;
-      const auto width = _impl->theme.controlHeightMedium + static_cast<int>(spacing * 1.5);
-      const auto height = _impl->theme.controlHeightLarge + spacing;
+      const auto spacing = _impl->theme->spacing;
+      const auto width = _impl->theme->controlHeightMedium + static_cast<int>(spacing * 1.5);
+      const auto height = _impl->theme->controlHeightLarge + spacing;
       const auto x = rect.x() + rect.width() - width + spacing / 2;
       const auto y = rect.y();
       return { x, y, width, height };
@@ -2636,42 +2951,38 @@ QRect QlementineStyle::subElementRect(SubElement se, const QStyleOption* opt, co
 
 void QlementineStyle::drawComplexControl(
   ComplexControl cc, const QStyleOptionComplex* opt, QPainter* p, const QWidget* w) const {
+  const NinePatchRoundedRectsScope ninePatchScope(_impl->ninePatchRoundedRects);
   switch (cc) {
     case CC_SpinBox:
       if (const auto* spinboxOpt = qstyleoption_cast<const QStyleOptionSpinBox*>(opt)) {
-        const auto* parentWidget = w ? w->parentWidget() : nullptr;
-        const auto isTabCellEditor =
-          parentWidget && qobject_cast<const QAbstractItemView*>(parentWidget->parentWidget());
+        const auto isTabCellEditor = _impl->widgetTraits.traits(w).testFlag(WidgetTrait::GrandParentIsItemView);
 
         p->setRenderHint(QPainter::Antialiasing, true);
         const auto spinBoxEnabled = spinboxOpt->state.testFlag(State_Enabled);
         if (spinboxOpt->buttonSymbols != QAbstractSpinBox::NoButtons) {
-          const auto radius = static_cast<double>(_impl->theme.borderRadius);
+          const auto radius = static_cast<double>(_impl->theme->borderRadius);
           const auto upButtonRect = subControlRect(cc, opt, SC_SpinBoxUp, w);
           if (upButtonRect.isValid()) {
             const auto upButtonActive = spinboxOpt->activeSubControls.testFlag(SC_SpinBoxUp);
-            const auto upButtonPath = getMultipleRadiusesRectPath(
-              upButtonRect, isTabCellEditor ? RadiusesF{ 0. } : RadiusesF{ 0., radius, 0., 0. });
+            const auto upButtonRadiuses = isTabCellEditor ? RadiusesF{ 0. } : RadiusesF{ 0., radius, 0., 0. };
             const auto upButtonEnabled =
               spinBoxEnabled && spinboxOpt->stepEnabled.testFlag(QAbstractSpinBox::StepUpEnabled);
             const auto upButtonHovered = upButtonActive;
             const auto upButtonPressed = upButtonActive && spinboxOpt->state.testFlag(State_Sunken);
             const auto upMouse = getMouseState(upButtonPressed, upButtonHovered, upButtonEnabled);
-            const auto& upButtonBgColor = spinBoxButtonBackgroundColor(upMouse);
+            const auto& upButtonBgColor = _impl->spinBoxButtonBackgroundColor(upMouse);
             const auto& currentColor =
-              _impl->animations.animateBackgroundColor(w, upButtonBgColor, _impl->theme.animationDuration);
+              _impl->animations.animateBackgroundColor(w, upButtonBgColor, _impl->theme->animationDuration);
 
             // Draw background.
-            p->setPen(Qt::NoPen);
-            p->setBrush(currentColor);
-            p->drawPath(upButtonPath);
+            drawRoundedRect(p, upButtonRect, currentColor, upButtonRadiuses);
 
             // Draw icon.
-            const auto& fgColor = spinBoxButtonForegroundColor(upMouse);
+            const auto& fgColor = _impl->spinBoxButtonForegroundColor(upMouse);
             const auto& currentFgColor =
-              _impl->animations.animateForegroundColor(w, fgColor, _impl->theme.animationDuration);
-            const auto iconSize = _impl->theme.iconSize / 2;
-            const auto translateY = _impl->theme.borderWidth;
+              _impl->animations.animateForegroundColor(w, fgColor, _impl->theme->animationDuration);
+            const auto iconSize = _impl->theme->iconSize / 2;
+            const auto translateY = _impl->theme->borderWidth;
             p->setPen(QPen(currentFgColor, iconPenWidth, Qt::SolidLine, Qt::FlatCap));
             p->setBrush(Qt::NoBrush);
             drawSpinBoxArrowIndicator(
@@ -2681,26 +2992,24 @@ void QlementineStyle::drawComplexControl(
           const auto downButtonRect = subControlRect(cc, opt, SC_SpinBoxDown, w);
           if (downButtonRect.isValid()) {
             const auto downButtonActive = spinboxOpt->activeSubControls.testFlag(SC_SpinBoxDown);
-            const auto downButtonPath = getMultipleRadiusesRectPath(downButtonRect, RadiusesF{ 0., 0., radius, 0. });
+            const auto downButtonRadiuses = RadiusesF{ 0., 0., radius, 0. };
             const auto downButtonEnabled =
               spinBoxEnabled && spinboxOpt->stepEnabled.testFlag(QAbstractSpinBox::StepDownEnabled);
             const auto downButtonHovered = downButtonActive;
             const auto downButtonPressed = downButtonActive && spinboxOpt->state.testFlag(State_Sunken);
             const auto downMouse = getMouseState(downButtonPressed, downButtonHovered, downButtonEnabled);
-            const auto& downButtonBgColor = spinBoxButtonBackgroundColor(downMouse);
+            const auto& downButtonBgColor = _impl->spinBoxButtonBackgroundColor(downMouse);
             const auto& currentColor =
-              _impl->animations.animateBackgroundColor2(w, downButtonBgColor, _impl->theme.animationDuration);
+              _impl->animations.animateBackgroundColor2(w, downButtonBgColor, _impl->theme->animationDuration);
 
             // Draw background.
-            p->setPen(Qt::NoPen);
-            p->setBrush(currentColor);
-            p->drawPath(downButtonPath);
+            drawRoundedRect(p, downButtonRect, currentColor, downButtonRadiuses);
 
             // Draw icon.
-            const auto& fgColor = spinBoxButtonForegroundColor(downMouse);
+            const auto& fgColor = _impl->spinBoxButtonForegroundColor(downMouse);
             const auto& currentFgColor =
-              _impl->animations.animateForegroundColor2(w, fgColor, _impl->theme.animationDuration);
-            const auto iconSize = _impl->theme.iconSize / 2;
+              _impl->animations.animateForegroundColor2(w, fgColor, _impl->theme->animationDuration);
+            const auto iconSize = _impl->theme->iconSize / 2;
             p->setPen(QPen(currentFgColor, iconPenWidth, Qt::SolidLine, Qt::FlatCap));
             p->setBrush(Qt::NoBrush);
             drawSpinBoxArrowIndicator(downButtonRect, p, spinboxOpt->buttonSymbols, SC_SpinBoxDown, iconSize);
@@ -2722,7 +3031,7 @@ void QlementineStyle::drawComplexControl(
           buttonOpt.state = comboBoxOpt->state;
           buttonOpt.state.setFlag(QStyle::StateFlag::State_On, false);
           buttonOpt.features.setFlag(QStyleOptionButton::Flat, !comboBoxOpt->frame);
-          buttonOpt.radiuses = RadiusesF{ 0., _impl->theme.borderRadius };
+          buttonOpt.radiuses = RadiusesF{ 0., _impl->theme->borderRadius };
           drawControl(CE_PushButtonBevel, &buttonOpt, p, w);
 
           // NB: CE_ComboBoxLabel won't be called for an editable QComboBox,
@@ -2731,16 +3040,16 @@ void QlementineStyle::drawComplexControl(
           // Non-editable ComboBox foreground drawing is done in CE_ComboBoxLabel.
           {
             const auto mouse = getMouseState(comboBoxOpt->state);
-            const auto& fgColor = comboBoxForegroundColor(mouse);
+            const auto& fgColor = _impl->comboBoxForegroundColor(mouse);
             const auto& currentFgColor =
-              _impl->animations.animateForegroundColor(w, fgColor, _impl->theme.animationDuration);
+              _impl->animations.animateForegroundColor(w, fgColor, _impl->theme->animationDuration);
 
-            const auto indicatorSize = _impl->theme.iconSize;
+            const auto indicatorSize = _impl->theme->iconSize;
             const auto indicatorX = arrowButtonRect.x() + (arrowButtonRect.width() - indicatorSize.width()) / 2;
             const auto indicatorY = arrowButtonRect.y() + (arrowButtonRect.height() - indicatorSize.height()) / 2;
             const auto indicatorRect = QRect{ QPoint{ indicatorX, indicatorY }, indicatorSize };
 
-            if (qobject_cast<const QDateTimeEdit*>(w)) {
+            if (_impl->widgetTraits.traits(w).testFlag(WidgetTrait::DateTimeEdit)) {
               const auto pixelRatio = getPixelRatio(w);
               const auto& icon = _impl->getStandardIconExt(StandardPixmapExt::SP_Calendar, indicatorSize * pixelRatio);
               drawIcon(indicatorRect, p, icon, mouse, CheckState::Checked, w, true, currentFgColor);
@@ -2751,9 +3060,7 @@ void QlementineStyle::drawComplexControl(
             }
           }
         } else {
-          const auto* parentWidget = w ? w->parentWidget() : nullptr;
-          const auto isTabCellEditor =
-            parentWidget && qobject_cast<const QAbstractItemView*>(parentWidget->parentWidget());
+          const auto isTabCellEditor = _impl->widgetTraits.traits(w).testFlag(WidgetTrait::GrandParentIsItemView);
 
           // ComboBox background and border (same as a Button).
           QStyleOptionRoundedButton buttonOpt;
@@ -2763,7 +3070,7 @@ void QlementineStyle::drawComplexControl(
           buttonOpt.state = comboBoxOpt->state;
           buttonOpt.state.setFlag(QStyle::StateFlag::State_On, false);
           buttonOpt.features.setFlag(QStyleOptionButton::Flat, !comboBoxOpt->frame);
-          buttonOpt.radiuses = RadiusesF{ isTabCellEditor ? 0. : _impl->theme.borderRadius };
+          buttonOpt.radiuses = RadiusesF{ isTabCellEditor ? 0. : _impl->theme->borderRadius };
           drawControl(CE_PushButtonBevel, &buttonOpt, p, w);
         }
       }
@@ -2776,8 +3083,8 @@ void QlementineStyle::drawComplexControl(
         const auto horizontal = scrollBarOpt->orientation == Qt::Horizontal;
         const auto thickness = getScrollBarThickness(mouse);
         const auto currentThickness =
-          _impl->animations.animateProgress(w, thickness, _impl->theme.animationDuration * 2);
-        const auto scrollBarMargin = _impl->theme.scrollBarMargin;
+          _impl->animations.animateProgress(w, thickness, _impl->theme->animationDuration * 2);
+        const auto scrollBarMargin = _impl->theme->scrollBarMargin;
 
         // Groove.
         const auto grooveRect = subControlRect(CC_ScrollBar, scrollBarOpt, SC_ScrollBarGroove, w);
@@ -2787,9 +3094,9 @@ void QlementineStyle::drawComplexControl(
                      : QRectF(grooveRect.x() + grooveRect.width() - currentThickness, grooveRect.y(), currentThickness,
                          grooveRect.height());
 
-        const auto& grooveColor = scrollBarGrooveColor(mouse);
+        const auto& grooveColor = _impl->scrollBarGrooveColor(mouse);
         const auto& currentGrooveColor =
-          _impl->animations.animateBackgroundColor(w, grooveColor, _impl->theme.animationDuration * 2);
+          _impl->animations.animateBackgroundColor(w, grooveColor, _impl->theme->animationDuration * 2);
         const auto grooveRadius = scrollBarMargin <= 0 ? 0.
                                   : horizontal         ? currentGrooveRect.height() / 2.
                                                        : currentGrooveRect.width() / 2.;
@@ -2807,9 +3114,9 @@ void QlementineStyle::drawComplexControl(
                        : QRectF(handleRect.x() + handleRect.width() - currentThickness, handleRect.y(),
                            currentThickness, handleRect.height());
           const auto handleMouse = getScrollBarHandleState(scrollBarOpt->state, scrollBarOpt->activeSubControls);
-          const auto& handleColor = scrollBarHandleColor(handleMouse);
+          const auto& handleColor = _impl->scrollBarHandleColor(handleMouse);
           const auto& currentHandleColor =
-            _impl->animations.animateBackgroundColor2(w, handleColor, _impl->theme.animationDuration);
+            _impl->animations.animateBackgroundColor2(w, handleColor, _impl->theme->animationDuration);
           const auto handleRadius = horizontal ? currentHandleRect.height() / 2. : currentHandleRect.width() / 2.;
           p->setBrush(currentHandleColor);
           p->drawRoundedRect(currentHandleRect, handleRadius, handleRadius);
@@ -2823,7 +3130,7 @@ void QlementineStyle::drawComplexControl(
         // the mouse cursor with a quick interpolation (otherwise, it snaps and don't animate).
         const auto handleActive =
           sliderOpt->state.testFlag(State_Sunken) && sliderOpt->activeSubControls == SubControl::SC_SliderHandle;
-        const auto duration = handleActive ? _impl->theme.sliderAnimationDuration : _impl->theme.animationDuration;
+        const auto duration = handleActive ? _impl->theme->sliderAnimationDuration : _impl->theme->animationDuration;
         const auto currentProgress = _impl->animations.animateProgress(w, progress, duration);
         QStyleOptionSliderF currentSliderOpt;
         currentSliderOpt.QStyleOptionSlider::operator=(*sliderOpt);
@@ -2840,8 +3147,8 @@ void QlementineStyle::drawComplexControl(
         // Draw tickmarks.
         if (sliderOpt->subControls.testFlag(SC_SliderTickmarks) && sliderOpt->tickPosition != QSlider::NoTicks) {
           const auto tickmarksRect = subControlRect(CC_Slider, opt, SC_SliderTickmarks, w);
-          const auto tickThickness = _impl->theme.sliderTickThickness;
-          const auto& tickColor = sliderTickColor(mouse);
+          const auto tickThickness = _impl->theme->sliderTickThickness;
+          const auto& tickColor = _impl->sliderTickColor(mouse);
 
           // Little trick to avoid having two colors with alpha<255 above one another.
           if (disabled) {
@@ -2863,8 +3170,8 @@ void QlementineStyle::drawComplexControl(
         const auto grooveRect = subControlRect(CC_Slider, opt, SC_SliderGroove, w);
 
         if (sliderOpt->subControls.testFlag(SC_SliderGroove) && grooveRect.isValid()) {
-          const auto& grooveColor = sliderGrooveColor(mouse);
-          const auto& valueColor = sliderValueColor(mouse);
+          const auto& grooveColor = _impl->sliderGrooveColor(mouse);
+          const auto& valueColor = _impl->sliderValueColor(mouse);
           const auto radius = grooveRect.height() / 2.;
 
           // Little trick to avoid having two colors with alpha<255 above one another.
@@ -2886,9 +3193,9 @@ void QlementineStyle::drawComplexControl(
         if (sliderOpt->subControls.testFlag(SC_SliderHandle) && handleRect.isValid()) {
           static QPixmap dropShadowPixmap;
           const auto handleMouse = sliderOpt->activeSubControls == QStyle::SC_SliderHandle ? widgetMouse : mouse;
-          const auto& handleBgColor = sliderHandleColor(handleMouse);
+          const auto& handleBgColor = _impl->sliderHandleColor(handleMouse);
           const auto& currentHandleBgColor =
-            _impl->animations.animateForegroundColor(w, handleBgColor, _impl->theme.animationDuration);
+            _impl->animations.animateForegroundColor(w, handleBgColor, _impl->theme->animationDuration);
 
           p->setRenderHint(QPainter::Antialiasing, true);
 
@@ -2905,7 +3212,7 @@ void QlementineStyle::drawComplexControl(
             }
             constexpr auto dropShadowBlurRadius = 2.;
             dropShadowPixmap =
-              qlementine::getDropShadowPixmap(inputPixmap, dropShadowBlurRadius, _impl->theme.shadowColor3);
+              qlementine::getDropShadowPixmap(inputPixmap, dropShadowBlurRadius, _impl->theme->shadowColor3);
           }
 
           // Draw drop shadow centered below handle.
@@ -2934,9 +3241,9 @@ void QlementineStyle::drawComplexControl(
 
         const auto isMouseOver = toolbuttonOpt->state.testFlag(State_MouseOver);
         const auto isPressed = toolbuttonOpt->state.testFlag(State_Sunken);
-        const auto* parentTabBar = qobject_cast<QTabBar*>(w->parentWidget());
-        const auto isTabBarScrollButton = parentTabBar != nullptr && toolbuttonOpt->arrowType != Qt::NoArrow;
-        const auto radius = _impl->theme.borderRadius;
+        const auto isTabBarScrollButton = _impl->widgetTraits.traits(w).testFlag(WidgetTrait::ParentIsTabBar)
+                                          && toolbuttonOpt->arrowType != Qt::NoArrow;
+        const auto radius = _impl->theme->borderRadius;
         const auto buttonActive = toolbuttonOpt->activeSubControls.testFlag(SC_ToolButton);
         const auto menuButtonActive =
           menuIsOnSeparateButton && toolbuttonOpt->activeSubControls.testFlag(SC_ToolButtonMenu);
@@ -2966,16 +3273,16 @@ void QlementineStyle::drawComplexControl(
             const auto isLeftButton = toolbuttonOpt->arrowType == Qt::ArrowType::LeftArrow;
             const auto tabBarState = parentTabBar->isEnabled() ? MouseState::Normal : MouseState::Disabled;
             if (parentTabBar->documentMode() || isLeftButton) {
-              p->fillRect(toolbuttonOpt->rect, tabBarBackgroundColor(tabBarState));
+              p->fillRect(toolbuttonOpt->rect, _impl->tabBarBackgroundColor(tabBarState));
             } else {
-              const auto bgRadius = _impl->theme.borderRadius * 1.5;
+              const auto bgRadius = _impl->theme->borderRadius * 1.5;
               drawRoundedRect(
-                p, toolbuttonOpt->rect, tabBarBackgroundColor(tabBarState), RadiusesF(0., bgRadius, 0., 0.));
+                p, toolbuttonOpt->rect, _impl->tabBarBackgroundColor(tabBarState), RadiusesF(0., bgRadius, 0., 0.));
             }
 
             // Rect.
-            const auto spacing = _impl->theme.spacing;
-            const auto buttonSize = QSize{ _impl->theme.controlHeightMedium, _impl->theme.controlHeightMedium };
+            const auto spacing = _impl->theme->spacing;
+            const auto buttonSize = QSize{ _impl->theme->controlHeightMedium, _impl->theme->controlHeightMedium };
             const auto buttonX = isLeftButton ? buttonRect.x() + buttonRect.width() - buttonSize.width() - spacing / 2
                                               : buttonRect.x() + spacing / 2;
             const auto buttonY = buttonRect.y() + (buttonRect.height() - buttonSize.height()) / 2;
@@ -3010,16 +3317,16 @@ void QlementineStyle::drawComplexControl(
           // Background.
           const auto menuButtonMouse = getToolButtonMouseState(menuButtonState);
           const auto role = getColorRole(toolbuttonOpt->state, false);
-          const auto& bgColor = toolButtonBackgroundColor(menuButtonMouse, role);
+          const auto& bgColor = _impl->toolButtonBackgroundColor(menuButtonMouse, role);
           const auto& currentColor =
-            _impl->animations.animateBackgroundColor2(w, bgColor, _impl->theme.animationDuration);
+            _impl->animations.animateBackgroundColor2(w, bgColor, _impl->theme->animationDuration);
           drawRoundedRect(p, menuButtonRect, currentColor, menuButtonRadiuses);
 
           // Line.
-          const auto lineW = _impl->theme.borderWidth;
-          const auto& lineColor = toolButtonSeparatorColor(mouse, role);
+          const auto lineW = _impl->theme->borderWidth;
+          const auto& lineColor = _impl->toolButtonSeparatorColor(mouse, role);
           const auto lineX = buttonRect.x() + buttonRect.width() - lineW / 2.;
-          const auto lineMargin = 0; //_impl->theme.spacing / 2.;
+          const auto lineMargin = 0; //_impl->theme->spacing / 2.;
           const auto lineY1 = static_cast<double>(buttonRect.y() + lineMargin);
           const auto lineY2 = static_cast<double>(buttonRect.y() + buttonRect.height() - lineMargin);
           const auto lineP1 = QPointF{ lineX, lineY1 };
@@ -3029,29 +3336,27 @@ void QlementineStyle::drawComplexControl(
           p->drawLine(lineP1, lineP2);
 
           // Arrow.
-          const auto& arrowSize = _impl->theme.iconSize;
+          const auto& arrowSize = _impl->theme->iconSize;
           const auto arrowX = menuButtonRect.x() + (menuButtonRect.width() - arrowSize.width()) / 2;
           const auto arrowY = menuButtonRect.y() + (menuButtonRect.height() - arrowSize.height()) / 2;
           const auto arrowRect = QRect{ arrowX, arrowY, arrowSize.width(), arrowSize.height() };
-          const auto& arrowColor = toolButtonForegroundColor(menuButtonMouse, role);
+          const auto& arrowColor = _impl->toolButtonForegroundColor(menuButtonMouse, role);
           const auto& currentArrowColor =
-            _impl->animations.animateForegroundColor2(w, arrowColor, _impl->theme.animationDuration);
-          const auto path = getMenuIndicatorPath(arrowRect);
+            _impl->animations.animateForegroundColor2(w, arrowColor, _impl->theme->animationDuration);
           p->setPen(QPen(currentArrowColor, iconPenWidth, Qt::SolidLine, Qt::RoundCap));
-          p->drawPath(path);
+          drawMenuIndicator(arrowRect, p);
         } else if (hasMenu) {
           // Arrow.
-          const auto spacing = _impl->theme.spacing;
-          const auto& arrowSize = _impl->theme.iconSize;
+          const auto spacing = _impl->theme->spacing;
+          const auto& arrowSize = _impl->theme->iconSize;
           const auto arrowX = menuButtonRect.x() + (menuButtonRect.width() - arrowSize.width()) / 2 - spacing;
           const auto arrowY = menuButtonRect.y() + (menuButtonRect.height() - arrowSize.height()) / 2;
           const auto arrowRect = QRect{ arrowX, arrowY, arrowSize.width(), arrowSize.height() };
-          const auto& arrowColor = toolButtonForegroundColor(mouse, getColorRole(toolbuttonOpt->state, false));
+          const auto& arrowColor = _impl->toolButtonForegroundColor(mouse, getColorRole(toolbuttonOpt->state, false));
           const auto& currentArrowColor =
-            _impl->animations.animateForegroundColor(w, arrowColor, _impl->theme.animationDuration);
-          const auto path = getMenuIndicatorPath(arrowRect);
+            _impl->animations.animateForegroundColor(w, arrowColor, _impl->theme->animationDuration);
           p->setPen(QPen(currentArrowColor, iconPenWidth, Qt::SolidLine, Qt::RoundCap));
-          p->drawPath(path);
+          drawMenuIndicator(arrowRect, p);
         }
       }
       return;
@@ -3066,9 +3371,9 @@ void QlementineStyle::drawComplexControl(
         // Draw tickmarks.
         if (dialOpt->subControls.testFlag(SC_DialTickmarks)) {
           const auto tickmarksRect = subControlRect(cc, opt, SC_DialTickmarks, w);
-          const auto tickThickness = _impl->theme.dialMarkThickness;
-          const auto& tickColor = dialTickColor(mouse);
-          const auto tickLength = _impl->theme.dialTickLength;
+          const auto tickThickness = _impl->theme->dialMarkThickness;
+          const auto& tickColor = _impl->dialTickColor(mouse);
+          const auto tickLength = _impl->theme->dialTickLength;
           const auto minArcLength = dialOpt->notchTarget * 2;
           drawDialTickMarks(p, tickmarksRect, tickColor, min, max, tickThickness, tickLength, dialOpt->singleStep,
             dialOpt->pageStep, int(minArcLength));
@@ -3079,7 +3384,7 @@ void QlementineStyle::drawComplexControl(
         // the mouse cursor with a quick interpolation (otherwise, it snaps and don't animate).
         const auto handleActive =
           dialOpt->state.testFlag(State_Sunken) && dialOpt->activeSubControls == SubControl::SC_DialHandle;
-        const auto duration = handleActive ? _impl->theme.sliderAnimationDuration : _impl->theme.animationDuration;
+        const auto duration = handleActive ? _impl->theme->sliderAnimationDuration : _impl->theme->animationDuration;
         const auto currentProgress = _impl->animations.animateProgress(w, progress, duration);
         QStyleOptionSliderF currentSliderOpt;
         currentSliderOpt.QStyleOptionSlider::operator=(*dialOpt);
@@ -3088,17 +3393,17 @@ void QlementineStyle::drawComplexControl(
 
         // Dial shape.
         const auto dialRect = subControlRect(cc, opt, SC_DialGroove, w);
-        const auto& bgColor = dialBackgroundColor(mouse);
-        const auto& handleColor = dialHandleColor(mouse);
-        const auto& grooveColor = dialGrooveColor(mouse);
-        const auto& valueColor = dialValueColor(mouse);
-        const auto& markColor = dialMarkColor(mouse);
+        const auto& bgColor = _impl->dialBackgroundColor(mouse);
+        const auto& handleColor = _impl->dialHandleColor(mouse);
+        const auto& grooveColor = _impl->dialGrooveColor(mouse);
+        const auto& valueColor = _impl->dialValueColor(mouse);
+        const auto& markColor = _impl->dialMarkColor(mouse);
         const auto& currentHandleColor =
-          _impl->animations.animateBackgroundColor(w, handleColor, _impl->theme.animationDuration);
+          _impl->animations.animateBackgroundColor(w, handleColor, _impl->theme->animationDuration);
 
         drawDial(p, dialRect, dialOpt->minimum, dialOpt->maximum, currentProgress, bgColor, currentHandleColor,
-          grooveColor, valueColor, markColor, _impl->theme.dialGrooveThickness, _impl->theme.dialMarkLength,
-          _impl->theme.dialMarkThickness);
+          grooveColor, valueColor, markColor, _impl->theme->dialGrooveThickness, _impl->theme->dialMarkLength,
+          _impl->theme->dialMarkThickness);
       }
       return;
     case CC_GroupBox:
@@ -3115,8 +3420,8 @@ void QlementineStyle::drawComplexControl(
         // Title
         if (groupBoxOpt->subControls.testFlag(SC_GroupBoxLabel)) {
           const auto textRect = subControlRect(CC_GroupBox, opt, SC_GroupBoxLabel, w);
-          const auto& font = _impl->theme.fontH5;
-          const auto fm = QFontMetrics(font);
+          const auto& font = _impl->theme->fontH5;
+          const auto& fm = _impl->fontMetrics(FontMetricsCache::Font::H5, w);
           const auto elidedText =
             fm.elidedText(groupBoxOpt->text, Qt::ElideRight, textRect.width(), Qt::TextSingleLine);
           const auto mouse = getMouseState(groupBoxOpt->state);
@@ -3340,7 +3645,7 @@ QRect QlementineStyle::subControlRect(
           case SC_SpinBoxUp:
             if (spinboxOpt->buttonSymbols != QAbstractSpinBox::NoButtons) {
               const auto iconDimension = pixelMetric(PM_ButtonIconSize);
-              const auto buttonW = iconDimension + 2 * _impl->theme.borderWidth;
+              const auto buttonW = iconDimension + 2 * _impl->theme->borderWidth;
               const auto& totalRect = spinboxOpt->rect;
               const auto buttonH = totalRect.height() / 2;
               const auto buttonX = totalRect.right() - buttonW;
@@ -3353,7 +3658,7 @@ QRect QlementineStyle::subControlRect(
           case SC_SpinBoxDown:
             if (spinboxOpt->buttonSymbols != QAbstractSpinBox::NoButtons) {
               const auto iconDimension = pixelMetric(PM_ButtonIconSize);
-              const auto buttonW = iconDimension + 2 * _impl->theme.borderWidth;
+              const auto buttonW = iconDimension + 2 * _impl->theme->borderWidth;
               const auto& totalRect = spinboxOpt->rect;
               const auto buttonH = totalRect.height() / 2;
               const auto buttonX = totalRect.right() - buttonW;
@@ -3366,7 +3671,7 @@ QRect QlementineStyle::subControlRect(
           case SC_SpinBoxEditField:
             if (spinboxOpt->buttonSymbols != QAbstractSpinBox::NoButtons) {
               const auto iconDimension = pixelMetric(PM_ButtonIconSize);
-              const auto buttonW = iconDimension + 2 * _impl->theme.borderWidth + 1;
+              const auto buttonW = iconDimension + 2 * _impl->theme->borderWidth + 1;
               const auto& totalRect = spinboxOpt->rect;
               return QRect{ totalRect.x(), totalRect.y(), totalRect.width() - buttonW, totalRect.height() };
             } else {
@@ -3387,8 +3692,8 @@ QRect QlementineStyle::subControlRect(
           case SC_ComboBoxArrow: {
             // Not only the rect for the arrow icon, but the rect for the whole clickable zone,
             // in which the arrow will be drawn at the center.
-            const auto indicatorSize = _impl->theme.iconSize;
-            const auto hPadding = _impl->theme.spacing;
+            const auto indicatorSize = _impl->theme->iconSize;
+            const auto hPadding = _impl->theme->spacing;
             const auto buttonW = indicatorSize.width() + hPadding * 2;
             const auto buttonH = comboBoxOpt->rect.height();
             const auto buttonX = comboBoxOpt->rect.x() + comboBoxOpt->rect.width() - buttonW;
@@ -3398,8 +3703,8 @@ QRect QlementineStyle::subControlRect(
           case SC_ComboBoxEditField: {
             if (comboBoxOpt->editable) {
               const auto hasIcon = !comboBoxOpt->currentIcon.isNull();
-              const auto indicatorSize = _impl->theme.iconSize;
-              const auto spacing = _impl->theme.spacing;
+              const auto indicatorSize = _impl->theme->iconSize;
+              const auto spacing = _impl->theme->spacing;
               const auto shiftX = hasIcon ? static_cast<int>(spacing * 2.5) : 0;
               const auto indicatorButtonW = spacing * 2 + indicatorSize.width();
               const auto editFieldW = comboBoxOpt->rect.width() - indicatorButtonW + shiftX;
@@ -3410,7 +3715,7 @@ QRect QlementineStyle::subControlRect(
             }
           } break;
           case SC_ComboBoxFrame: {
-            const auto frameH = _impl->theme.controlHeightLarge;
+            const auto frameH = _impl->theme->controlHeightLarge;
             const auto frameW = comboBoxOpt->rect.width();
             const auto frameX = comboBoxOpt->rect.x();
             const auto frameY = comboBoxOpt->rect.y() + (comboBoxOpt->rect.height() - frameH) / 2;
@@ -3419,8 +3724,8 @@ QRect QlementineStyle::subControlRect(
           case SC_ComboBoxListBoxPopup: {
             const auto contentMarginH = pixelMetric(PM_MenuHMargin);
             const auto contentMarginV = pixelMetric(PM_MenuVMargin);
-            const auto shadowWidth = _impl->theme.spacing;
-            const auto borderWidth = _impl->theme.borderWidth;
+            const auto shadowWidth = _impl->theme->spacing;
+            const auto borderWidth = _impl->theme->borderWidth;
             const auto width = std::max(opt->rect.width(), w->width());
             const auto height = opt->rect.height() + 12; // Not possible to change height here.
             const auto x = opt->rect.x() - shadowWidth - borderWidth - contentMarginH;
@@ -3456,7 +3761,7 @@ QRect QlementineStyle::subControlRect(
             // Compute slider length.
             if (scrollBarOpt->maximum != scrollBarOpt->minimum) {
               const auto range = scrollBarOpt->maximum - scrollBarOpt->minimum;
-              const auto margin = _impl->theme.scrollBarMargin;
+              const auto margin = _impl->theme->scrollBarMargin;
               auto maxLength = horizontal ? rect.width() - 2 * margin : rect.height() - 2 * margin;
               auto minLength = pixelMetric(PM_ScrollBarSliderMin, scrollBarOpt, w);
               if (minLength > maxLength) {
@@ -3474,7 +3779,7 @@ QRect QlementineStyle::subControlRect(
             }
           } break;
           case SC_ScrollBarGroove: {
-            const auto margin = _impl->theme.scrollBarMargin;
+            const auto margin = _impl->theme->scrollBarMargin;
             return horizontal ? QRect(rect.x() + margin, rect.y(), rect.width() - 2 * margin, rect.height() - margin)
                               : QRect(rect.x(), rect.y() + margin, rect.width() - margin, rect.height() - 2 * margin);
           } break;
@@ -3493,7 +3798,7 @@ QRect QlementineStyle::subControlRect(
         switch (sc) {
           case SC_SliderGroove: {
             const auto grooveW = opt->rect.width();
-            const auto grooveH = _impl->theme.sliderGrooveHeight;
+            const auto grooveH = _impl->theme->sliderGrooveHeight;
             const auto grooveX = opt->rect.x();
             const auto grooveY = opt->rect.y() + (opt->rect.height() - grooveH) / 2;
             return QRect{ grooveX, grooveY, grooveW, grooveH };
@@ -3525,7 +3830,7 @@ QRect QlementineStyle::subControlRect(
                 const auto handleThickness = pixelMetric(PM_SliderLength);
                 const auto tickOffset = pixelMetric(PM_SliderTickmarkOffset);
                 const auto tickMarksX = opt->rect.x() + handleThickness / 2;
-                const auto tickMarksH = _impl->theme.sliderTickSize;
+                const auto tickMarksH = _impl->theme->sliderTickSize;
                 const auto tickMarksY = grooveRect.top() - tickOffset - tickMarksH;
                 const auto tickMarksW = grooveRect.width() - handleThickness;
                 return QRect{ tickMarksX, tickMarksY, tickMarksW, tickMarksH };
@@ -3549,8 +3854,8 @@ QRect QlementineStyle::subControlRect(
           toolButtonOpt->features.testFlag(QStyleOptionToolButton::ToolButtonFeature::MenuButtonPopup);
 
         const auto& iconSize = toolButtonOpt->iconSize;
-        const auto separatorW = _impl->theme.borderWidth;
-        const auto spacing = _impl->theme.spacing;
+        const auto separatorW = _impl->theme->borderWidth;
+        const auto spacing = _impl->theme->spacing;
         const auto menuButtonW =
           hasMenu ? (menuIsOnSeparateButton ? separatorW + iconSize.width() + spacing / 2 : iconSize.width()) : 0;
         const auto buttonW = rect.width() - menuButtonW;
@@ -3597,7 +3902,7 @@ QRect QlementineStyle::subControlRect(
         switch (sc) {
           case SC_DialHandle:
           case SC_DialGroove: {
-            const auto tickSpace = hasTicks ? _impl->theme.dialTickLength + _impl->theme.dialTickSpacing : 0;
+            const auto tickSpace = hasTicks ? _impl->theme->dialTickLength + _impl->theme->dialTickSpacing : 0;
             const auto minDimension = std::max(0, std::min(totalRect.width(), totalRect.height()) - tickSpace * 2);
             const auto dialX = totalRect.x() + (totalRect.width() - minDimension) / 2;
             const auto dialY = totalRect.y() + (totalRect.height() - minDimension) / 2;
@@ -3623,12 +3928,13 @@ QRect QlementineStyle::subControlRect(
         const auto hasTitle = groupBoxOpt->subControls.testFlag(SC_GroupBoxLabel);
         const auto hasCheckbox = groupBoxOpt->subControls.testFlag(SC_GroupBoxCheckBox);
         const auto hasFrame = !groupBoxOpt->features.testFlag(QStyleOptionFrame::Flat);
-        const auto labelH =
-          hasTitle ? std::max(_impl->theme.controlHeightMedium, QFontMetrics(_impl->theme.fontH5).height()) : 0;
-        const auto titleBottomSpacing = hasFrame && (hasTitle || hasCheckbox) ? _impl->theme.spacing / 2 : 0;
-        const auto& checkBoxSize = hasCheckbox ? _impl->theme.iconSize : QSize{ 0, 0 };
+        const auto labelH = hasTitle ? std::max(_impl->theme->controlHeightMedium,
+                                         _impl->fontMetrics(FontMetricsCache::Font::H5, w).height())
+                                     : 0;
+        const auto titleBottomSpacing = hasFrame && (hasTitle || hasCheckbox) ? _impl->theme->spacing / 2 : 0;
+        const auto& checkBoxSize = hasCheckbox ? _impl->theme->iconSize : QSize{ 0, 0 };
         const auto titleH = hasTitle || hasCheckbox ? std::max(labelH, checkBoxSize.height()) : 0;
-        const auto leftPadding = hasTitle || hasCheckbox ? _impl->theme.spacing : 0;
+        const auto leftPadding = hasTitle || hasCheckbox ? _impl->theme->spacing : 0;
 
         switch (sc) {
             // TODO handle other kinds of Qt::Alignment like right-aligned or centered.
@@ -3642,7 +3948,7 @@ QRect QlementineStyle::subControlRect(
           case SC_GroupBoxLabel:
             // TODO handle other kinds of Qt::Alignment like right-aligned or centered.
             if (groupBoxOpt->subControls.testFlag(SC_GroupBoxLabel)) {
-              const auto spacing = hasCheckbox ? _impl->theme.spacing : 0;
+              const auto spacing = hasCheckbox ? _impl->theme->spacing : 0;
               const auto x = rect.x() + checkBoxSize.width() + spacing;
               const auto y = rect.y();
               const auto labelW = rect.width() - checkBoxSize.width() - spacing;
@@ -3707,12 +4013,12 @@ QSize QlementineStyle::sizeFromContents(
         if (hasIcon) {
           contentWidth += optButton->iconSize.width();
           if (hasText) {
-            contentWidth += _impl->theme.spacing;
+            contentWidth += _impl->theme->spacing;
           }
         }
         if (hasMenu) {
           contentWidth += optButton->iconSize.width();
-          contentWidth += _impl->theme.spacing;
+          contentWidth += _impl->theme->spacing;
         }
 
         const auto maxSize = widget->maximumSize();
@@ -3720,7 +4026,7 @@ QSize QlementineStyle::sizeFromContents(
         const auto maxH = maxSize.height();
         const auto padding = pixelMetric(PM_ButtonMargin, opt, widget);
         const auto [paddingLeft, paddingRight] = getHPaddings(hasIcon, hasText, hasMenu, padding);
-        const auto defaultH = _impl->theme.controlHeightLarge;
+        const auto defaultH = _impl->theme->controlHeightLarge;
         auto w = std::max(defaultH, contentWidth + paddingLeft + paddingRight);
         if (maxW != QWIDGETSIZE_MAX && maxW > -1) {
           w = std::min(w, maxW);
@@ -3745,7 +4051,7 @@ QSize QlementineStyle::sizeFromContents(
           if (optButton->text.isEmpty()) {
             actualContentSize.rwidth() = 0;
           } else {
-            actualContentSize.rwidth() += _impl->theme.spacing;
+            actualContentSize.rwidth() += _impl->theme->spacing;
           }
         }
 
@@ -3757,24 +4063,25 @@ QSize QlementineStyle::sizeFromContents(
 
         const auto verticalMargin = pixelMetric(PM_ButtonMargin, opt, widget) / 2;
         const auto w = actualContentSize.width();
-        const auto h = std::max(_impl->theme.controlHeightMedium, actualContentSize.height() + verticalMargin);
+        const auto h = std::max(_impl->theme->controlHeightMedium, actualContentSize.height() + verticalMargin);
         return QSize{ w, h };
       }
       break;
     case CT_ToolButton:
       if (const auto* optToolButton = qstyleoption_cast<const QStyleOptionToolButton*>(opt)) {
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto& iconSize = optToolButton->iconSize;
 
         // Special cases.
-        if (widget->inherits("QLineEditIconButton")) {
-          return _impl->theme.iconSize;
-        } else if (widget->inherits("QMenuBarExtension")) {
+        const auto traits = _impl->widgetTraits.traits(widget);
+        if (traits.testFlag(WidgetTrait::LineEditIconButton)) {
+          return _impl->theme->iconSize;
+        } else if (traits.testFlag(WidgetTrait::MenuBarExtension)) {
           const auto extent = pixelMetric(PM_ToolBarExtensionExtent);
           return QSize{ extent, extent };
-        } else if (qobject_cast<QTabBar*>(widget->parentWidget())) {
-          const auto w = _impl->theme.controlHeightMedium + static_cast<int>(spacing * 1.5);
-          const auto h = _impl->theme.controlHeightLarge + spacing;
+        } else if (traits.testFlag(WidgetTrait::ParentIsTabBar)) {
+          const auto w = _impl->theme->controlHeightMedium + static_cast<int>(spacing * 1.5);
+          const auto h = _impl->theme->controlHeightLarge + spacing;
           return QSize{ w, h };
         }
 
@@ -3783,10 +4090,10 @@ QSize QlementineStyle::sizeFromContents(
         const auto menuIsOnSeparateButton =
           hasMenu && optToolButton->features.testFlag(QStyleOptionToolButton::ToolButtonFeature::MenuButtonPopup);
 
-        const auto separatorW = menuIsOnSeparateButton ? _impl->theme.borderWidth : 0;
+        const auto separatorW = menuIsOnSeparateButton ? _impl->theme->borderWidth : 0;
         const auto menuIndicatorW = hasMenu ? separatorW + iconSize.width() + spacing / 2 : 0;
-        const auto h = iconSize.height() < _impl->theme.controlHeightLarge ? _impl->theme.controlHeightLarge
-                                                                           : iconSize.height() + _impl->theme.spacing;
+        const auto h = iconSize.height() < _impl->theme->controlHeightLarge ? _impl->theme->controlHeightLarge
+                                                                           : iconSize.height() + _impl->theme->spacing;
 
         switch (buttonStyle) {
           case Qt::ToolButtonStyle::ToolButtonTextOnly: {
@@ -3821,11 +4128,9 @@ QSize QlementineStyle::sizeFromContents(
     case CT_ComboBox:
       if (const auto* optComboBox = qstyleoption_cast<const QStyleOptionComboBox*>(opt)) {
         // Check if the ComboBox is inside a QTableView/QTreeView.
-        const auto* parentWidget = widget ? widget->parentWidget() : nullptr;
-        const auto* parentParentWidget = parentWidget ? parentWidget->parentWidget() : nullptr;
-        const auto isTabCellEditor = qobject_cast<const QAbstractItemView*>(parentParentWidget) != nullptr;
+        const auto isTabCellEditor = _impl->widgetTraits.traits(widget).testFlag(WidgetTrait::GrandParentIsItemView);
 
-        const auto h = _impl->theme.controlHeightLarge;
+        const auto h = _impl->theme->controlHeightLarge;
         auto w = isTabCellEditor ? optComboBox->rect.size().width() : contentSize.width();
 
         // Hack hardcoded values in Qt source code.
@@ -3837,15 +4142,15 @@ QSize QlementineStyle::sizeFromContents(
           if (optComboBox->currentText.isEmpty()) {
             w = 0;
           } else {
-            w += _impl->theme.spacing;
+            w += _impl->theme->spacing;
           }
         }
 
         // Add space to compute correct sizeHint.
         if (!isTabCellEditor) {
           // Add space for indicator (NB: this is the arrow on the right, not the icon).
-          const auto indicatorSize = _impl->theme.iconSize;
-          w += _impl->theme.spacing + indicatorSize.width();
+          const auto indicatorSize = _impl->theme->iconSize;
+          w += _impl->theme->spacing + indicatorSize.width();
 
           // Add space for padding.
           const auto framePadding = pixelMetric(PM_ComboBoxFrameWidth, optComboBox, widget);
@@ -3867,26 +4172,26 @@ QSize QlementineStyle::sizeFromContents(
           showText ? optProgressBar->fontMetrics.boundingRect(optProgressBar->rect, Qt::AlignRight, maximumText).width()
                    : 0;
         const auto labelH = showText ? optProgressBar->fontMetrics.height() : 0;
-        const auto spacing = _impl->theme.spacing;
-        const auto barH = _impl->theme.progressBarGrooveHeight;
-        const auto defaultH = _impl->theme.controlHeightMedium;
+        const auto spacing = _impl->theme->spacing;
+        const auto barH = _impl->theme->progressBarGrooveHeight;
+        const auto defaultH = _impl->theme->controlHeightMedium;
         const auto h = std::min(defaultH, std::max(labelH, barH));
-        const auto w = _impl->theme.controlDefaultWidth + (showText ? spacing + labelW : 0);
+        const auto w = _impl->theme->controlDefaultWidth + (showText ? spacing + labelW : 0);
         return QSize{ w, h };
       }
       break;
     case CT_MenuItem:
       if (const auto* optMenuItem = qstyleoption_cast<const QStyleOptionMenuItem*>(opt)) {
         if (optMenuItem->menuItemType == QStyleOptionMenuItem::Separator) {
-          const auto h = _impl->theme.spacing + _impl->theme.borderWidth;
+          const auto h = _impl->theme->spacing + _impl->theme->borderWidth;
           return QSize{ h, h };
 
         } else if (optMenuItem->menuItemType == QStyleOptionMenuItem::Normal
                    || optMenuItem->menuItemType == QStyleOptionMenuItem::SubMenu) {
-          const auto hPadding = _impl->theme.spacing;
-          const auto vPadding = _impl->theme.spacing / 2;
-          const auto iconSize = _impl->theme.iconSize;
-          const auto spacing = _impl->theme.spacing;
+          const auto hPadding = _impl->theme->spacing;
+          const auto vPadding = _impl->theme->spacing / 2;
+          const auto iconSize = _impl->theme->iconSize;
+          const auto spacing = _impl->theme->spacing;
           const auto& fm = optMenuItem->fontMetrics;
           const auto [label, shortcut] = getMenuLabelAndShortcut(optMenuItem->text);
           const auto labelW = fm.boundingRect(optMenuItem->rect, Qt::AlignLeft, label).width();
@@ -3913,16 +4218,16 @@ QSize QlementineStyle::sizeFromContents(
           const auto checkW = hasCheck ? iconSize.width() + spacing : 0;
 
           const auto w = std::max(0, hPadding + checkW + iconW + labelW + shortcutW + arrowW + hPadding);
-          const auto h = std::max(_impl->theme.controlHeightMedium, iconSize.height() + vPadding);
+          const auto h = std::max(_impl->theme->controlHeightMedium, iconSize.height() + vPadding);
           return { w, h };
         }
         return QSize{};
       }
       break;
     case CT_MenuBarItem: {
-      const auto hPadding = _impl->theme.spacing;
-      const auto vPadding = _impl->theme.spacing / 2;
-      const auto h = std::max(_impl->theme.iconSize.height() + _impl->theme.spacing, contentSize.height());
+      const auto hPadding = _impl->theme->spacing;
+      const auto vPadding = _impl->theme->spacing / 2;
+      const auto h = std::max(_impl->theme->iconSize.height() + _impl->theme->spacing, contentSize.height());
       auto s = contentSize.grownBy(QMargins(hPadding, vPadding, hPadding, vPadding));
       s.rheight() = h;
       return s;
@@ -3936,8 +4241,8 @@ QSize QlementineStyle::sizeFromContents(
         // TODO Handle expanding tab bar.
         // TODO Choose min/max values according to available space and total tab count.
         // Don't make tabs too long or too short.
-        const auto spacing = _impl->theme.spacing;
-        const auto h = _impl->theme.controlHeightLarge + spacing;
+        const auto spacing = _impl->theme->spacing;
+        const auto h = _impl->theme->controlHeightLarge + spacing;
 
         auto w = spacing * 2;
 
@@ -3962,8 +4267,8 @@ QSize QlementineStyle::sizeFromContents(
         }
 
         // Clamp tab size.
-        auto tabMaxWidth = _impl->theme.tabBarTabMaxWidth;
-        auto tabMinWidth = _impl->theme.tabBarTabMinWidth;
+        auto tabMaxWidth = _impl->theme->tabBarTabMaxWidth;
+        auto tabMinWidth = _impl->theme->tabBarTabMinWidth;
         if (tabMinWidth > tabMaxWidth) {
           std::swap(tabMinWidth, tabMaxWidth);
         }
@@ -3983,8 +4288,8 @@ QSize QlementineStyle::sizeFromContents(
     case CT_Slider:
       if (const auto* optSlider = qstyleoption_cast<const QStyleOptionSlider*>(opt)) {
         const auto& rect = optSlider->rect;
-        return optSlider->orientation == Qt::Horizontal ? QSize{ rect.width(), _impl->theme.controlHeightMedium }
-                                                        : QSize{ _impl->theme.controlHeightMedium, rect.height() };
+        return optSlider->orientation == Qt::Horizontal ? QSize{ rect.width(), _impl->theme->controlHeightMedium }
+                                                        : QSize{ _impl->theme->controlHeightMedium, rect.height() };
       }
       break;
     case CT_ScrollBar:
@@ -3995,20 +4300,19 @@ QSize QlementineStyle::sizeFromContents(
       if (const auto* optFrame = qstyleoption_cast<const QStyleOptionFrame*>(opt)) {
         const auto r = optFrame->rect;
         const auto w = r.width() - 2 * hardcodedLineEditHMargin;
-        const auto h = _impl->theme.controlHeightLarge;
-        const auto* parent = widget->parentWidget();
-        const auto* treeView = parent ? qobject_cast<const QAbstractItemView*>(parent->parentWidget()) : nullptr;
-        return treeView ? contentSize : QSize{ w, h };
+        const auto h = _impl->theme->controlHeightLarge;
+        const auto isTabCellEditor = _impl->widgetTraits.traits(widget).testFlag(WidgetTrait::GrandParentIsItemView);
+        return isTabCellEditor ? contentSize : QSize{ w, h };
       }
       break;
     case CT_SpinBox:
       if (const auto* optSpinbox = qstyleoption_cast<const QStyleOptionSpinBox*>(opt)) {
-        const auto isDateTimeEdit = qobject_cast<const QDateTimeEdit*>(widget) != nullptr;
+        const auto isDateTimeEdit = _impl->widgetTraits.traits(widget).testFlag(WidgetTrait::DateTimeEdit);
         const auto hasButtons = optSpinbox->buttonSymbols != QAbstractSpinBox::NoButtons;
-        const auto buttonW = isDateTimeEdit || hasButtons ? _impl->theme.controlHeightLarge : 0;
-        const auto dateTimeWidth = isDateTimeEdit ? _impl->theme.iconSize.width() : 0;
+        const auto buttonW = isDateTimeEdit || hasButtons ? _impl->theme->controlHeightLarge : 0;
+        const auto dateTimeWidth = isDateTimeEdit ? _impl->theme->iconSize.width() : 0;
         const auto borderW = optSpinbox->frame ? pixelMetric(PM_SpinBoxFrameWidth, opt, widget) : 0;
-        return QSize{ contentSize.width() + buttonW + dateTimeWidth + 2 * borderW, _impl->theme.controlHeightLarge };
+        return QSize{ contentSize.width() + buttonW + dateTimeWidth + 2 * borderW, _impl->theme->controlHeightLarge };
       }
       break;
     case CT_SizeGrip:
@@ -4019,13 +4323,13 @@ QSize QlementineStyle::sizeFromContents(
       break;
     case CT_HeaderSection:
       if (const auto* optHeader = qstyleoption_cast<const QStyleOptionHeader*>(opt)) {
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto headerIsSelected = true;
         auto font = QFont(widget->font());
         if (headerIsSelected) {
           font.setBold(true);
         }
-        const auto lineW = _impl->theme.borderWidth;
+        const auto lineW = _impl->theme->borderWidth;
         const auto iconExtent = pixelMetric(PM_SmallIconSize, opt);
         const auto fm = QFontMetrics(font);
         const auto textW = qlementine::textWidth(fm, optHeader->text);
@@ -4047,16 +4351,15 @@ QSize QlementineStyle::sizeFromContents(
         const auto hasTitle = groupBoxOpt->subControls.testFlag(SC_GroupBoxLabel);
         const auto hasCheckbox = groupBoxOpt->subControls.testFlag(SC_GroupBoxCheckBox);
         const auto hasFrame = !groupBoxOpt->features.testFlag(QStyleOptionFrame::Flat);
-        const auto fm = QFontMetrics(_impl->theme.fontH5);
-        const auto labelH =
-          hasTitle ? std::max(_impl->theme.controlHeightMedium, QFontMetrics(_impl->theme.fontH5).height()) : 0;
+        const auto& fm = _impl->fontMetrics(FontMetricsCache::Font::H5, widget);
+        const auto labelH = hasTitle ? std::max(_impl->theme->controlHeightMedium, fm.height()) : 0;
         const auto labelW = fm.boundingRect(groupBoxOpt->rect, Qt::AlignLeft, groupBoxOpt->text).width();
-        const auto& checkBoxSize = _impl->theme.iconSize;
-        const auto titleBottomSpacing = hasFrame && (hasTitle || hasCheckbox) ? _impl->theme.spacing / 2 : 0;
+        const auto& checkBoxSize = _impl->theme->iconSize;
+        const auto titleBottomSpacing = hasFrame && (hasTitle || hasCheckbox) ? _impl->theme->spacing / 2 : 0;
         const auto titleH = hasTitle || hasCheckbox ? std::max(labelH, checkBoxSize.height()) : 0;
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto titleW = checkBoxSize.width() + spacing + labelW;
-        const auto leftPadding = hasTitle || hasCheckbox ? _impl->theme.spacing : 0;
+        const auto leftPadding = hasTitle || hasCheckbox ? _impl->theme->spacing : 0;
         const auto w = std::max(contentSize.width() + leftPadding, titleW);
         const auto h = titleH + titleBottomSpacing + contentSize.height();
         return QSize{ w, h };
@@ -4067,7 +4370,7 @@ QSize QlementineStyle::sizeFromContents(
     case CT_ItemViewItem:
       if (const auto* optItem = qstyleoption_cast<const QStyleOptionViewItem*>(opt)) {
         const auto& features = optItem->features;
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto hPadding = spacing;
 
         const auto hasIcon = features.testFlag(QStyleOptionViewItem::HasDecoration) && !optItem->icon.isNull();
@@ -4077,7 +4380,7 @@ QSize QlementineStyle::sizeFromContents(
         const auto textH = hasText ? optItem->fontMetrics.height() : 0;
 
         const auto hasCheck = features.testFlag(QStyleOptionViewItem::HasCheckIndicator);
-        const auto& checkSize = hasCheck ? _impl->theme.iconSize : QSize{ 0, 0 };
+        const auto& checkSize = hasCheck ? _impl->theme->iconSize : QSize{ 0, 0 };
 
         auto font = QFont(widget->font());
         const auto fm = QFontMetrics(font);
@@ -4085,7 +4388,7 @@ QSize QlementineStyle::sizeFromContents(
 
         const auto w = textW + 2 * hPadding + (iconSize.width() > 0 ? iconSize.width() + spacing : 0)
                        + (checkSize.width() > 0 ? checkSize.width() + spacing : 0);
-        const auto defaultH = _impl->theme.controlHeightLarge;
+        const auto defaultH = _impl->theme->controlHeightLarge;
         const auto h = std::max({ iconSize.height() + spacing, textH + spacing, defaultH });
         return QSize{ w, h };
       }
@@ -4100,34 +4403,34 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
   switch (m) {
     // Icons.
     case PM_SmallIconSize:
-      return _impl->theme.iconSize.height();
+      return _impl->theme->iconSize.height();
     case PM_LargeIconSize:
-      return _impl->theme.iconSizeLarge.height();
+      return _impl->theme->iconSizeLarge.height();
 
     // Button.
     case PM_ButtonMargin:
-      return _impl->theme.spacing;
+      return _impl->theme->spacing;
     case PM_ButtonDefaultIndicator:
-      return _impl->theme.iconSize.width();
+      return _impl->theme->iconSize.width();
     case PM_MenuButtonIndicator:
-      return _impl->theme.iconSize.width();
+      return _impl->theme->iconSize.width();
     case PM_ButtonShiftHorizontal:
     case PM_ButtonShiftVertical:
       return 0;
     case PM_ButtonIconSize:
-      return _impl->theme.iconSize.height();
+      return _impl->theme->iconSize.height();
 
     // LineEdit.
     case PM_LineEditIconMargin:
-      return _impl->theme.spacing;
+      return _impl->theme->spacing;
     case PM_LineEditIconSize:
-      return _impl->theme.iconSize.height();
+      return _impl->theme->iconSize.height();
 
     // Frame.
     case PM_DefaultFrameWidth:
       // Hack for QLineEdit. This is the only way to know if we have to draw a border or not.
       // See: https://github.com/qt/qtbase/blob/dev/src/widgets/widgets/qlineedit.cpp#L81C65-L81C85
-      if (qobject_cast<const QLineEdit*>(w)) {
+      if (_impl->widgetTraits.traits(w).testFlag(WidgetTrait::LineEdit)) {
         return 1;
       }
       // Prevent QWidgets that contain or inherit QFrame to have a border.
@@ -4135,21 +4438,21 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
 
     // ComboBox.
     case PM_ComboBoxFrameWidth:
-      return _impl->theme.spacing;
+      return _impl->theme->spacing;
 
     // SpinBox.
     case PM_SpinBoxFrameWidth:
-      return _impl->theme.borderWidth;
+      return _impl->theme->borderWidth;
 
     // Slider.
     case PM_SliderControlThickness:
-      return _impl->theme.controlHeightMedium;
+      return _impl->theme->controlHeightMedium;
     case PM_SliderThickness:
-      return _impl->theme.iconSize.height();
+      return _impl->theme->iconSize.height();
     case PM_SliderLength:
-      return _impl->theme.iconSize.width();
+      return _impl->theme->iconSize.width();
     case PM_SliderTickmarkOffset:
-      return _impl->theme.sliderTickSpacing;
+      return _impl->theme->sliderTickSpacing;
     case PM_SliderSpaceAvailable:
       if (const auto* optSlider = qstyleoption_cast<const QStyleOptionSlider*>(opt)) {
         return optSlider->rect.width() - pixelMetric(PM_SliderLength, optSlider, w);
@@ -4168,13 +4471,13 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
 
     // TabBar.
     case PM_TabBarTabOverlap:
-      return static_cast<int>(_impl->theme.borderRadius);
+      return static_cast<int>(_impl->theme->borderRadius);
     case PM_TabBarTabHSpace:
       return 0;
     case PM_TabBarTabVSpace:
       return 0;
     case PM_TabBarBaseHeight:
-      return _impl->theme.controlHeightLarge + _impl->theme.spacing;
+      return _impl->theme->controlHeightLarge + _impl->theme->spacing;
     case PM_TabBarBaseOverlap:
       return 0;
     case PM_TabBarTabShiftHorizontal:
@@ -4182,14 +4485,14 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
     case PM_TabBarTabShiftVertical:
       return 0;
     case PM_TabBarScrollButtonWidth:
-      return _impl->theme.controlHeightLarge + static_cast<int>(_impl->theme.spacing * 1.5);
+      return _impl->theme->controlHeightLarge + static_cast<int>(_impl->theme->spacing * 1.5);
     case PM_TabBar_ScrollButtonOverlap:
       return 0;
     case PM_TabBarIconSize:
-      return _impl->theme.iconSize.height();
+      return _impl->theme->iconSize.height();
     case PM_TabCloseIndicatorWidth:
     case PM_TabCloseIndicatorHeight:
-      return _impl->theme.controlHeightMedium;
+      return _impl->theme->controlHeightMedium;
 
     // ProgressBar.
     case PM_ProgressBarChunkWidth:
@@ -4209,19 +4512,19 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
     // Menu.
     case PM_MenuScrollerHeight:
       // Scroller is the part where the user can click to scroll the menu when it is too big.
-      return _impl->theme.controlHeightSmall;
+      return _impl->theme->controlHeightSmall;
     case PM_MenuHMargin:
     case PM_MenuVMargin: {
       // Keep some space between the items and the frame.
-      const auto borderW = qobject_cast<const QMenu*>(w) ? 1 : 0;
-      return _impl->theme.spacing / 2 + borderW;
+      const auto borderW = _impl->widgetTraits.traits(w).testFlag(WidgetTrait::Menu) ? 1 : 0;
+      return _impl->theme->spacing / 2 + borderW;
     }
     case PM_MenuPanelWidth:
       // Keep some space for drop shadow.
-      return blurRadiusNecessarySpace(_impl->theme.spacing);
+      return blurRadiusNecessarySpace(_impl->theme->spacing);
     case PM_MenuTearoffHeight:
       // Tear off is the part of the menu that is clickable to detach the menu.
-      return _impl->theme.controlHeightSmall;
+      return _impl->theme->controlHeightSmall;
     case PM_MenuDesktopFrameWidth:
       // TODO What is it?
       break;
@@ -4230,7 +4533,7 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
 
     // MenuBar.
     case PM_MenuBarPanelWidth:
-      return _impl->theme.borderWidth; // Let this to any value to ensure bg is drawn.
+      return _impl->theme->borderWidth; // Let this to any value to ensure bg is drawn.
     case PM_MenuBarItemSpacing:
       return 0;
     case PM_MenuBarVMargin:
@@ -4241,14 +4544,14 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
     // Indicators.
     case PM_IndicatorWidth:
     case PM_ExclusiveIndicatorWidth:
-      return _impl->theme.iconSize.width();
+      return _impl->theme->iconSize.width();
     case PM_IndicatorHeight:
     case PM_ExclusiveIndicatorHeight:
-      return _impl->theme.iconSize.height();
+      return _impl->theme->iconSize.height();
 
     // Dialog.
     case PM_MessageBoxIconSize:
-      return _impl->theme.iconSizeLarge.height();
+      return _impl->theme->iconSizeLarge.height();
 
     // Mdi.
     case PM_MdiSubWindowFrameWidth:
@@ -4258,19 +4561,19 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
 
     // ToolBar.
     case PM_ToolBarFrameWidth:
-      return _impl->theme.borderWidth;
+      return _impl->theme->borderWidth;
     case PM_ToolBarHandleExtent:
-      return _impl->theme.spacing / 2;
+      return _impl->theme->spacing / 2;
     case PM_ToolBarItemSpacing:
-      return _impl->theme.spacing / 2;
+      return _impl->theme->spacing / 2;
     case PM_ToolBarItemMargin:
-      return _impl->theme.spacing;
+      return _impl->theme->spacing;
     case PM_ToolBarSeparatorExtent:
-      return _impl->theme.spacing * 2;
+      return _impl->theme->spacing * 2;
     case PM_ToolBarExtensionExtent:
-      return _impl->theme.iconSize.height() + _impl->theme.spacing;
+      return _impl->theme->iconSize.height() + _impl->theme->spacing;
     case PM_ToolBarIconSize:
-      return _impl->theme.iconSize.height();
+      return _impl->theme->iconSize.height();
 
     // SpinBox.
     case PM_SpinBoxSliderHeight:
@@ -4282,25 +4585,25 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
     case PM_ListViewIconSize:
       return pixelMetric(PM_SmallIconSize, opt, w);
     case PM_HeaderDefaultSectionSizeHorizontal:
-      return static_cast<int>(_impl->theme.controlDefaultWidth * 1.5);
+      return static_cast<int>(_impl->theme->controlDefaultWidth * 1.5);
     case PM_HeaderDefaultSectionSizeVertical:
-      return _impl->theme.controlHeightMedium;
+      return _impl->theme->controlHeightMedium;
 
     // Focus.
     case PM_FocusFrameVMargin:
     case PM_FocusFrameHMargin:
       // This is used in QFocusFrame to compute its size.
       // Allow place for bounce animation.
-      return 2 * _impl->theme.focusBorderWidth;
+      return 2 * _impl->theme->focusBorderWidth;
 
     // ToolTip.
     case PM_ToolTipLabelFrameWidth:
-      return _impl->theme.spacing / 2;
+      return _impl->theme->spacing / 2;
 
     // CheckBox.
     case PM_RadioButtonLabelSpacing:
     case PM_CheckBoxLabelSpacing:
-      return _impl->theme.spacing;
+      return _impl->theme->spacing;
 
     // Grip.
     case PM_SizeGripSize:
@@ -4317,10 +4620,10 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
     case PM_LayoutTopMargin:
     case PM_LayoutRightMargin:
     case PM_LayoutBottomMargin:
-      return _impl->theme.spacing * 2;
+      return _impl->theme->spacing * 2;
     case PM_LayoutHorizontalSpacing:
     case PM_LayoutVerticalSpacing:
-      return _impl->theme.spacing;
+      return _impl->theme->spacing;
 
     // Common.
     case PM_TextCursorWidth:
@@ -4328,9 +4631,9 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
 
     // ScrollView.
     case PM_ScrollBarExtent:
-      return _impl->theme.scrollBarThicknessFull + _impl->theme.scrollBarMargin;
+      return _impl->theme->scrollBarThicknessFull + _impl->theme->scrollBarMargin;
     case PM_ScrollBarSliderMin:
-      return _impl->theme.controlHeightLarge;
+      return _impl->theme->controlHeightLarge;
     case PM_ScrollView_ScrollBarSpacing:
       return 0;
     case PM_ScrollView_ScrollBarOverlap:
@@ -4338,11 +4641,11 @@ int QlementineStyle::pixelMetric(PixelMetric m, const QStyleOption* opt, const Q
 
     // TreeView/TableView.
     case PM_TreeViewIndentation:
-      return static_cast<int>(_impl->theme.spacing * 2.5);
+      return static_cast<int>(_impl->theme->spacing * 2.5);
     case PM_HeaderMargin:
-      return _impl->theme.spacing; // Header horizontal padding.
+      return _impl->theme->spacing; // Header horizontal padding.
     case PM_HeaderMarkSize:
-      return _impl->theme.iconSize.height();
+      return _impl->theme->iconSize.height();
     case PM_HeaderGripMargin:
       break; // ???
 
@@ -4365,7 +4668,7 @@ int QlementineStyle::styleHint(StyleHint sh, const QStyleOption* opt, const QWid
       break;
     case SH_Widget_Animate: // deprecated
     case SH_Widget_Animation_Duration:
-      return _impl->theme.animationDuration;
+      return _impl->theme->animationDuration;
 
     // Workspace
     case SH_Workspace_FillSpaceOnMaximize:
@@ -4530,7 +4833,7 @@ int QlementineStyle::styleHint(StyleHint sh, const QStyleOption* opt, const QWid
     case SH_GroupBox_TextLabelVerticalAlignment:
       return Qt::AlignVCenter;
     case SH_GroupBox_TextLabelColor:
-      return int(_impl->theme.secondaryColor.rgba());
+      return int(_impl->theme->secondaryColor.rgba());
 
     // Table
     case SH_Table_GridLineColor:
@@ -4566,7 +4869,7 @@ int QlementineStyle::styleHint(StyleHint sh, const QStyleOption* opt, const QWid
     case SH_FocusFrame_Mask:
       if (w) {
         if (auto* mask = qstyleoption_cast<QStyleHintReturnMask*>(shret)) {
-          const auto focusBorderW = _impl->theme.focusBorderWidth;
+          const auto focusBorderW = _impl->theme->focusBorderWidth;
           const auto widgetRect = w->rect();
           const auto extendedRect =
             widgetRect.marginsAdded(QMargins(focusBorderW, focusBorderW, focusBorderW, focusBorderW));
@@ -4686,7 +4989,7 @@ QIcon QlementineStyle::standardIcon(StandardPixmap sp, const QStyleOption* opt,
     case SP_ArrowLeft:
     case SP_ArrowRight:
     case SP_LineEditClearButton:
-      return _impl->getStandardIcon(sp, _impl->theme.iconSize);
+      return _impl->getStandardIcon(sp, _impl->theme->iconSize);
     default:
       break;
   }
@@ -4694,7 +4997,7 @@ QIcon QlementineStyle::standardIcon(StandardPixmap sp, const QStyleOption* opt,
 }
 
 QPalette QlementineStyle::standardPalette() const {
-  return _impl->theme.palette;
+  return _impl->theme->palette;
 }
 
 QPixmap QlementineStyle::standardPixmap(StandardPixmap sp, const QStyleOption* opt, const QWidget* w) const {
@@ -4712,12 +5015,14 @@ int QlementineStyle::layoutSpacing(QSizePolicy::ControlType c1, QSizePolicy::Con
 
 void QlementineStyle::polish(QPalette& palette) {
   QCommonStyle::polish(palette);
-  palette = _impl->theme.palette;
+  palette = _impl->theme->palette;
 }
 
 void QlementineStyle::polish(QApplication* app) {
   QCommonStyle::polish(app);
-  app->setFont(_impl->theme.fontRegular);
+  // Setting the font doesn't resolve it: fonts are waited for when the first widget is polished,
+  // so the application can build its widgets while they are being installed.
+  app->setFont(_impl->theme->fontRegular);
 
   QCoreApplication::setAttribute(Qt::AA_DontShowIconsInMenus, false);
   QCoreApplication::setAttribute(Qt::AA_DontShowShortcutsInContextMenus, false);
@@ -4738,6 +5043,12 @@ void QlementineStyle::polish(QWidget* w) {
     return;
 
   QCommonStyle::polish(w);
+  // Widgets measure their text right after they are polished (i.e. when shown). Only the first one waits.
+  _impl->ensureFontsInstalled();
+
+  // Classify the widget once, so drawing and measuring it doesn't need to cast it again.
+  // Entries of destroyed widgets are detected and purged by the table itself.
+  const auto traits = _impl->widgetTraits.insert(w);
 
 // Currently we only support tooltips with rounded corners on MacOS.
 // More investigation is need to make it work on Windows.
@@ -4754,10 +5065,10 @@ void QlementineStyle::polish(QWidget* w) {
 
   // Special case for the Qt-private buttons in a QLineEdit.
   if (w->inherits("QLineEditIconButton")) {
-    w->installEventFilter(new LineEditButtonEventFilter(this, _impl->animations, qobject_cast<QToolButton*>(w)));
+    _impl->events.addLineEditButton(static_cast<QToolButton*>(w));
     w->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
     // Fix hardcoded width in qlineedit_p.cpp:493
-    w->setFixedSize(_impl->theme.controlHeightMedium, _impl->theme.controlHeightMedium);
+    w->setFixedSize(_impl->theme->controlHeightMedium, _impl->theme->controlHeightMedium);
   }
 
   // Prevent the following warning:
@@ -4774,17 +5085,17 @@ void QlementineStyle::polish(QWidget* w) {
   }
 
   // Enable hover state.
-  if (shouldHaveHoverEvents(w)) {
+  if (traits.testFlag(WidgetTrait::HoverEvents)) {
     w->setAttribute(Qt::WA_Hover, true);
     w->setAttribute(Qt::WA_OpaquePaintEvent, false);
   }
-  if (shouldHaveMouseTracking(w)) {
+  if (traits.testFlag(WidgetTrait::MouseTracking)) {
     w->setMouseTracking(true);
   }
 
   // QFocusFrame is used to draw focus outside of the widget's bound.
   if (shouldHaveExternalFocusFrame(w)) {
-    w->installEventFilter(new WidgetWithFocusFrameEventFilter(w));
+    _impl->events.addExternalFocusFrame(w);
   }
 
   // Hijack the default focus policy for buttons.
@@ -4804,7 +5115,7 @@ void QlementineStyle::polish(QWidget* w) {
     menu->setProperty("_q_windowsDropShadow", false);
 
     // Place the QMenu correctly by making up for the drop shadow margins.
-    menu->installEventFilter(new MenuEventFilter(menu));
+    _impl->events.addMenu(menu);
   }
 
   // Try to remove the background...
@@ -4820,15 +5131,18 @@ void QlementineStyle::polish(QWidget* w) {
       popup->setProperty("_q_windowsDropShadow", false);
 
       // Same shadow as QMenu.
-      const auto shadowWidth = _impl->theme.spacing;
-      const auto borderWidth = _impl->theme.borderWidth;
+      const auto shadowWidth = _impl->theme->spacing;
+      const auto borderWidth = _impl->theme->borderWidth;
       const auto margin = shadowWidth + borderWidth;
       popup->layout()->setContentsMargins(margin, margin, margin, margin);
 
       itemView->viewport()->setAutoFillBackground(false);
       auto* comboBox = findFirstParentOfType<QComboBox>(itemView);
-      new ComboboxItemViewFilter(comboBox, itemView);
+      _impl->events.addComboBoxItemView(comboBox, itemView);
     }
+
+    // Cache the facts shared by all the cells of a paint pass.
+    _impl->events.addItemView(itemView);
   }
 
   // Ensure widgets are not compressed vertically.
@@ -4848,7 +5162,7 @@ void QlementineStyle::polish(QWidget* w) {
     if (w->focusPolicy() == Qt::WheelFocus) {
       w->setFocusPolicy(Qt::StrongFocus);
     }
-    w->installEventFilter(new MouseWheelBlockerEventFilter(w));
+    _impl->events.addMouseWheelBlocker(w);
   }
 
   if (auto* comboBox = qobject_cast<QComboBox*>(w)) {
@@ -4857,9 +5171,9 @@ void QlementineStyle::polish(QWidget* w) {
     // Will define a delegate to stylize the QComboBox items,
     comboBox->setItemDelegate(new ComboBoxDelegate(comboBox, *this));
     // Trigger the redefine when the QComboBox's view changes.
-    new ComboboxFilter(comboBox);
+    _impl->events.addComboBox(comboBox);
   } else if (auto* tabBar = qobject_cast<QTabBar*>(w)) {
-    tabBar->installEventFilter(new TabBarEventFilter(tabBar));
+    _impl->events.addTabBar(tabBar);
   } else if (auto* label = qobject_cast<QLabel*>(w)) {
     const auto labelObjName = label->objectName();
     const auto isInformativeLabel = labelObjName == QStringLiteral("qt_msgbox_informativelabel");
@@ -4870,7 +5184,7 @@ void QlementineStyle::polish(QWidget* w) {
 
   if (auto* messageBox = qobject_cast<QMessageBox*>(w)) {
     if (auto* textEdit = messageBox->findChild<QTextEdit*>()) {
-      textEdit->document()->setDocumentMargin(_impl->theme.spacing * 2);
+      textEdit->document()->setDocumentMargin(_impl->theme->spacing * 2);
     }
   }
 
@@ -4886,25 +5200,21 @@ void QlementineStyle::polish(QWidget* w) {
 
   // Make the QPlainTextEdit have a frame by default.
   if (auto* plainTextEdit = qobject_cast<QPlainTextEdit*>(w)) {
-    plainTextEdit->installEventFilter(new TextEditEventFilter(plainTextEdit));
+    _impl->events.addTextEditFrame(plainTextEdit);
     if (auto* viewport = plainTextEdit->findChild<QWidget*>(QStringLiteral("qt_scrollarea_viewport"))) {
       viewport->setAutoFillBackground(false);
     }
   }
   // Make the QTextEdit have a frame by default.
   if (auto* textEdit = qobject_cast<QTextEdit*>(w)) {
-    textEdit->installEventFilter(new TextEditEventFilter(textEdit));
+    _impl->events.addTextEditFrame(textEdit);
     if (auto* viewport = textEdit->findChild<QWidget*>(QStringLiteral("qt_scrollarea_viewport"))) {
       viewport->setAutoFillBackground(false);
     }
   }
 
-  if (auto* lineEdit = qobject_cast<QLineEdit*>(w)) {
-    lineEdit->installEventFilter(new LineEditMenuEventFilter(lineEdit));
-  } else if (auto* spinBox = qobject_cast<QSpinBox*>(w)) {
-    spinBox->installEventFilter(new LineEditMenuEventFilter(spinBox));
-  } else if (auto* plainTextEdit = qobject_cast<QPlainTextEdit*>(w)) {
-    plainTextEdit->installEventFilter(new LineEditMenuEventFilter(plainTextEdit));
+  if (qobject_cast<QLineEdit*>(w) || qobject_cast<QSpinBox*>(w) || qobject_cast<QPlainTextEdit*>(w)) {
+    _impl->events.addLineEditMenu(w);
   }
 }
 
@@ -4913,28 +5223,33 @@ void QlementineStyle::unpolish(QWidget* w) {
 
   // TODO revert all hacks made in QlementineStyle::polish(QWidget* w)
 
-  if (shouldHaveHoverEvents(w)) {
+  const auto traits = _impl->widgetTraits.traits(w);
+  _impl->widgetTraits.remove(w);
+  if (traits.testFlag(WidgetTrait::HoverEvents)) {
     w->setAttribute(Qt::WA_Hover, false);
     w->setAttribute(Qt::WA_OpaquePaintEvent, true);
   }
-  if (shouldHaveMouseTracking(w)) {
+  if (traits.testFlag(WidgetTrait::MouseTracking)) {
     w->setMouseTracking(false);
   }
+
+  _impl->events.removeWidget(w);
 }
 
 /* QStyle extended enums. */
 
 void QlementineStyle::drawPrimitiveExt(
   PrimitiveElementExt pe, const QStyleOption* opt, QPainter* p, const QWidget* w) const {
+  const NinePatchRoundedRectsScope ninePatchScope(_impl->ninePatchRoundedRects);
   switch (pe) {
     case PrimitiveElementExt::PE_CommandButtonPanel:
       if (const auto* optButton = qstyleoption_cast<const QStyleOptionCommandLinkButton*>(opt)) {
-        const auto radius = _impl->theme.borderRadius;
+        const auto radius = _impl->theme->borderRadius;
         const auto mouse = getMouseState(optButton->state);
         const auto isDefault = optButton->features.testFlag(QStyleOptionButton::DefaultButton);
         const auto role = getColorRole(optButton->state, isDefault);
-        const auto& bgColor = commandButtonBackgroundColor(mouse, role);
-        const auto& currentColor = _impl->animations.animateBackgroundColor(w, bgColor, _impl->theme.animationDuration);
+        const auto& bgColor = _impl->commandButtonBackgroundColor(mouse, role);
+        const auto& currentColor = _impl->animations.animateBackgroundColor(w, bgColor, _impl->theme->animationDuration);
         p->setPen(Qt::NoPen);
         p->setBrush(currentColor);
         p->setRenderHint(QPainter::Antialiasing, true);
@@ -4947,7 +5262,7 @@ void QlementineStyle::drawPrimitiveExt(
         p->setBrush(Qt::NoBrush);
 
         const auto& rect = optButton->rect;
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto mouse = getMouseState(optButton->state);
         const auto checked = getCheckState(optButton->state);
         const auto isDefault = optButton->features.testFlag(QStyleOptionButton::DefaultButton);
@@ -4965,7 +5280,7 @@ void QlementineStyle::drawPrimitiveExt(
           const auto& pixmap = getPixmap(icon, iconSize, mouse, checked, w);
 
           if (!pixmap.isNull() && !iconRect.isEmpty()) {
-            const auto& iconColor = commandButtonIconColor(mouse, role);
+            const auto& iconColor = _impl->commandButtonIconColor(mouse, role);
             const auto& colorizedPixmap = getColorizedPixmap(pixmap, autoIconColor(w), iconColor, iconColor);
 
             // The pixmap may be smaller than the requested size, so we center it in the rect by default.
@@ -4992,7 +5307,7 @@ void QlementineStyle::drawPrimitiveExt(
         const auto hasText = !text.isEmpty();
         const auto hasDescription = !description.isEmpty();
         const auto& fm = optButton->fontMetrics;
-        const auto& boldFm = _impl->fontMetricsBold ? *_impl->fontMetricsBold : fm;
+        const auto& boldFm = _impl->fontMetrics(FontMetricsCache::Font::Bold, w);
         const auto vSpacing = hasText && hasDescription ? spacing / 4 : 0;
         const auto textH = hasText ? boldFm.height() : 0;
         const auto descriptionH = hasDescription ? fm.height() : 0;
@@ -5006,9 +5321,9 @@ void QlementineStyle::drawPrimitiveExt(
           const auto textX = availableX;
           const auto textY = totalTextY;
           const auto textRect = QRect{ textX, textY, availableW, textH };
-          const auto& textColor = commandButtonTextColor(mouse, role);
+          const auto& textColor = _impl->commandButtonTextColor(mouse, role);
           const auto elidedText = boldFm.elidedText(text, Qt::ElideRight, availableW, Qt::TextSingleLine);
-          p->setFont(_impl->theme.fontBold);
+          p->setFont(_impl->theme->fontBold);
           p->setPen(textColor);
           p->drawText(textRect, textFlags, elidedText);
         }
@@ -5017,9 +5332,9 @@ void QlementineStyle::drawPrimitiveExt(
           const auto descriptionX = availableX;
           const auto descriptionY = totalTextY + textH + vSpacing;
           const auto descriptionRect = QRect{ descriptionX, descriptionY, availableW, descriptionH };
-          const auto& descriptionColor = commandButtonDescriptionColor(mouse, role);
+          const auto& descriptionColor = _impl->commandButtonDescriptionColor(mouse, role);
           const auto elidedDescription = fm.elidedText(description, Qt::ElideRight, availableW, Qt::TextSingleLine);
-          p->setFont(_impl->theme.fontRegular);
+          p->setFont(_impl->theme->fontRegular);
           p->setPen(descriptionColor);
           p->drawText(descriptionRect, textFlags, elidedDescription);
         }
@@ -5035,26 +5350,25 @@ void QlementineStyle::drawPrimitiveExt(
 QIcon QlementineStyle::standardIconExt(StandardPixmapExt sp, const QStyleOption* opt, const QWidget* w) const {
   Q_UNUSED(opt);
   Q_UNUSED(w);
-  return _impl->getStandardIconExt(sp, _impl->theme.iconSize);
+  return _impl->getStandardIconExt(sp, _impl->theme->iconSize);
 }
 
 QSize QlementineStyle::sizeFromContentsExt(
   ContentsTypeExt ct, const QStyleOption* opt, const QSize& s, const QWidget* w) const {
   Q_UNUSED(s);
-  Q_UNUSED(w);
 
   switch (ct) {
     case ContentsTypeExt::CT_CommandButton:
       if (const auto* optButton = qstyleoption_cast<const QStyleOptionCommandLinkButton*>(opt)) {
         const auto iconSize = optButton->iconSize;
         const auto& icon = optButton->icon;
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto hPadding = spacing * 2;
         const auto vPadding = spacing;
         const auto vSpacing = spacing / 4;
         const auto iconW = icon.isNull() ? 0 : iconSize.width() + spacing * 2;
         const auto& fm = optButton->fontMetrics;
-        const auto& boldFm = _impl->fontMetricsBold ? *_impl->fontMetricsBold : fm;
+        const auto& boldFm = _impl->fontMetrics(FontMetricsCache::Font::Bold, w);
         const auto textW = fm.boundingRect(optButton->rect, Qt::AlignLeft, optButton->text).width();
         const auto descriptionW = fm.boundingRect(optButton->rect, Qt::AlignLeft, optButton->description).width();
         const auto width = hPadding * 2 + iconW + std::max(textW, descriptionW);
@@ -5070,6 +5384,7 @@ QSize QlementineStyle::sizeFromContentsExt(
 
 void QlementineStyle::drawControlExt(
   ControlElementExt ce, const QStyleOption* opt, QPainter* p, const QWidget* w) const {
+  const NinePatchRoundedRectsScope ninePatchScope(_impl->ninePatchRoundedRects);
   switch (ce) {
     case ControlElementExt::CE_CommandButton:
       if (const auto* optButton = qstyleoption_cast<const QStyleOptionCommandLinkButton*>(opt)) {
@@ -5077,7 +5392,7 @@ void QlementineStyle::drawControlExt(
         drawPrimitiveExt(PrimitiveElementExt::PE_CommandButtonPanel, optButton, p, w);
 
         // Button foreground (text, descrption and icon).
-        const auto spacing = _impl->theme.spacing;
+        const auto spacing = _impl->theme->spacing;
         const auto hPadding = spacing * 2;
         const auto vPadding = spacing;
         const auto fgRect = optButton->rect.marginsRemoved(QMargins{ hPadding, vPadding, hPadding, vPadding });
@@ -5098,7 +5413,7 @@ int QlementineStyle::pixelMetricExt(PixelMetricExt m, const QStyleOption* opt, c
   switch (m) {
     // Icons.
     case PixelMetricExt::PM_MediumIconSize:
-      return _impl->theme.iconSizeMedium.height();
+      return _impl->theme->iconSizeMedium.height();
     default:
       return 0;
   }
@@ -5111,24 +5426,24 @@ QColor const& QlementineStyle::color(MouseState const mouse, ColorRole const rol
 
   switch (mouse) {
     case MouseState::Pressed:
-      return primary ? _impl->theme.primaryColorPressed : _impl->theme.secondaryColorPressed;
+      return primary ? _impl->theme->primaryColorPressed : _impl->theme->secondaryColorPressed;
     case MouseState::Hovered:
-      return primary ? _impl->theme.primaryColorHovered : _impl->theme.secondaryColorHovered;
+      return primary ? _impl->theme->primaryColorHovered : _impl->theme->secondaryColorHovered;
     case MouseState::Disabled:
-      return primary ? _impl->theme.primaryColorDisabled : _impl->theme.secondaryColorDisabled;
+      return primary ? _impl->theme->primaryColorDisabled : _impl->theme->secondaryColorDisabled;
     case MouseState::Transparent:
-      return primary ? _impl->theme.primaryColorTransparent : _impl->theme.secondaryColorTransparent;
+      return primary ? _impl->theme->primaryColorTransparent : _impl->theme->secondaryColorTransparent;
     case MouseState::Normal:
     default:
-      return primary ? _impl->theme.primaryColor : _impl->theme.secondaryColor;
+      return primary ? _impl->theme->primaryColor : _impl->theme->secondaryColor;
   }
 }
 
 QColor const& QlementineStyle::frameBackgroundColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.backgroundColorMainTransparent;
+    return _impl->theme->backgroundColorMainTransparent;
   else
-    return _impl->theme.backgroundColorMain1;
+    return _impl->theme->backgroundColorMain1;
 }
 
 QColor const& QlementineStyle::buttonBackgroundColor(
@@ -5138,16 +5453,16 @@ QColor const& QlementineStyle::buttonBackgroundColor(
 
   switch (mouse) {
     case MouseState::Pressed:
-      return primary ? _impl->theme.primaryColorPressed : _impl->theme.neutralColorPressed;
+      return primary ? _impl->theme->primaryColorPressed : _impl->theme->neutralColorPressed;
     case MouseState::Hovered:
-      return primary ? _impl->theme.primaryColorHovered : _impl->theme.neutralColorHovered;
+      return primary ? _impl->theme->primaryColorHovered : _impl->theme->neutralColorHovered;
     case MouseState::Disabled:
-      return primary ? _impl->theme.primaryColorDisabled : _impl->theme.neutralColorDisabled;
+      return primary ? _impl->theme->primaryColorDisabled : _impl->theme->neutralColorDisabled;
     case MouseState::Transparent:
-      return primary ? _impl->theme.primaryColorTransparent : _impl->theme.neutralColorTransparent;
+      return primary ? _impl->theme->primaryColorTransparent : _impl->theme->neutralColorTransparent;
     case MouseState::Normal:
     default:
-      return primary ? _impl->theme.primaryColor : _impl->theme.neutralColor;
+      return primary ? _impl->theme->primaryColor : _impl->theme->neutralColor;
   }
 }
 
@@ -5158,15 +5473,15 @@ QColor const& QlementineStyle::buttonForegroundColor(
 
   switch (mouse) {
     case MouseState::Pressed:
-      return primary ? _impl->theme.primaryColorForegroundPressed : _impl->theme.secondaryColor;
+      return primary ? _impl->theme->primaryColorForegroundPressed : _impl->theme->secondaryColor;
     case MouseState::Hovered:
-      return primary ? _impl->theme.primaryColorForegroundHovered : _impl->theme.secondaryColor;
+      return primary ? _impl->theme->primaryColorForegroundHovered : _impl->theme->secondaryColor;
     case MouseState::Disabled:
-      return primary ? _impl->theme.primaryColorForegroundDisabled : _impl->theme.secondaryColorDisabled;
+      return primary ? _impl->theme->primaryColorForegroundDisabled : _impl->theme->secondaryColorDisabled;
     case MouseState::Transparent:
     case MouseState::Normal:
     default:
-      return primary ? _impl->theme.primaryColorForeground : _impl->theme.secondaryColor;
+      return primary ? _impl->theme->primaryColorForeground : _impl->theme->secondaryColor;
   }
 }
 
@@ -5175,15 +5490,15 @@ QColor const& QlementineStyle::toolButtonBackgroundColor(MouseState const mouse,
 
   switch (mouse) {
     case MouseState::Pressed:
-      return primary ? _impl->theme.primaryColorPressed : _impl->theme.neutralColorHovered;
+      return primary ? _impl->theme->primaryColorPressed : _impl->theme->neutralColorHovered;
     case MouseState::Hovered:
-      return primary ? _impl->theme.primaryColorHovered : _impl->theme.neutralColor;
+      return primary ? _impl->theme->primaryColorHovered : _impl->theme->neutralColor;
     case MouseState::Disabled:
-      return primary ? _impl->theme.primaryColorDisabled : _impl->theme.neutralColorTransparent;
+      return primary ? _impl->theme->primaryColorDisabled : _impl->theme->neutralColorTransparent;
     case MouseState::Transparent:
     case MouseState::Normal:
     default:
-      return primary ? _impl->theme.primaryColor : _impl->theme.neutralColorTransparent;
+      return primary ? _impl->theme->primaryColor : _impl->theme->neutralColorTransparent;
   }
 }
 
@@ -5192,9 +5507,9 @@ QColor const& QlementineStyle::toolButtonForegroundColor(MouseState const mouse,
 
   switch (mouse) {
     case MouseState::Disabled:
-      return primary ? _impl->theme.primaryColorForegroundDisabled : _impl->theme.secondaryColorDisabled;
+      return primary ? _impl->theme->primaryColorForegroundDisabled : _impl->theme->secondaryColorDisabled;
     default:
-      return primary ? _impl->theme.primaryColorForeground : _impl->theme.secondaryColor;
+      return primary ? _impl->theme->primaryColorForeground : _impl->theme->secondaryColor;
   }
 }
 
@@ -5202,14 +5517,14 @@ QColor const& QlementineStyle::toolButtonSeparatorColor(MouseState const mouse,
   Q_UNUSED(role)
   switch (mouse) {
     case MouseState::Pressed:
-      return _impl->theme.neutralColorPressed;
+      return _impl->theme->neutralColorPressed;
     case MouseState::Hovered:
-      return _impl->theme.neutralColorHovered;
+      return _impl->theme->neutralColorHovered;
     case MouseState::Normal:
-      return _impl->theme.neutralColor;
+      return _impl->theme->neutralColor;
     case MouseState::Disabled:
     default:
-      return _impl->theme.neutralColorDisabled;
+      return _impl->theme->neutralColorDisabled;
   }
 }
 
@@ -5226,9 +5541,9 @@ QColor const& QlementineStyle::commandButtonDescriptionColor(MouseState const mo
 
   switch (mouse) {
     case MouseState::Disabled:
-      return primary ? _impl->theme.primaryColorForegroundDisabled : _impl->theme.secondaryAlternativeColorDisabled;
+      return primary ? _impl->theme->primaryColorForegroundDisabled : _impl->theme->secondaryAlternativeColorDisabled;
     default:
-      return primary ? _impl->theme.primaryColorForegroundDisabled : _impl->theme.secondaryAlternativeColor;
+      return primary ? _impl->theme->primaryColorForegroundDisabled : _impl->theme->secondaryAlternativeColor;
   }
 }
 
@@ -5245,11 +5560,11 @@ QColor const& QlementineStyle::checkButtonBackgroundColor(MouseState const mouse
     default:
       switch (mouse) {
         case MouseState::Pressed:
-          return _impl->theme.backgroundColorMain3;
+          return _impl->theme->backgroundColorMain3;
         case MouseState::Disabled:
-          return _impl->theme.backgroundColorMain2;
+          return _impl->theme->backgroundColorMain2;
         default:
-          return _impl->theme.backgroundColorMain1;
+          return _impl->theme->backgroundColorMain1;
       }
   }
 }
@@ -5268,17 +5583,17 @@ QColor const& QlementineStyle::checkButtonBorderColor(
     case CheckState::NotChecked:
     default:
       if (focus == FocusState::Focused)
-        return _impl->theme.primaryColor;
+        return _impl->theme->primaryColor;
 
       switch (mouse) {
         case MouseState::Hovered:
-          return _impl->theme.borderColorHovered;
+          return _impl->theme->borderColorHovered;
         case MouseState::Pressed:
-          return _impl->theme.borderColorPressed;
+          return _impl->theme->borderColorPressed;
         case MouseState::Disabled:
-          return _impl->theme.borderColorDisabled;
+          return _impl->theme->borderColorDisabled;
         default:
-          return _impl->theme.borderColor;
+          return _impl->theme->borderColor;
       }
   }
 }
@@ -5308,11 +5623,11 @@ QColor const& QlementineStyle::comboBoxTextColor(MouseState const mouse, Status
   Q_UNUSED(w);
   switch (status) {
     case Status::Error:
-      return _impl->theme.statusColorError;
+      return _impl->theme->statusColorError;
     case Status::Warning:
-      return _impl->theme.statusColorWarning;
+      return _impl->theme->statusColorWarning;
     case Status::Success:
-      return _impl->theme.statusColorSuccess;
+      return _impl->theme->statusColorSuccess;
     case Status::Info:
     case Status::Default:
     default:
@@ -5340,7 +5655,7 @@ QColor const& QlementineStyle::listItemRowBackgroundColor(
   MouseState const mouse, AlternateState const alternate) const {
   const auto isAlternate = alternate == AlternateState::Alternate;
   const auto isEnabled = mouse != MouseState::Disabled;
-  return _impl->theme.palette.color(isEnabled ? QPalette::ColorGroup::Normal : QPalette::ColorGroup::Disabled,
+  return _impl->theme->palette.color(isEnabled ? QPalette::ColorGroup::Normal : QPalette::ColorGroup::Disabled,
     isAlternate ? QPalette::ColorRole::AlternateBase : QPalette::ColorRole::Base);
 }
 
@@ -5354,28 +5669,28 @@ QColor QlementineStyle::listItemBackgroundColor(MouseState const mouse, Selectio
   if (isActive) {
     switch (mouse) {
       case MouseState::Pressed:
-        return isSelected ? _impl->theme.primaryColor : _impl->theme.neutralColor;
+        return isSelected ? _impl->theme->primaryColor : _impl->theme->neutralColor;
       case MouseState::Hovered:
-        return isSelected ? _impl->theme.primaryColor : _impl->theme.neutralColorDisabled;
+        return isSelected ? _impl->theme->primaryColor : _impl->theme->neutralColorDisabled;
       case MouseState::Disabled:
-        return isSelected ? _impl->theme.primaryColorDisabled : _impl->theme.neutralColorTransparent;
+        return isSelected ? _impl->theme->primaryColorDisabled : _impl->theme->neutralColorTransparent;
       case MouseState::Transparent:
       case MouseState::Normal:
       default:
-        return isSelected ? _impl->theme.primaryColor : _impl->theme.neutralColorTransparent;
+        return isSelected ? _impl->theme->primaryColor : _impl->theme->neutralColorTransparent;
     }
   } else {
     switch (mouse) {
       case MouseState::Pressed:
-        return isSelected ? _impl->theme.neutralColor : _impl->theme.neutralColor;
+        return isSelected ? _impl->theme->neutralColor : _impl->theme->neutralColor;
       case MouseState::Hovered:
-        return isSelected ? _impl->theme.neutralColor : _impl->theme.neutralColorDisabled;
+        return isSelected ? _impl->theme->neutralColor : _impl->theme->neutralColorDisabled;
       case MouseState::Disabled:
-        return isSelected ? _impl->theme.neutralColor : _impl->theme.neutralColorTransparent;
+        return isSelected ? _impl->theme->neutralColor : _impl->theme->neutralColorTransparent;
       case MouseState::Transparent:
       case MouseState::Normal:
       default:
-        return isSelected ? _impl->theme.neutralColor : _impl->theme.neutralColorTransparent;
+        return isSelected ? _impl->theme->neutralColor : _impl->theme->neutralColorTransparent;
     }
   }
 }
@@ -5389,24 +5704,24 @@ QColor const& QlementineStyle::listItemForegroundColor(
   if (isActive) {
     switch (mouse) {
       case MouseState::Disabled:
-        return isSelected ? _impl->theme.primaryColorForegroundDisabled : _impl->theme.secondaryColorDisabled;
+        return isSelected ? _impl->theme->primaryColorForegroundDisabled : _impl->theme->secondaryColorDisabled;
       case MouseState::Hovered:
       case MouseState::Pressed:
       case MouseState::Transparent:
       case MouseState::Normal:
       default:
-        return isSelected ? _impl->theme.primaryColorForeground : _impl->theme.secondaryColor;
+        return isSelected ? _impl->theme->primaryColorForeground : _impl->theme->secondaryColor;
     }
   } else {
     switch (mouse) {
       case MouseState::Disabled:
-        return _impl->theme.secondaryColorDisabled;
+        return _impl->theme->secondaryColorDisabled;
       case MouseState::Hovered:
       case MouseState::Pressed:
       case MouseState::Transparent:
       case MouseState::Normal:
       default:
-        return _impl->theme.secondaryColor;
+        return _impl->theme->secondaryColor;
     }
   }
 }
@@ -5432,25 +5747,25 @@ QColor const& QlementineStyle::listItemCaptionForegroundColor(
   if (isActive) {
     switch (mouse) {
       case MouseState::Disabled:
-        return isSelected ? _impl->theme.primaryColorForegroundDisabled
-                          : _impl->theme.secondaryAlternativeColorDisabled;
+        return isSelected ? _impl->theme->primaryColorForegroundDisabled
+                          : _impl->theme->secondaryAlternativeColorDisabled;
       case MouseState::Hovered:
       case MouseState::Pressed:
       case MouseState::Transparent:
       case MouseState::Normal:
       default:
-        return isSelected ? _impl->theme.primaryColorForeground : _impl->theme.secondaryAlternativeColor;
+        return isSelected ? _impl->theme->primaryColorForeground : _impl->theme->secondaryAlternativeColor;
     }
   } else {
     switch (mouse) {
       case MouseState::Disabled:
-        return _impl->theme.secondaryAlternativeColorDisabled;
+        return _impl->theme->secondaryAlternativeColorDisabled;
       case MouseState::Hovered:
       case MouseState::Pressed:
       case MouseState::Transparent:
       case MouseState::Normal:
       default:
-        return _impl->theme.secondaryAlternativeColor;
+        return _impl->theme->secondaryAlternativeColor;
     }
   }
 }
@@ -5463,15 +5778,15 @@ QColor const& QlementineStyle::listItemCheckButtonBackgroundColor(
   switch (selected) {
     case SelectionState::Selected:
       if (isEnabled)
-        return isChecked ? _impl->theme.primaryAlternativeColor : _impl->theme.backgroundColorMain1;
+        return isChecked ? _impl->theme->primaryAlternativeColor : _impl->theme->backgroundColorMain1;
       else
-        return isChecked ? _impl->theme.primaryAlternativeColorDisabled : _impl->theme.neutralColorDisabled;
+        return isChecked ? _impl->theme->primaryAlternativeColorDisabled : _impl->theme->neutralColorDisabled;
     case SelectionState::NotSelected:
     default:
       if (isEnabled)
-        return isChecked ? _impl->theme.primaryColor : _impl->theme.backgroundColorMain1;
+        return isChecked ? _impl->theme->primaryColor : _impl->theme->backgroundColorMain1;
       else
-        return isChecked ? _impl->theme.primaryColorDisabled : _impl->theme.backgroundColorMain2;
+        return isChecked ? _impl->theme->primaryColorDisabled : _impl->theme->backgroundColorMain2;
   }
 }
 
@@ -5483,15 +5798,15 @@ QColor const& QlementineStyle::listItemCheckButtonBorderColor(
   switch (selected) {
     case SelectionState::Selected:
       if (isEnabled)
-        return isChecked ? _impl->theme.primaryAlternativeColorTransparent : _impl->theme.primaryColor;
+        return isChecked ? _impl->theme->primaryAlternativeColorTransparent : _impl->theme->primaryColor;
       else
-        return isChecked ? _impl->theme.primaryAlternativeColorTransparent : _impl->theme.borderColorTransparent;
+        return isChecked ? _impl->theme->primaryAlternativeColorTransparent : _impl->theme->borderColorTransparent;
     case SelectionState::NotSelected:
     default:
       if (isEnabled)
-        return isChecked ? _impl->theme.primaryColor : _impl->theme.borderColor;
+        return isChecked ? _impl->theme->primaryColor : _impl->theme->borderColor;
       else
-        return isChecked ? _impl->theme.primaryColorDisabled : _impl->theme.borderColorDisabled;
+        return isChecked ? _impl->theme->primaryColorDisabled : _impl->theme->borderColorDisabled;
   }
 }
 
@@ -5506,87 +5821,87 @@ QColor const& QlementineStyle::cellItemFocusBorderColor(
   FocusState const focus, SelectionState const selected, ActiveState const active) const {
   Q_UNUSED(active)
   if (selected == SelectionState::Selected)
-    return focus == FocusState::Focused ? _impl->theme.neutralColorPressed : _impl->theme.neutralColorTransparent;
+    return focus == FocusState::Focused ? _impl->theme->neutralColorPressed : _impl->theme->neutralColorTransparent;
   else
-    return focus == FocusState::Focused ? _impl->theme.primaryColor : _impl->theme.primaryColorTransparent;
+    return focus == FocusState::Focused ? _impl->theme->primaryColor : _impl->theme->primaryColorTransparent;
 }
 
 QColor const& QlementineStyle::menuBackgroundColor() const {
-  return _impl->theme.backgroundColorMain1;
+  return _impl->theme->backgroundColorMain1;
 }
 
 QColor const& QlementineStyle::menuBorderColor() const {
-  return _impl->theme.borderColor;
+  return _impl->theme->borderColor;
 }
 
 QColor const& QlementineStyle::menuSeparatorColor() const {
-  return _impl->theme.borderColorDisabled;
+  return _impl->theme->borderColorDisabled;
 }
 
 QColor const& QlementineStyle::menuItemBackgroundColor(MouseState const mouse) const {
   switch (mouse) {
     case MouseState::Hovered:
-      return _impl->theme.primaryColor;
+      return _impl->theme->primaryColor;
     case MouseState::Pressed:
-      return _impl->theme.primaryColorHovered;
+      return _impl->theme->primaryColorHovered;
     case MouseState::Disabled:
     case MouseState::Transparent:
     case MouseState::Normal:
     default:
-      return _impl->theme.primaryColorTransparent;
+      return _impl->theme->primaryColorTransparent;
   }
 }
 
 QColor const& QlementineStyle::menuItemForegroundColor(MouseState const mouse) const {
   switch (mouse) {
     case MouseState::Hovered:
-      return _impl->theme.primaryColorForegroundHovered;
+      return _impl->theme->primaryColorForegroundHovered;
     case MouseState::Pressed:
-      return _impl->theme.primaryColorForegroundPressed;
+      return _impl->theme->primaryColorForegroundPressed;
     case MouseState::Disabled:
-      return _impl->theme.secondaryColorDisabled;
+      return _impl->theme->secondaryColorDisabled;
     case MouseState::Transparent:
     case MouseState::Normal:
     default:
-      return _impl->theme.secondaryColor;
+      return _impl->theme->secondaryColor;
   }
 }
 
 QColor const& QlementineStyle::menuItemSecondaryForegroundColor(MouseState const mouse) const {
   switch (mouse) {
     case MouseState::Hovered:
-      return _impl->theme.primaryColorForegroundHovered;
+      return _impl->theme->primaryColorForegroundHovered;
     case MouseState::Pressed:
-      return _impl->theme.primaryColorForegroundPressed;
+      return _impl->theme->primaryColorForegroundPressed;
     case MouseState::Disabled:
-      return _impl->theme.secondaryAlternativeColorDisabled;
+      return _impl->theme->secondaryAlternativeColorDisabled;
     case MouseState::Transparent:
     case MouseState::Normal:
     default:
-      return _impl->theme.secondaryAlternativeColor;
+      return _impl->theme->secondaryAlternativeColor;
   }
 }
 
 QColor const& QlementineStyle::menuBarBackgroundColor() const {
-  return _impl->theme.backgroundColorMain2;
+  return _impl->theme->backgroundColorMain2;
 }
 
 QColor const& QlementineStyle::menuBarBorderColor() const {
-  return _impl->theme.borderColor;
+  return _impl->theme->borderColor;
 }
 
 QColor const& QlementineStyle::menuBarItemBackgroundColor(MouseState const mouse, SelectionState const selected) const {
   Q_UNUSED(selected)
   switch (mouse) {
     case MouseState::Hovered:
-      return _impl->theme.neutralColorDisabled;
+      return _impl->theme->neutralColorDisabled;
     case MouseState::Pressed:
-      return _impl->theme.neutralColor;
+      return _impl->theme->neutralColor;
     case MouseState::Disabled:
     case MouseState::Transparent:
     case MouseState::Normal:
     default:
-      return _impl->theme.neutralColorTransparent;
+      return _impl->theme->neutralColorTransparent;
   }
 }
 
@@ -5594,41 +5909,41 @@ QColor const& QlementineStyle::menuBarItemForegroundColor(MouseState const mouse
   Q_UNUSED(selected)
   switch (mouse) {
     case MouseState::Hovered:
-      return _impl->theme.secondaryColor;
+      return _impl->theme->secondaryColor;
     case MouseState::Pressed:
-      return _impl->theme.secondaryColor;
+      return _impl->theme->secondaryColor;
     case MouseState::Disabled:
-      return _impl->theme.secondaryColorDisabled;
+      return _impl->theme->secondaryColorDisabled;
     case MouseState::Transparent:
     case MouseState::Normal:
     default:
-      return _impl->theme.secondaryColor;
+      return _impl->theme->secondaryColor;
   }
 }
 
 QColor const& QlementineStyle::tabBarBackgroundColor(MouseState const mouse) const {
-  return mouse == MouseState::Disabled ? _impl->theme.backgroundColorMain3 : _impl->theme.backgroundColorTabBar;
+  return mouse == MouseState::Disabled ? _impl->theme->backgroundColorMain3 : _impl->theme->backgroundColorTabBar;
 }
 
 QColor const& QlementineStyle::tabBarShadowColor() const {
-  return _impl->theme.shadowColor1;
+  return _impl->theme->shadowColor1;
 }
 
 QColor const& QlementineStyle::tabBarBottomShadowColor() const {
-  return _impl->theme.shadowColor1;
+  return _impl->theme->shadowColor1;
 }
 
 QColor const& QlementineStyle::tabBackgroundColor(MouseState const mouse, SelectionState const selected) const {
   const auto isSelected = selected == SelectionState::Selected;
-  const auto& selectedTabColor = _impl->theme.backgroundColorMain2;
-  const auto& hoverTabColor = _impl->theme.neutralColor;
-  const auto& defaultTabColor = _impl->theme.backgroundColorMainTransparent;
+  const auto& selectedTabColor = _impl->theme->backgroundColorMain2;
+  const auto& hoverTabColor = _impl->theme->neutralColor;
+  const auto& defaultTabColor = _impl->theme->backgroundColorMainTransparent;
 
   switch (mouse) {
     case MouseState::Hovered:
       return isSelected ? selectedTabColor : hoverTabColor;
     case MouseState::Pressed:
-      return _impl->theme.backgroundColorMain2;
+      return _impl->theme->backgroundColorMain2;
     case MouseState::Normal:
       return isSelected ? selectedTabColor : defaultTabColor;
     case MouseState::Disabled:
@@ -5655,14 +5970,14 @@ QColor const& QlementineStyle::tabCloseButtonBackgroundColor(
   const auto isSelected = selected == SelectionState::Selected;
   switch (mouse) {
     case MouseState::Pressed:
-      return isSelected ? _impl->theme.neutralColorPressed : _impl->theme.semiTransparentColor4;
+      return isSelected ? _impl->theme->neutralColorPressed : _impl->theme->semiTransparentColor4;
     case MouseState::Hovered:
-      return isSelected ? _impl->theme.neutralColor : _impl->theme.semiTransparentColor2;
+      return isSelected ? _impl->theme->neutralColor : _impl->theme->semiTransparentColor2;
     case MouseState::Normal:
     case MouseState::Disabled:
     case MouseState::Transparent:
     default:
-      return isSelected ? _impl->theme.neutralColorTransparent : _impl->theme.semiTransparentColorTransparent;
+      return isSelected ? _impl->theme->neutralColorTransparent : _impl->theme->semiTransparentColorTransparent;
   }
 }
 
@@ -5672,228 +5987,228 @@ QColor const& QlementineStyle::tabCloseButtonForegroundColor(
     case MouseState::Pressed:
     case MouseState::Hovered:
     case MouseState::Normal:
-      return _impl->theme.secondaryColor;
+      return _impl->theme->secondaryColor;
     case MouseState::Disabled:
     case MouseState::Transparent:
-      return _impl->theme.secondaryColorTransparent;
+      return _impl->theme->secondaryColorTransparent;
     default:
-      return selected == SelectionState::Selected ? _impl->theme.secondaryColor
-                                                  : _impl->theme.secondaryColorTransparent;
+      return selected == SelectionState::Selected ? _impl->theme->secondaryColor
+                                                  : _impl->theme->secondaryColorTransparent;
   }
 }
 
 QColor const& QlementineStyle::tabBarScrollButtonBackgroundColor(MouseState const mouse) const {
   switch (mouse) {
     case MouseState::Pressed:
-      return _impl->theme.semiTransparentColor4;
+      return _impl->theme->semiTransparentColor4;
     case MouseState::Hovered:
-      return _impl->theme.semiTransparentColor2;
+      return _impl->theme->semiTransparentColor2;
     case MouseState::Normal:
     case MouseState::Disabled:
     case MouseState::Transparent:
     default:
-      return _impl->theme.semiTransparentColorTransparent;
+      return _impl->theme->semiTransparentColorTransparent;
   }
 }
 
 QColor const& QlementineStyle::progressBarGrooveColor(MouseState const mouse) const {
-  return mouse == MouseState::Disabled ? _impl->theme.neutralColorDisabled : _impl->theme.neutralColor;
+  return mouse == MouseState::Disabled ? _impl->theme->neutralColorDisabled : _impl->theme->neutralColor;
 }
 
 QColor const& QlementineStyle::progressBarValueColor(MouseState const mouse) const {
-  return mouse == MouseState::Disabled ? _impl->theme.primaryColorDisabled : _impl->theme.primaryColor;
+  return mouse == MouseState::Disabled ? _impl->theme->primaryColorDisabled : _impl->theme->primaryColor;
 }
 
 QColor const& QlementineStyle::textFieldBackgroundColor(MouseState const mouse, Status const status) const {
   Q_UNUSED(status);
   if (mouse == MouseState::Disabled)
-    return _impl->theme.backgroundColorMain3;
+    return _impl->theme->backgroundColorMain3;
   else
-    return _impl->theme.backgroundColorMain1;
+    return _impl->theme->backgroundColorMain1;
 }
 
 QColor const& QlementineStyle::textFieldBorderColor(
   MouseState const mouse, FocusState const focus, Status const status) const {
   if (mouse == MouseState::Disabled) {
-    return _impl->theme.borderColorDisabled;
+    return _impl->theme->borderColorDisabled;
   } else {
     switch (status) {
       case Status::Error:
         if (focus == FocusState::Focused || mouse == MouseState::Hovered || mouse == MouseState::Pressed)
-          return _impl->theme.statusColorErrorHovered;
+          return _impl->theme->statusColorErrorHovered;
         else
-          return _impl->theme.statusColorError;
+          return _impl->theme->statusColorError;
       case Status::Warning:
         if (focus == FocusState::Focused || mouse == MouseState::Hovered || mouse == MouseState::Pressed)
-          return _impl->theme.statusColorWarningHovered;
+          return _impl->theme->statusColorWarningHovered;
         else
-          return _impl->theme.statusColorWarning;
+          return _impl->theme->statusColorWarning;
       case Status::Success:
         if (focus == FocusState::Focused || mouse == MouseState::Hovered || mouse == MouseState::Pressed)
-          return _impl->theme.statusColorSuccessHovered;
+          return _impl->theme->statusColorSuccessHovered;
         else
-          return _impl->theme.statusColorSuccess;
+          return _impl->theme->statusColorSuccess;
       case Status::Info:
       case Status::Default:
       default:
         if (focus == FocusState::Focused || mouse == MouseState::Hovered || mouse == MouseState::Pressed)
-          return _impl->theme.primaryColor;
+          return _impl->theme->primaryColor;
         else
-          return _impl->theme.borderColor;
+          return _impl->theme->borderColor;
     }
   }
 }
 
 QColor const& QlementineStyle::textFieldForegroundColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.secondaryColorDisabled;
+    return _impl->theme->secondaryColorDisabled;
   else
-    return _impl->theme.secondaryColor;
+    return _impl->theme->secondaryColor;
 }
 
 QColor const& QlementineStyle::sliderGrooveColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.neutralColorDisabled;
+    return _impl->theme->neutralColorDisabled;
   else
-    return _impl->theme.neutralColor;
+    return _impl->theme->neutralColor;
 }
 
 QColor const& QlementineStyle::sliderValueColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.primaryColorDisabled;
+    return _impl->theme->primaryColorDisabled;
   else
-    return _impl->theme.primaryColor;
+    return _impl->theme->primaryColor;
 }
 
 QColor const& QlementineStyle::sliderHandleColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.neutralColorDisabled;
+    return _impl->theme->neutralColorDisabled;
   else if (mouse == MouseState::Pressed)
-    return _impl->theme.primaryColorForegroundPressed;
+    return _impl->theme->primaryColorForegroundPressed;
   else if (mouse == MouseState::Hovered)
-    return _impl->theme.primaryColorForegroundHovered;
+    return _impl->theme->primaryColorForegroundHovered;
   else
-    return _impl->theme.primaryColorForeground;
+    return _impl->theme->primaryColorForeground;
 }
 
 QColor const& QlementineStyle::sliderTickColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.borderColorDisabled;
+    return _impl->theme->borderColorDisabled;
   else
-    return _impl->theme.borderColor;
+    return _impl->theme->borderColor;
 }
 
 QColor const& QlementineStyle::dialHandleColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.neutralColorDisabled;
+    return _impl->theme->neutralColorDisabled;
   else
-    return _impl->theme.neutralColor;
+    return _impl->theme->neutralColor;
 }
 
 QColor const& QlementineStyle::dialGrooveColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.neutralColorDisabled;
+    return _impl->theme->neutralColorDisabled;
   else
-    return _impl->theme.neutralColorPressed;
+    return _impl->theme->neutralColorPressed;
 }
 
 QColor const& QlementineStyle::dialValueColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.primaryColorDisabled;
+    return _impl->theme->primaryColorDisabled;
   else
-    return _impl->theme.primaryColor;
+    return _impl->theme->primaryColor;
 }
 
 QColor const& QlementineStyle::dialTickColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.neutralColorDisabled;
+    return _impl->theme->neutralColorDisabled;
   else
-    return _impl->theme.neutralColorPressed;
+    return _impl->theme->neutralColorPressed;
 }
 
 QColor const& QlementineStyle::dialMarkColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.secondaryColorDisabled;
+    return _impl->theme->secondaryColorDisabled;
   else
-    return _impl->theme.secondaryColor;
+    return _impl->theme->secondaryColor;
 }
 
 QColor const& QlementineStyle::dialBackgroundColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.neutralColorDisabled;
+    return _impl->theme->neutralColorDisabled;
   else
-    return _impl->theme.neutralColorPressed;
+    return _impl->theme->neutralColorPressed;
 }
 
 QColor const& QlementineStyle::labelForegroundColor(MouseState const mouse, const QWidget* w) const {
   Q_UNUSED(w);
   if (mouse == MouseState::Disabled)
-    return _impl->theme.secondaryColorDisabled;
+    return _impl->theme->secondaryColorDisabled;
   else
-    return _impl->theme.secondaryColor;
+    return _impl->theme->secondaryColor;
 }
 
 QColor const& QlementineStyle::labelCaptionForegroundColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled)
-    return _impl->theme.secondaryAlternativeColorDisabled;
+    return _impl->theme->secondaryAlternativeColorDisabled;
   else
-    return _impl->theme.secondaryAlternativeColor;
+    return _impl->theme->secondaryAlternativeColor;
 }
 
 QColor const& QlementineStyle::iconForegroundColor(MouseState const mouse, ColorRole const role) const {
   if (mouse == MouseState::Disabled)
-    return role == ColorRole::Primary ? _impl->theme.primaryColorForegroundDisabled
-                                      : _impl->theme.secondaryColorForegroundDisabled;
+    return role == ColorRole::Primary ? _impl->theme->primaryColorForegroundDisabled
+                                      : _impl->theme->secondaryColorForegroundDisabled;
   else
-    return role == ColorRole::Primary ? _impl->theme.primaryColorForeground : _impl->theme.secondaryColorForeground;
+    return role == ColorRole::Primary ? _impl->theme->primaryColorForeground : _impl->theme->secondaryColorForeground;
 }
 
 QColor const& QlementineStyle::toolBarBackgroundColor() const {
-  return _impl->theme.backgroundColorMain2;
+  return _impl->theme->backgroundColorMain2;
 }
 
 QColor const& QlementineStyle::toolBarBorderColor() const {
-  return _impl->theme.borderColor;
+  return _impl->theme->borderColor;
 }
 
 QColor const& QlementineStyle::toolBarSeparatorColor() const {
-  return _impl->theme.secondaryColorDisabled;
+  return _impl->theme->secondaryColorDisabled;
 }
 
 QColor const& QlementineStyle::toolTipBackgroundColor() const {
-  return _impl->theme.secondaryColor;
+  return _impl->theme->secondaryColor;
 }
 
 QColor const& QlementineStyle::toolTipBorderColor() const {
-  return _impl->theme.secondaryColorPressed;
+  return _impl->theme->secondaryColorPressed;
 }
 
 QColor const& QlementineStyle::toolTipForegroundColor() const {
-  return _impl->theme.secondaryColorForeground;
+  return _impl->theme->secondaryColorForeground;
 }
 
 QColor const& QlementineStyle::scrollBarGrooveColor(MouseState const mouse) const {
   switch (mouse) {
     case MouseState::Hovered:
     case MouseState::Pressed:
-      return _impl->theme.semiTransparentColor4;
+      return _impl->theme->semiTransparentColor4;
     default:
-      return _impl->theme.semiTransparentColorTransparent;
+      return _impl->theme->semiTransparentColorTransparent;
   }
 }
 
 QColor const& QlementineStyle::scrollBarHandleColor(MouseState const mouse) const {
   switch (mouse) {
     case MouseState::Hovered:
-      return _impl->theme.secondaryAlternativeColorHovered;
+      return _impl->theme->secondaryAlternativeColorHovered;
     case MouseState::Pressed:
-      return _impl->theme.secondaryAlternativeColorPressed;
+      return _impl->theme->secondaryAlternativeColorPressed;
     case MouseState::Disabled:
-      return _impl->theme.semiTransparentColor1;
+      return _impl->theme->semiTransparentColor1;
     case MouseState::Normal:
     case MouseState::Transparent:
     default:
-      return _impl->theme.semiTransparentColor4;
+      return _impl->theme->semiTransparentColor4;
   }
 }
 
@@ -5901,9 +6216,9 @@ int QlementineStyle::getScrollBarThickness(MouseState const mouse) const {
   switch (mouse) {
     case MouseState::Hovered:
     case MouseState::Pressed:
-      return _impl->theme.scrollBarThicknessFull;
+      return _impl->theme->scrollBarThicknessFull;
     default:
-      return _impl->theme.scrollBarThicknessSmall;
+      return _impl->theme->scrollBarThicknessSmall;
   }
 }
 
@@ -5913,15 +6228,15 @@ QColor const& QlementineStyle::groupBoxTitleColor(MouseState const mouse, const
 
 QColor QlementineStyle::groupBoxBackgroundColor(MouseState const mouse) const {
   if (mouse == MouseState::Disabled) {
-    return _impl->theme.backgroundColorMainTransparent;
+    return _impl->theme->backgroundColorMainTransparent;
   } else {
-    return getColorSourceOver(_impl->theme.backgroundColorMain2,
-      colorWithAlphaF(_impl->theme.backgroundColorMain3, _impl->theme.backgroundColorMain3.alphaF() * .75));
+    return getColorSourceOver(_impl->theme->backgroundColorMain2,
+      colorWithAlphaF(_impl->theme->backgroundColorMain3, _impl->theme->backgroundColorMain3.alphaF() * .75));
   }
 }
 
 QColor const& QlementineStyle::groupBoxBorderColor(MouseState const mouse) const {
-  return mouse == MouseState::Disabled ? _impl->theme.borderColorDisabled : _impl->theme.borderColor;
+  return mouse == MouseState::Disabled ? _impl->theme->borderColorDisabled : _impl->theme->borderColor;
 }
 
 QColor const& QlementineStyle::statusColor(Status const status, MouseState const mouse) const {
@@ -5929,48 +6244,48 @@ QColor const& QlementineStyle::statusColor(Status const status, MouseState const
     case Status::Success:
       switch (mouse) {
         case MouseState::Disabled:
-          return _impl->theme.statusColorSuccessDisabled;
+          return _impl->theme->statusColorSuccessDisabled;
         case MouseState::Pressed:
-          return _impl->theme.statusColorSuccessPressed;
+          return _impl->theme->statusColorSuccessPressed;
         case MouseState::Hovered:
-          return _impl->theme.statusColorSuccessHovered;
+          return _impl->theme->statusColorSuccessHovered;
         default:
-          return _impl->theme.statusColorSuccess;
+          return _impl->theme->statusColorSuccess;
       }
     case Status::Warning:
       switch (mouse) {
         case MouseState::Disabled:
-          return _impl->theme.statusColorWarningDisabled;
+          return _impl->theme->statusColorWarningDisabled;
         case MouseState::Pressed:
-          return _impl->theme.statusColorWarningPressed;
+          return _impl->theme->statusColorWarningPressed;
         case MouseState::Hovered:
-          return _impl->theme.statusColorWarningHovered;
+          return _impl->theme->statusColorWarningHovered;
         default:
-          return _impl->theme.statusColorWarning;
+          return _impl->theme->statusColorWarning;
       }
     case Status::Error:
       switch (mouse) {
         case MouseState::Disabled:
-          return _impl->theme.statusColorErrorDisabled;
+          return _impl->theme->statusColorErrorDisabled;
         case MouseState::Pressed:
-          return _impl->theme.statusColorErrorPressed;
+          return _impl->theme->statusColorErrorPressed;
         case MouseState::Hovered:
-          return _impl->theme.statusColorErrorHovered;
+          return _impl->theme->statusColorErrorHovered;
         default:
-          return _impl->theme.statusColorError;
+          return _impl->theme->statusColorError;
       }
     case Status::Default:
     case Status::Info:
     default:
       switch (mouse) {
         case MouseState::Disabled:
-          return _impl->theme.statusColorInfoDisabled;
+          return _impl->theme->statusColorInfoDisabled;
         case MouseState::Pressed:
-          return _impl->theme.statusColorInfoPressed;
+          return _impl->theme->statusColorInfoPressed;
         case MouseState::Hovered:
-          return _impl->theme.statusColorInfoHovered;
+          return _impl->theme->statusColorInfoHovered;
         default:
-          return _impl->theme.statusColorInfo;
+          return _impl->theme->statusColorInfo;
       }
   }
 }
@@ -5978,22 +6293,22 @@ QColor const& QlementineStyle::statusColor(Status const status, MouseState const
 QColor const& QlementineStyle::statusColorForeground(const Status, const MouseState mouse) const {
   switch (mouse) {
     case MouseState::Disabled:
-      return _impl->theme.statusColorForegroundDisabled;
+      return _impl->theme->statusColorForegroundDisabled;
     case MouseState::Pressed:
-      return _impl->theme.statusColorForegroundPressed;
+      return _impl->theme->statusColorForegroundPressed;
     case MouseState::Hovered:
-      return _impl->theme.statusColorForegroundHovered;
+      return _impl->theme->statusColorForegroundHovered;
     default:
-      return _impl->theme.statusColorForeground;
+      return _impl->theme->statusColorForeground;
   }
 }
 
 QColor QlementineStyle::focusBorderColor(Status status) const {
   if (status == Status::Default)
-    return _impl->theme.focusColor;
+    return _impl->theme->focusColor;
 
   const auto& statusColor = this->statusColor(status, MouseState::Normal);
-  const auto focusAlpha = _impl->theme.focusColor.alpha();
+  const auto focusAlpha = _impl->theme->focusColor.alpha();
   auto statusFocusColor = QColor{
     statusColor.red(),
     statusColor.green(),
@@ -6006,47 +6321,19 @@ QColor QlementineStyle::focusBorderColor(Status status) const {
 }
 
 QColor const& QlementineStyle::frameBorderColor() const {
-  return _impl->theme.borderColorDisabled;
+  return _impl->theme->borderColorDisabled;
 }
 
 QColor const& QlementineStyle::separatorColor() const {
-  return _impl->theme.borderColor;
+  return _impl->theme->borderColor;
 }
 
 const QFont& QlementineStyle::fontForTextRole(TextRole role) const {
-  switch (role) {
-    case TextRole::Caption:
-      return _impl->theme.fontCaption;
-    case TextRole::H1:
-      return _impl->theme.fontH1;
-    case TextRole::H2:
-      return _impl->theme.fontH2;
-    case TextRole::H3:
-      return _impl->theme.fontH3;
-    case TextRole::H4:
-      return _impl->theme.fontH4;
-    case TextRole::H5:
-      return _impl->theme.fontH5;
-    default:
-      return _impl->theme.fontRegular;
-  }
+  return _impl->textRoleStyle(role).font;
 }
 
-QPalette QlementineStyle::paletteForTextRole(TextRole role) const {
-  auto result = QPalette{ _impl->theme.palette };
-
-  const auto& textColor = colorForTextRole(role, MouseState::Normal);
-  const auto& textColorDisabled = colorForTextRole(role, MouseState::Disabled);
-
-  result.setColor(QPalette::ColorGroup::All, QPalette::ColorRole::Text, textColor);
-  result.setColor(QPalette::ColorGroup::All, QPalette::ColorRole::WindowText, textColor);
-  result.setColor(QPalette::ColorGroup::All, QPalette::ColorRole::BrightText, textColor);
-
-  result.setColor(QPalette::ColorGroup::Disabled, QPalette::ColorRole::Text, textColorDisabled);
-  result.setColor(QPalette::ColorGroup::Disabled, QPalette::ColorRole::WindowText, textColorDisabled);
-  result.setColor(QPalette::ColorGroup::Disabled, QPalette::ColorRole::BrightText, textColorDisabled);
-
-  return result;
+QPalette const& QlementineStyle::paletteForTextRole(TextRole role) const {
+  return _impl->textRoleStyle(role).palette;
 }
 
 QColor const& QlementineStyle::switchGrooveColor(MouseState const mouse, CheckState const checked) const {
@@ -6063,15 +6350,15 @@ QColor const& QlementineStyle::switchHandleColor(MouseState const mouse, CheckSt
 
   switch (mouse) {
     case MouseState::Pressed:
-      return primary ? _impl->theme.primaryColorForegroundPressed : _impl->theme.secondaryColorPressed;
+      return primary ? _impl->theme->primaryColorForegroundPressed : _impl->theme->secondaryColorPressed;
     case MouseState::Hovered:
-      return primary ? _impl->theme.primaryColorForegroundHovered : _impl->theme.secondaryColorHovered;
+      return primary ? _impl->theme->primaryColorForegroundHovered : _impl->theme->secondaryColorHovered;
     case MouseState::Disabled:
-      return primary ? _impl->theme.primaryColorForegroundDisabled : _impl->theme.secondaryColorDisabled;
+      return primary ? _impl->theme->primaryColorForegroundDisabled : _impl->theme->secondaryColorDisabled;
     case MouseState::Transparent:
     case MouseState::Normal:
     default:
-      return primary ? _impl->theme.primaryColorForeground : _impl->theme.secondaryColor;
+      return primary ? _impl->theme->primaryColorForeground : _impl->theme->secondaryColor;
   }
 }
 
@@ -6080,36 +6367,36 @@ QColor const& QlementineStyle::tableHeaderBgColor(MouseState const mouse, CheckS
 
   switch (mouse) {
     case MouseState::Pressed:
-      return _impl->theme.neutralColorHovered;
+      return _impl->theme->neutralColorHovered;
     case MouseState::Hovered:
-      return _impl->theme.neutralColor;
+      return _impl->theme->neutralColor;
     case MouseState::Disabled:
-      return _impl->theme.neutralColor;
+      return _impl->theme->neutralColor;
     case MouseState::Transparent:
     case MouseState::Normal:
     default:
-      return _impl->theme.backgroundColorMain3;
+      return _impl->theme->backgroundColorMain3;
   }
 }
 
 QColor const& QlementineStyle::tableHeaderFgColor(MouseState const mouse, CheckState const) const {
   switch (mouse) {
     case MouseState::Disabled:
-      return _impl->theme.secondaryColorDisabled;
+      return _impl->theme->secondaryColorDisabled;
     default:
-      return _impl->theme.secondaryColor;
+      return _impl->theme->secondaryColor;
   }
 }
 
 QColor const& QlementineStyle::tableLineColor() const {
-  return _impl->theme.borderColor;
+  return _impl->theme->borderColor;
 }
 
 QColor const& QlementineStyle::colorForTextRole(TextRole role, MouseState const mouse) const {
   switch (role) {
     case TextRole::Caption:
-      return mouse == MouseState::Disabled ? _impl->theme.secondaryAlternativeColorDisabled
-                                           : _impl->theme.secondaryAlternativeColor;
+      return mouse == MouseState::Disabled ? _impl->theme->secondaryAlternativeColorDisabled
+                                           : _impl->theme->secondaryAlternativeColor;
     case TextRole::H1:
     case TextRole::H2:
     case TextRole::H3:
@@ -6117,27 +6404,12 @@ QColor const& QlementineStyle::colorForTextRole(TextRole role, MouseState const
     case TextRole::H5:
     case TextRole::Default:
     default:
-      return mouse == MouseState::Disabled ? _impl->theme.secondaryColorDisabled : _impl->theme.secondaryColor;
+      return mouse == MouseState::Disabled ? _impl->theme->secondaryColorDisabled : _impl->theme->secondaryColor;
   }
 }
 
 int QlementineStyle::pixelSizeForTextRole(TextRole role) const {
-  switch (role) {
-    case TextRole::Caption:
-      return _impl->theme.fontSizeS1;
-    case TextRole::H1:
-      return _impl->theme.fontSizeH1;
-    case TextRole::H2:
-      return _impl->theme.fontSizeH2;
-    case TextRole::H3:
-      return _impl->theme.fontSizeH3;
-    case TextRole::H4:
-      return _impl->theme.fontSizeH4;
-    case TextRole::H5:
-      return _impl->theme.fontSizeH5;
-    default:
-      return _impl->theme.fontSize;
-  }
+  return _impl->textRoleStyle(role).pixelSize;
 }
 
 Status QlementineStyle::widgetStatus(QWidget const* widget) const {
@@ -6154,28 +6426,28 @@ Status QlementineStyle::widgetStatus(QWidget const* widget) const {
 }
 
 QColor const& QlementineStyle::statusBarBackgroundColor() const {
-  return _impl->theme.backgroundColorMain2;
+  return _impl->theme->backgroundColorMain2;
 }
 
 QColor const& QlementineStyle::statusBarBorderColor() const {
-  return _impl->theme.borderColor;
+  return _impl->theme->borderColor;
 }
 
 QColor const& QlementineStyle::statusBarSeparatorColor() const {
-  return _impl->theme.secondaryColorDisabled;
+  return _impl->theme->secondaryColorDisabled;
 }
 
 QColor const& QlementineStyle::splitterColor(const MouseState mouse) const {
   switch (mouse) {
     case MouseState::Normal:
-      return _impl->theme.borderColor;
+      return _impl->theme->borderColor;
     case MouseState::Hovered:
-      return _impl->theme.primaryColor;
+      return _impl->theme->primaryColor;
     case MouseState::Pressed:
-      return _impl->theme.primaryColorPressed;
+      return _impl->theme->primaryColorPressed;
     case MouseState::Disabled:
     default:
-      return _impl->theme.borderColorTransparent;
+      return _impl->theme->borderColorTransparent;
   }
 }
 } // namespace oclero::qlementine
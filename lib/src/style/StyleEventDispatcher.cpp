@@ -0,0 +1,785 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "StyleEventDispatcher.hpp"
+#include "eventFilters/LineEditMenuIconsBehavior.hpp"
+
+#include <oclero/qlementine/style/QlementineStyle.hpp>
+#include <oclero/qlementine/style/Delegates.hpp>
+#include <oclero/qlementine/animation/WidgetAnimationManager.hpp>
+#include <oclero/qlementine/utils/MenuUtils.hpp>
+#include <oclero/qlementine/utils/PrimitiveUtils.hpp>
+#include <oclero/qlementine/utils/StateUtils.hpp>
+
+#include <QApplication>
+#include <QAbstractScrollArea>
+#include <QChildEvent>
+#include <QComboBox>
+#include <QFocusFrame>
+#include <QLineEdit>
+#include <QMenu>
+#include <QMenuBar>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScreen>
+#include <QStyleOption>
+#include <QTabBar>
+#include <QTimer>
+#include <QToolButton>
+#include <QTreeView>
+#include <QVariantAnimation>
+#include <QWheelEvent>
+
+#include <algorithm>
+
+namespace oclero::qlementine {
+StyleEventDispatcher::StyleEventDispatcher(QlementineStyle& style, WidgetAnimationManager& animations)
+  : _style(style)
+  , _animations(animations) {}
+
+StyleEventDispatcher::Entry& StyleEventDispatcher::addBehavior(QWidget* widget, Behavior behavior, QWidget* owner) {
+  if (!_installed && qApp) {
+    // A single filter for the whole application, so widgets don't need one each.
+    qApp->installEventFilter(this);
+    _installed = true;
+  }
+
+  if (owner && owner != widget) {
+    // Remember the child, so its behaviors can be removed with the owner's ones.
+    auto& ownerEntry = addBehavior(owner, Behavior::None);
+    if (std::find(ownerEntry.children.cbegin(), ownerEntry.children.cend(), widget) == ownerEntry.children.cend()) {
+      ownerEntry.children.emplace_back(widget);
+    }
+  }
+
+  const auto [it, inserted] = _entries.try_emplace(widget);
+  auto& entry = it->second;
+  if (inserted) {
+    entry.destroyedConnection = QObject::connect(widget, &QObject::destroyed, this, [this](QObject* obj) {
+      _entries.erase(obj);
+    });
+  }
+
+  entry.behaviors |= behavior;
+  if (owner) {
+    entry.owner = owner;
+  }
+  return entry;
+}
+
+void StyleEventDispatcher::removeWidget(QWidget* widget) {
+  const auto it = _entries.find(widget);
+  if (it == _entries.end())
+    return;
+
+  if (it->second.behaviors.testFlag(Behavior::ExternalFocusFrame)) {
+    // Don't let the shared focus frame monitor a widget that has no focus frame anymore.
+    const auto frameIt = _focusFrames.find(widget->window());
+    if (frameIt != _focusFrames.end() && frameIt->second.frame && frameIt->second.frame->widget() == widget) {
+      if (frameIt->second.animation) {
+        frameIt->second.animation->stop();
+      }
+      frameIt->second.frame->setWidget(nullptr);
+    }
+  }
+
+  // Behaviors added to children for this widget (e.g. the popup of a QComboBox) are removed too.
+  // The children may still have behaviors of their own, if they have been polished themselves.
+  constexpr auto childBehaviors = Behaviors{ Behavior::TabBarScrollButton } | Behavior::ComboBoxPopup
+                                  | Behavior::ComboBoxItemView | Behavior::LineEditMenu | Behavior::ItemViewViewport;
+  const auto children = std::move(it->second.children);
+  eraseEntry(widget);
+  for (const auto& child : children) {
+    if (!child)
+      continue;
+
+    const auto childIt = _entries.find(child.data());
+    if (childIt == _entries.end() || childIt->second.owner != widget)
+      continue;
+
+    auto& childEntry = childIt->second;
+    childEntry.behaviors &= ~childBehaviors;
+    childEntry.owner = nullptr;
+    childEntry.viewportItemView = nullptr;
+    if (childEntry.behaviors == Behavior::None && !childEntry.itemViewPaintContext && childEntry.children.empty()) {
+      eraseEntry(child.data());
+    }
+  }
+}
+
+void StyleEventDispatcher::eraseEntry(QWidget* widget) {
+  const auto it = _entries.find(widget);
+  if (it == _entries.end())
+    return;
+
+  // Only this entry's connection: the widget may also be a window with a focus frame.
+  QObject::disconnect(it->second.destroyedConnection);
+  _entries.erase(it);
+}
+
+void StyleEventDispatcher::addExternalFocusFrame(QWidget* widget) {
+  addBehavior(widget, Behavior::ExternalFocusFrame);
+
+  // The widget may be repolished while focused: no FocusIn event will come.
+  if (widget->hasFocus()) {
+    QTimer::singleShot(0, widget, [this, widget]() {
+      if (widget->hasFocus()) {
+        moveFocusFrame(widget);
+      }
+    });
+  }
+}
+
+void StyleEventDispatcher::addMouseWheelBlocker(QWidget* widget) {
+  addBehavior(widget, Behavior::MouseWheelBlocker);
+}
+
+void StyleEventDispatcher::addTextEditFrame(QAbstractScrollArea* textEdit) {
+  addBehavior(textEdit, Behavior::TextEditFrame);
+}
+
+void StyleEventDispatcher::addLineEditMenu(QWidget* widget) {
+  addBehavior(widget, Behavior::LineEditMenu);
+}
+
+void StyleEventDispatcher::addTabBar(QTabBar* tabBar) {
+  auto& entry = addBehavior(tabBar, Behavior::TabBar);
+
+  // Tweak left/right buttons.
+  const auto toolButtons = tabBar->findChildren<QToolButton*>();
+  if (toolButtons.size() == 2) {
+    auto* leftButton = toolButtons.at(0);
+    leftButton->setFocusPolicy(Qt::NoFocus);
+    leftButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    leftButton->setFixedSize(leftButton->sizeHint());
+    QlementineStyle::setAutoIconColor(leftButton, AutoIconColor::None);
+
+    auto* rightButton = toolButtons.at(1);
+    rightButton->setFocusPolicy(Qt::NoFocus);
+    rightButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    rightButton->setFixedSize(rightButton->sizeHint());
+    QlementineStyle::setAutoIconColor(rightButton, AutoIconColor::None);
+
+    // Adding entries may rehash the table, but references to its elements remain valid.
+    entry.tabBarLeftButton = leftButton;
+    entry.tabBarRightButton = rightButton;
+    addBehavior(leftButton, Behavior::TabBarScrollButton, tabBar);
+    addBehavior(rightButton, Behavior::TabBarScrollButton, tabBar);
+  }
+}
+
+void StyleEventDispatcher::addMenu(QMenu* menu) {
+  addBehavior(menu, Behavior::Menu);
+}
+
+void StyleEventDispatcher::addLineEditButton(QToolButton* button) {
+  addBehavior(button, Behavior::LineEditButton);
+
+  // Qt doesn't emit this signal so we emit it by ourselves.
+  if (auto* parent = button->parentWidget()) {
+    if (const auto* lineEdit = qobject_cast<QLineEdit*>(parent)) {
+      QObject::connect(button, &QAbstractButton::clicked, lineEdit, &QLineEdit::returnPressed, Qt::UniqueConnection);
+    }
+  }
+}
+
+void StyleEventDispatcher::addComboBox(QComboBox* comboBox) {
+  if (const auto* view = comboBox->view()) {
+    if (auto* popup = view->parentWidget()) {
+      addBehavior(popup, Behavior::ComboBoxPopup, comboBox);
+    }
+  }
+}
+
+void StyleEventDispatcher::addComboBoxItemView(QComboBox* comboBox, QAbstractItemView* view) {
+  auto& comboBoxEntry = addBehavior(comboBox, Behavior::ComboBoxItemView, comboBox);
+  comboBoxEntry.comboBoxView = view;
+  comboBoxEntry.comboBoxViewInitialMaxHeight = view->maximumHeight();
+
+  addBehavior(view, Behavior::ComboBoxItemView, comboBox);
+  if (auto* viewport = view->viewport()) {
+    addBehavior(viewport, Behavior::ComboBoxItemView, comboBox);
+  }
+  if (auto* popup = view->parentWidget()) {
+    addBehavior(popup, Behavior::ComboBoxItemView, comboBox);
+  }
+
+  if (const auto* treeView = qobject_cast<QTreeView*>(view)) {
+    QObject::connect(treeView, &QTreeView::expanded, this, [this, comboBox]() {
+      fixComboBoxViewGeometry(comboBox);
+    });
+  }
+}
+
+void StyleEventDispatcher::addItemView(QAbstractItemView* view) {
+  auto& entry = addBehavior(view, Behavior::None);
+  if (!entry.itemViewPaintContext) {
+    entry.itemViewPaintContext = std::make_unique<ItemViewPaintContextCache>(view);
+  }
+  if (auto* viewport = view->viewport()) {
+    auto& viewportEntry = addBehavior(viewport, Behavior::ItemViewViewport, view);
+    viewportEntry.viewportItemView = view;
+  }
+}
+
+ItemViewPaintContextCache* StyleEventDispatcher::itemViewPaintContextCache(const QWidget* view) const {
+  const auto it = view ? _entries.find(view) : _entries.end();
+  return it != _entries.end() ? it->second.itemViewPaintContext.get() : nullptr;
+}
+
+bool StyleEventDispatcher::eventFilter(QObject* watched, QEvent* evt) {
+  // This is called for every event of the application: discard as soon as possible
+  // the events that no behavior is interested in.
+  switch (evt->type()) {
+    case QEvent::Paint:
+    case QEvent::FocusIn:
+    case QEvent::Enter:
+    case QEvent::Leave:
+    case QEvent::HoverMove:
+    case QEvent::Wheel:
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::ChildAdded:
+    case QEvent::ChildPolished:
+    case QEvent::Show:
+    case QEvent::Resize:
+    case QEvent::Move:
+      break;
+    default:
+      return false;
+  }
+
+  if (!watched->isWidgetType())
+    return false;
+
+  const auto it = _entries.find(watched);
+  if (it == _entries.end())
+    return false;
+
+  // Behaviors may add entries: the reference remains valid, but not the iterator.
+  auto& entry = it->second;
+  auto* widget = static_cast<QWidget*>(watched);
+  const auto behaviors = entry.behaviors;
+
+  if (behaviors.testFlag(Behavior::ItemViewViewport) && evt->type() == QEvent::Paint) {
+    // A new paint pass starts: the view state may have changed since the previous one.
+    if (auto* cache = itemViewPaintContextCache(entry.viewportItemView)) {
+      cache->invalidate();
+    }
+  }
+  if (behaviors.testFlag(Behavior::LineEditMenu) && filterLineEditMenu(widget, evt))
+    return true;
+  if (behaviors.testFlag(Behavior::TextEditFrame) && filterTextEditFrame(widget, evt))
+    return true;
+  if (behaviors.testFlag(Behavior::TabBar) && filterTabBar(widget, entry, evt))
+    return true;
+  if (behaviors.testFlag(Behavior::TabBarScrollButton)) {
+    const auto type = evt->type();
+    if ((type == QEvent::Leave || type == QEvent::Enter) && entry.owner) {
+      entry.owner->update();
+    }
+  }
+  if (behaviors.testFlag(Behavior::ComboBoxPopup)
+      && filterComboBoxPopup(static_cast<QComboBox*>(entry.owner), evt))
+    return true;
+  if (behaviors.testFlag(Behavior::MouseWheelBlocker) && filterMouseWheelBlocker(widget, evt))
+    return true;
+  if (behaviors.testFlag(Behavior::ComboBoxItemView)
+      && filterComboBoxItemView(widget, static_cast<QComboBox*>(entry.owner), evt))
+    return true;
+  if (behaviors.testFlag(Behavior::Menu) && filterMenu(widget, entry, evt))
+    return true;
+  if (behaviors.testFlag(Behavior::ExternalFocusFrame) && filterExternalFocusFrame(widget, evt))
+    return true;
+  if (behaviors.testFlag(Behavior::LineEditButton) && filterLineEditButton(widget, evt))
+    return true;
+
+  return false;
+}
+
+bool StyleEventDispatcher::filterExternalFocusFrame(QWidget* widget, QEvent* evt) {
+  // Only the focused widget needs the focus frame. Waiting for the focus also gives
+  // any parent (e.g. scrollarea) the time to already exist.
+  if (evt->type() == QEvent::FocusIn) {
+    moveFocusFrame(widget);
+  }
+  return false;
+}
+
+void StyleEventDispatcher::moveFocusFrame(QWidget* widget) {
+  auto* window = widget->window();
+  if (!window || window == widget)
+    return;
+
+  const auto [it, inserted] = _focusFrames.try_emplace(window);
+  if (inserted) {
+    QObject::connect(window, &QObject::destroyed, this, [this](QObject* obj) {
+      _focusFrames.erase(obj);
+    });
+  }
+
+  auto& focusFrame = it->second;
+  if (!focusFrame.frame) {
+    auto* frame = new QFocusFrame(window);
+    focusFrame.frame = frame;
+    focusFrame.animation = new QVariantAnimation(frame);
+    focusFrame.animation->setEasingCurve(QEasingCurve::OutCubic);
+    QObject::connect(focusFrame.animation, &QVariantAnimation::valueChanged, frame, [frame](const QVariant& value) {
+      frame->setGeometry(value.toRect());
+    });
+  }
+
+  auto* frame = focusFrame.frame.data();
+  if (frame->widget() == widget)
+    return;
+
+  // Remember where the frame is, in window coordinates, to make it slide from there.
+  const auto* previousParent = frame->widget() && frame->isVisible() ? frame->parentWidget() : nullptr;
+  const auto previousGeometry =
+    previousParent ? QRect(previousParent->mapTo(window, frame->pos()), frame->size()) : QRect();
+  focusFrame.animation->stop();
+
+  // QFocusFrame places itself in the widget's parent (or the viewport of the scroll area)
+  // and follows the widget's geometry.
+  frame->setWidget(widget);
+
+  const auto* parent = frame->parentWidget();
+  const auto duration = _style.animationsEnabled() ? _style.theme().animationDuration : 0;
+  if (previousParent && parent && frame->isVisible() && duration > 0) {
+    const auto startGeometry = QRect(parent->mapFrom(window, previousGeometry.topLeft()), previousGeometry.size());
+    const auto endGeometry = frame->geometry();
+    frame->setGeometry(startGeometry);
+    focusFrame.animation->setDuration(duration);
+    focusFrame.animation->setStartValue(startGeometry);
+    focusFrame.animation->setEndValue(endGeometry);
+    focusFrame.animation->start();
+  } else if (_animations.getAnimator(frame)) {
+    // Nothing to slide from: make the focus border appear on the new widget, as if the frame was its own.
+    auto* animator = _animations.getOrCreateAnimator(frame);
+    animator->setFocusBorderProgress(0.);
+    animator->stopFocusBorderProgress();
+  }
+}
+
+bool StyleEventDispatcher::filterMouseWheelBlocker(QWidget* widget, QEvent* evt) {
+  if (evt->type() == QEvent::Wheel && !widget->hasFocus()) {
+    evt->ignore();
+    return true;
+  }
+  return false;
+}
+
+// Works for both QTextEdit and QPlainTextEdit
+bool StyleEventDispatcher::filterTextEditFrame(QWidget* widget, QEvent* evt) {
+  auto* textEdit = static_cast<QAbstractScrollArea*>(widget);
+  switch (evt->type()) {
+    case QEvent::Enter:
+    case QEvent::Leave:
+      textEdit->update();
+      break;
+    case QEvent::Paint: {
+      const auto* qlementineStyle = qobject_cast<QlementineStyle*>(textEdit->style());
+      if (!qlementineStyle)
+        break;
+
+      const auto frameShape = textEdit->frameShape();
+      switch (frameShape) {
+        case QFrame::Shape::StyledPanel: {
+          QStyleOptionFrame opt;
+          opt.initFrom(textEdit);
+          opt.rect = textEdit->rect();
+          QPainter p(textEdit);
+          qlementineStyle->drawPrimitive(QStyle::PE_PanelLineEdit, &opt, &p, textEdit);
+        } break;
+        case QFrame::Shape::Panel: {
+          const auto mouse = getMouseState(textEdit->hasFocus(), textEdit->underMouse(), textEdit->isEnabled());
+          const auto& bgColor = qlementineStyle->textFieldBackgroundColor(mouse, Status::Default);
+          const auto rect = textEdit->rect();
+          QPainter p(textEdit);
+          p.fillRect(rect, bgColor);
+        } break;
+        default:
+          break;
+      }
+    } break;
+    default:
+      break;
+  }
+  return false;
+}
+
+bool StyleEventDispatcher::filterLineEditMenu(QWidget* widget, QEvent* evt) {
+  if (evt->type() == QEvent::ChildPolished) {
+    constexpr auto propertyName = "qlementine_tweak_menu_icons";
+    auto* child = static_cast<QChildEvent*>(evt)->child();
+
+    const auto tweaked = child->property(propertyName).toBool();
+    if (!tweaked) {
+      child->setProperty(propertyName, true);
+
+      // QLineEdit child of QSpinBox.
+      if (auto* lineEdit = qobject_cast<QLineEdit*>(child)) {
+        addBehavior(lineEdit, Behavior::LineEditMenu, widget);
+      }
+      // Qmenu that needs tweaking.
+      else if (auto* menu = qobject_cast<QMenu*>(child)) {
+        new LineEditMenuIconsBehavior(menu);
+
+        // Forward auto icon color mode from parent to the menu.
+        if (const auto* menuParent = menu->parentWidget()) {
+          if (const auto* style = qobject_cast<oclero::qlementine::QlementineStyle*>(menuParent->style())) {
+            const auto autoIconColor = style->autoIconColor(menuParent);
+            QlementineStyle::setAutoIconColor(menu, autoIconColor);
+          }
+        }
+      }
+      // Case of a QPlainTextEdit (inherits QAbstractScrollArea).
+      else if (child->objectName() == "qt_scrollarea_viewport") {
+        if (auto* childWidget = qobject_cast<QWidget*>(child)) {
+          addBehavior(childWidget, Behavior::LineEditMenu, widget);
+        }
+      }
+    }
+  }
+  return false;
+}
+
+bool StyleEventDispatcher::filterTabBar(QWidget* widget, Entry& entry, QEvent* evt) {
+  auto* tabBar = static_cast<QTabBar*>(widget);
+  const auto type = evt->type();
+
+  if (type == QEvent::MouseButtonRelease) {
+    const auto* mouseEvent = static_cast<QMouseEvent*>(evt);
+    if (mouseEvent->button() == Qt::MouseButton::MiddleButton) {
+      // Close tab.
+      const auto tabIndex = tabBar->tabAt(mouseEvent->pos());
+      if (tabIndex != -1 && tabBar->isTabVisible(tabIndex)) {
+        evt->accept();
+        Q_EMIT tabBar->tabCloseRequested(tabIndex);
+        return true;
+      }
+    } else if (mouseEvent->button() == Qt::MouseButton::RightButton) {
+      // Tab context menu.
+      const auto tabIndex = tabBar->tabAt(mouseEvent->pos());
+      if (tabIndex != -1 && tabBar->isTabVisible(tabIndex)) {
+        evt->accept();
+        Q_EMIT tabBar->customContextMenuRequested(mouseEvent->pos());
+        return true;
+      }
+    }
+  } else if (type == QEvent::Wheel) {
+    const auto* wheelEvent = static_cast<QWheelEvent*>(evt);
+
+    // Block non-horizontal scroll.
+    const bool wheelVertical = qAbs(wheelEvent->angleDelta().y()) > qAbs(wheelEvent->angleDelta().x());
+    if (wheelVertical) {
+      evt->ignore();
+      return true;
+    }
+
+    auto delta = wheelEvent->pixelDelta().x();
+
+    // If delta is null, it might be because we are on MacOS, using a trackpad.
+    // So let's use angleDelta instead.
+    if (delta == 0) {
+      delta = wheelEvent->angleDelta().x();
+    }
+
+    // Invert the value if necessary.
+    if (wheelEvent->inverted()) {
+      delta = -delta;
+    }
+
+    if (delta > 0 && entry.tabBarRightButton) {
+      // delta > 0 : scroll to the right.
+      entry.tabBarRightButton->click();
+      evt->accept();
+      return true;
+    } else if (delta < 0 && entry.tabBarLeftButton) {
+      // delta < 0 : scroll to the left.
+      entry.tabBarLeftButton->click();
+      evt->accept();
+      return true;
+    } else {
+      evt->ignore();
+      return true;
+    }
+  } else if (type == QEvent::HoverMove && entry.tabBarLeftButton) {
+    const auto* mouseEvent = static_cast<QMouseEvent*>(evt);
+    const auto beginX = entry.tabBarLeftButton->x();
+    if (mouseEvent->pos().x() > beginX) {
+      tabBar->update();
+    }
+  }
+
+  return false;
+}
+
+bool StyleEventDispatcher::filterMenu(QWidget* widget, Entry& entry, QEvent* evt) {
+  auto* menu = static_cast<QMenu*>(widget);
+  switch (evt->type()) {
+    case QEvent::Type::Show: {
+      entry.menuMousePressed = false;
+
+      // Place the QMenu correctly by making up for the drop shadow margins.
+      // It'll be reset before every show, so we can safely move it every time.
+      // Submenus should already be placed correctly, so there's no need to translate their geometry.
+      // Also, make up for the menu item padding so the texts are aligned.
+      const auto isMenuBarMenu = qobject_cast<QMenuBar*>(menu->parentWidget()) != nullptr;
+      const auto isSubMenu = qobject_cast<QMenu*>(menu->parentWidget()) != nullptr;
+      const auto alignForMenuBar = isMenuBarMenu && !isSubMenu;
+      const auto* qlementineStyle = qobject_cast<QlementineStyle*>(menu->style());
+      const auto menuItemHPadding = qlementineStyle ? qlementineStyle->theme().spacing : 0;
+      const auto menuDropShadowWidth = qlementineStyle ? qlementineStyle->theme().spacing : 0;
+      const auto menuOriginalPos = menu->pos();
+      const auto menuBarTranslation = alignForMenuBar ? QPoint(-menuItemHPadding, 0) : QPoint(0, 0);
+      const auto shadowTranslation = QPoint(-menuDropShadowWidth, -menuDropShadowWidth);
+      const auto menuNewPos = menuOriginalPos + menuBarTranslation + shadowTranslation;
+
+      // Menus have weird sizing bugs when moving them from this event.
+      // We have to wait for the event loop to be processed before setting the final position.
+      const auto menuSize = menu->size();
+      if (menuSize != QSize(0, 0)) {
+        menu->resize(0, 0); // Hide the menu for now until we can set the position.
+        QTimer::singleShot(0, menu, [menu, menuNewPos, menuSize]() {
+          menu->move(menuNewPos);
+          menu->resize(menuSize);
+        });
+      }
+    } break;
+    case QEvent::Type::MouseButtonPress: {
+      entry.menuMousePressed = true;
+      const auto* mouseEvt = static_cast<QMouseEvent*>(evt);
+      const auto mousePos = mouseEvt->pos();
+      if (const auto* action = menu->actionAt(mousePos)) {
+        if (action->isSeparator() || !action->isEnabled() || action->property("qlementine_flashing").toBool()) {
+          return true;
+        }
+      } else if (menu->rect().contains(mousePos)) {
+        return true;
+      }
+    } break;
+    case QEvent::Type::MouseButtonRelease: {
+      // This is roughly copied from how QMenuPrivate::mouseDown detects whether the mouse is down.
+      if (!entry.menuMousePressed) {
+        if (evt == _menuEventToNotFilter) {
+          // Let it go to the widget.
+          return false;
+        }
+        return true; // ignore
+      }
+      entry.menuMousePressed = false;
+      const auto* mouseEvt = static_cast<QMouseEvent*>(evt);
+      const auto mousePos = mouseEvt->pos();
+      if (auto* action = menu->actionAt(mousePos)) {
+        if (action->isSeparator() || !action->isEnabled() || action->property("qlementine_flashing").toBool())
+          return true;
+
+        if (action->menu() == nullptr) {
+          flashAction(action, menu, [this, menuPtr = QPointer<QMenu>(menu), action]() {
+            if (!menuPtr)
+              return;
+
+            // We send a manually-built mouse event to click on the menu item.
+            const auto menuItemCenter = menuPtr->actionGeometry(action).center();
+            QMouseEvent releaseEvent(QEvent::MouseButtonRelease, menuItemCenter, menuPtr->mapToGlobal(menuItemCenter),
+              Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+            _menuEventToNotFilter = &releaseEvent;
+            QCoreApplication::sendEvent(menuPtr, &releaseEvent);
+            _menuEventToNotFilter = nullptr;
+          });
+          return true;
+        }
+      } else if (menu->rect().contains(mousePos)) {
+        return true;
+      }
+    } break;
+    default:
+      break;
+  }
+
+  return false;
+}
+
+bool StyleEventDispatcher::filterLineEditButton(QWidget* widget, QEvent* evt) {
+  auto* button = static_cast<QToolButton*>(widget);
+  switch (evt->type()) {
+    case QEvent::Resize:
+      // Prevent resizing from qlineedit_p.cpp:540
+      evt->ignore();
+      return true;
+    case QEvent::Move: {
+      // Prevent moving from qlineedit_p.cpp:540
+      evt->ignore();
+      // Instead, place the button by ourselves.
+      const auto* parentLineEdit = button->parentWidget();
+      const auto parentRect = parentLineEdit->rect();
+      const auto& theme = _style.theme();
+      const auto buttonH = theme.controlHeightMedium;
+      const auto buttonW = buttonH;
+      const auto spacing = theme.spacing / 2;
+      const auto buttonX = parentRect.x() + parentRect.width() - buttonW - spacing;
+      const auto buttonY = parentRect.y() + (parentRect.height() - buttonH) / 2;
+      button->setGeometry(buttonX, buttonY, buttonW, buttonH);
+      return true;
+    } break;
+    case QEvent::Paint: {
+      // Draw the button by ourselves to bypass QLineEditIconButton::paintEvent in qlineedit_p.cpp:353
+      const auto enabled = button->isEnabled();
+      if (!enabled) {
+        evt->accept();
+        return true;
+      }
+
+      const auto hovered = button->underMouse();
+      const auto pressed = button->isDown();
+      const auto mouse = getMouseState(pressed, hovered, enabled);
+      const auto& theme = _style.theme();
+      const auto rect = button->rect();
+
+      const auto& bgColor = _style.toolButtonBackgroundColor(mouse, ColorRole::Secondary);
+      const auto& fgColor = _style.toolButtonForegroundColor(mouse, ColorRole::Secondary);
+      const auto animationDuration = theme.animationDuration;
+      const auto& currentBgColor = _animations.animateBackgroundColor(button, bgColor, animationDuration);
+      const auto& currentFgColor = _animations.animateForegroundColor(button, fgColor, animationDuration);
+
+      // Get opacity animated in qlinedit_p.cpp:436
+      const auto opacity = button->property(QByteArrayLiteral("opacity")).toDouble();
+
+      const auto circleH = theme.controlHeightMedium;
+      const auto circleW = circleH;
+      const auto circleX = rect.x() + (rect.width() - circleW) / 2;
+      const auto circleY = rect.y() + (rect.height() - circleH) / 2;
+      const auto circleRect = QRect(QPoint{ circleX, circleY }, QSize{ circleW, circleH });
+
+      const auto pixmap = getPixmap(button->icon(), theme.iconSize, mouse, CheckState::NotChecked, button);
+      const auto autoIconColor = _style.autoIconColor(button);
+      const auto& colorizedPixmap = _style.getColorizedPixmap(pixmap, autoIconColor, currentFgColor, currentFgColor);
+      const auto pixmapX = circleRect.x() + (circleRect.width() - theme.iconSize.width()) / 2;
+      const auto pixmapY = circleRect.y() + (circleRect.height() - theme.iconSize.height()) / 2;
+      const auto pixmapRect = QRect{ { pixmapX, pixmapY }, theme.iconSize };
+
+      QPainter p(button);
+      p.setOpacity(opacity);
+      p.setPen(Qt::NoPen);
+      p.setRenderHint(QPainter::Antialiasing, true);
+
+      // Background.
+      p.setBrush(currentBgColor);
+      p.drawEllipse(circleRect);
+
+      // Foreground.
+      p.drawPixmap(pixmapRect, colorizedPixmap);
+
+      evt->accept();
+      return true;
+    } break;
+    default:
+      break;
+  }
+
+  return false;
+}
+
+bool StyleEventDispatcher::filterComboBoxPopup(QComboBox* comboBox, QEvent* evt) {
+  // This is the only way we found to know when the QComboBox's view has changed.
+  if (comboBox && evt->type() == QEvent::ChildAdded) {
+    const auto* child = static_cast<QChildEvent*>(evt)->child();
+    if (child == comboBox->view()) {
+      if (auto* qlementine = qobject_cast<QlementineStyle*>(comboBox->style())) {
+        comboBox->setItemDelegate(new ComboBoxDelegate(comboBox, *qlementine));
+      }
+    }
+  }
+  return false;
+}
+
+bool StyleEventDispatcher::filterComboBoxItemView(QWidget* widget, QComboBox* comboBox, QEvent* evt) {
+  if (!comboBox)
+    return false;
+
+  switch (evt->type()) {
+    case QEvent::Type::ChildAdded:
+      if (widget == comboBox) {
+        const auto* child = static_cast<QChildEvent*>(evt)->child();
+        if (child == comboBox->view()) {
+          if (auto* qlementine = qobject_cast<QlementineStyle*>(comboBox->style())) {
+            comboBox->setItemDelegate(new ComboBoxDelegate(comboBox, *qlementine));
+          }
+        }
+      }
+      break;
+    case QEvent::Type::Show:
+      fixComboBoxViewGeometry(comboBox);
+      break;
+    case QEvent::Type::Resize:
+      if (widget == comboBox) {
+        fixComboBoxViewGeometry(comboBox);
+      }
+      break;
+    default:
+      break;
+  }
+  return false;
+}
+
+void StyleEventDispatcher::fixComboBoxViewGeometry(QComboBox* comboBox) {
+  const auto it = _entries.find(comboBox);
+  if (it == _entries.end() || !it->second.comboBoxView)
+    return;
+
+  auto* view = comboBox->view();
+  const auto* qlementineStyle = qobject_cast<QlementineStyle*>(comboBox->style());
+  if (!view || !qlementineStyle)
+    return;
+
+  const auto* filteredView = it->second.comboBoxView.data();
+  const auto initialMaxHeight = it->second.comboBoxViewInitialMaxHeight;
+
+  // QListView::minimumSizeHint() doesn't give the correct minimumHeight,
+  // so we have to compute it.
+  auto viewMinimumHeight = 0;
+  if (const auto* treeView = qobject_cast<const QTreeView*>(filteredView)) {
+    // For a QTreeView, look at expanded rows.
+    auto currentIndex = treeView->indexAt(QPoint(0, 0));
+    while (currentIndex.isValid()) {
+      const auto rowSizeHint = filteredView->sizeHintForIndex(currentIndex).height();
+      viewMinimumHeight = std::min(initialMaxHeight, viewMinimumHeight + std::max(0, rowSizeHint));
+      currentIndex = treeView->indexBelow(currentIndex);
+    }
+  } else {
+    const auto rowCount = filteredView->model()->rowCount();
+    for (auto i = 0; i < rowCount && viewMinimumHeight <= initialMaxHeight; ++i) {
+      const auto rowSizeHint = filteredView->sizeHintForRow(i);
+      viewMinimumHeight = std::min(initialMaxHeight, viewMinimumHeight + rowSizeHint);
+    }
+  }
+
+  const auto& theme = qlementineStyle->theme();
+  const auto isTreeView = view->inherits("QTreeView");
+  const auto hMargin = qlementineStyle->pixelMetric(QStyle::PM_MenuHMargin);
+  const auto shadowWidth = theme.spacing;
+  const auto borderWidth = theme.borderWidth;
+
+  // Width.
+  const auto absoluteMinWidth = theme.controlHeightLarge * (isTreeView ? 2 : 1);
+  const auto absoluteMaxWidth = theme.controlHeightLarge * 24;
+  const auto width = std::min(absoluteMaxWidth, std::max({
+                                                  comboBox->width(),
+                                                  view->sizeHintForColumn(0),
+                                                  absoluteMinWidth,
+                                                }))
+                     + shadowWidth * 2 + hMargin * 2 + borderWidth * 2;
+
+  // Height.
+  const auto absoluteMinHeight = theme.controlHeightLarge * (isTreeView ? 5 : 1);
+  const auto screen = view->screen();
+  const auto absoluteMaxHeight =
+    screen != nullptr ? screen->geometry().height() - 128 : theme.controlHeightLarge * 10;
+  const auto height = std::min(absoluteMaxHeight, std::max(absoluteMinHeight, viewMinimumHeight));
+
+  view->setFixedWidth(width);
+  view->setFixedHeight(height);
+  view->parentWidget()->adjustSize();
+}
+} // namespace oclero::qlementine
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ItemViewPaintContext.hpp"
+
+#include <QObject>
+#include <QPointer>
+#include <QFlags>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class QAbstractItemView;
+class QAbstractScrollArea;
+class QComboBox;
+class QFocusFrame;
+class QMenu;
+class QTabBar;
+class QToolButton;
+class QVariantAnimation;
+
+namespace oclero::qlementine {
+class QlementineStyle;
+class WidgetAnimationManager;
+
+/// Single application-level event filter that implements all the behaviors the style adds to widgets.
+/// Widgets don't get an event filter object each: their state is kept in a table, and only the
+/// event types used by these behaviors are looked up in it.
+class StyleEventDispatcher : public QObject {
+public:
+  enum class Behavior : std::uint16_t {
+    None = 0,
+    ExternalFocusFrame = 1 << 0,
+    MouseWheelBlocker = 1 << 1,
+    TextEditFrame = 1 << 2,
+    LineEditMenu = 1 << 3,
+    TabBar = 1 << 4,
+    TabBarScrollButton = 1 << 5,
+    Menu = 1 << 6,
+    LineEditButton = 1 << 7,
+    ComboBoxPopup = 1 << 8,
+    ComboBoxItemView = 1 << 9,
+    ItemViewViewport = 1 << 10,
+  };
+  Q_DECLARE_FLAGS(Behaviors, Behavior)
+
+  StyleEventDispatcher(QlementineStyle& style, WidgetAnimationManager& animations);
+
+  /// QFocusFrame is used to draw focus outside of the widget's bound.
+  /// A single QFocusFrame per window is moved to the widget that has focus.
+  void addExternalFocusFrame(QWidget* widget);
+
+  /// The widget won't receive wheel events when not focused.
+  void addMouseWheelBlocker(QWidget* widget);
+
+  /// Makes the QTextEdit or QPlainTextEdit have a frame.
+  void addTextEditFrame(QAbstractScrollArea* textEdit);
+
+  /// Adds icons to the context menu of a QLineEdit, QSpinBox or QPlainTextEdit.
+  void addLineEditMenu(QWidget* widget);
+
+  /// Tweaks the scroll buttons, wheel and mouse behavior of the QTabBar.
+  void addTabBar(QTabBar* tabBar);
+
+  /// Places the QMenu according to its drop shadow, and flashes the clicked item.
+  void addMenu(QMenu* menu);
+
+  /// Draws and places by ourselves the Qt-private buttons in a QLineEdit.
+  void addLineEditButton(QToolButton* button);
+
+  /// Redefines the delegate of the QComboBox when its view changes.
+  void addComboBox(QComboBox* comboBox);
+
+  /// Fixes the geometry of the QComboBox's popup.
+  void addComboBoxItemView(QComboBox* comboBox, QAbstractItemView* view);
+
+  /// Caches the facts shared by all the cells of a paint pass.
+  void addItemView(QAbstractItemView* view);
+
+  /// Removes all the behaviors of the widget.
+  void removeWidget(QWidget* widget);
+
+  /// Gets the paint context cache of the item view, if any.
+  ItemViewPaintContextCache* itemViewPaintContextCache(const QWidget* view) const;
+
+  bool eventFilter(QObject* watched, QEvent* evt) override;
+
+private:
+  struct Entry {
+    Behaviors behaviors{ Behavior::None };
+    // The widget the behavior applies to, when the watched widget is one of its children
+    // (i.e. the QTabBar of a scroll button, or the QComboBox of a popup).
+    QWidget* owner{ nullptr };
+    // Menu.
+    bool menuMousePressed{ false };
+    // TabBar.
+    QPointer<QToolButton> tabBarLeftButton;
+    QPointer<QToolButton> tabBarRightButton;
+    // ComboBoxItemView.
+    QPointer<QAbstractItemView> comboBoxView;
+    int comboBoxViewInitialMaxHeight{ 0 };
+    // ItemView, and the item view of an ItemViewViewport.
+    std::unique_ptr<ItemViewPaintContextCache> itemViewPaintContext;
+    QAbstractItemView* viewportItemView{ nullptr };
+    // Children that got behaviors for this widget, with this widget as owner.
+    std::vector<QPointer<QWidget>> children;
+    // Removes the entry when the widget is destroyed. Other connections to its destroyed signal are kept.
+    QMetaObject::Connection destroyedConnection;
+  };
+
+  Entry& addBehavior(QWidget* widget, Behavior behavior, QWidget* owner = nullptr);
+  void eraseEntry(QWidget* widget);
+
+  bool filterExternalFocusFrame(QWidget* widget, QEvent* evt);
+  bool filterMouseWheelBlocker(QWidget* widget, QEvent* evt);
+  bool filterTextEditFrame(QWidget* widget, QEvent* evt);
+  bool filterLineEditMenu(QWidget* widget, QEvent* evt);
+  bool filterTabBar(QWidget* widget, Entry& entry, QEvent* evt);
+  bool filterMenu(QWidget* widget, Entry& entry, QEvent* evt);
+  bool filterLineEditButton(QWidget* widget, QEvent* evt);
+  bool filterComboBoxPopup(QComboBox* comboBox, QEvent* evt);
+  bool filterComboBoxItemView(QWidget* widget, QComboBox* comboBox, QEvent* evt);
+
+  void fixComboBoxViewGeometry(QComboBox* comboBox);
+  void moveFocusFrame(QWidget* widget);
+
+  QlementineStyle& _style;
+  WidgetAnimationManager& _animations;
+  std::unordered_map<const QObject*, Entry> _entries;
+  // One QFocusFrame per window, shared by all its widgets. It slides from a widget to the next one.
+  struct FocusFrame {
+    QPointer<QFocusFrame> frame;
+    QPointer<QVariantAnimation> animation;
+  };
+  std::unordered_map<const QObject*, FocusFrame> _focusFrames;
+  // Event sent by ourselves to close a QMenu, that must not be filtered.
+  const QEvent* _menuEventToNotFilter{ nullptr };
+  bool _installed{ false };
+};
+Q_DECLARE_OPERATORS_FOR_FLAGS(StyleEventDispatcher::Behaviors)
+} // namespace oclero::qlementine
@@ -6,6 +6,8 @@
 #include <oclero/qlementine/utils/FontUtils.hpp>
 #include <oclero/qlementine/utils/ColorUtils.hpp>
 
+#include "style/ThemeFields.hpp"
+
 #include <QColor>
 #include <QFile>
 #include <QFontDatabase>
@@ -13,8 +15,11 @@
 #include <QScreen>
 #include <QVector>
 #include <QGuiApplication>
+#include <QHashFunctions>
 
+#include <algorithm>
 #include <optional>
+#include <utility>
 
 namespace oclero::qlementine {
 namespace {
@@ -144,18 +149,37 @@ void tryGetDouble(QJsonObject const& jsonObj, QString const& key, double& target
   }
 }
 
-QJsonDocument readJsonDoc(QString const& jsonPath) {
+QJsonDocument readJsonDoc(QString const& jsonPath, QString* error = nullptr) {
   QFile jsonFile(jsonPath);
-  if (jsonFile.open(QIODevice::ReadOnly)) {
-    const auto fileContents = jsonFile.readAll();
-    QJsonParseError jsonParseError{};
-    const auto jsonDoc = QJsonDocument::fromJson(fileContents, &jsonParseError);
-    if (jsonParseError.error == QJsonParseError::ParseError::NoError && !jsonDoc.isEmpty()) {
-      return jsonDoc;
+  if (!jsonFile.open(QIODevice::ReadOnly)) {
+    if (error) {
+      *error = QStringLiteral("%1: %2").arg(jsonPath, jsonFile.errorString());
     }
+    return {};
   }
 
-  return {};
+  const auto fileContents = jsonFile.readAll();
+  QJsonParseError jsonParseError{};
+  const auto jsonDoc = QJsonDocument::fromJson(fileContents, &jsonParseError);
+  if (jsonParseError.error != QJsonParseError::ParseError::NoError) {
+    if (error) {
+      // Qt only gives the offset of the error in the file.
+      const auto offset = std::clamp(static_cast<qsizetype>(jsonParseError.offset), qsizetype{ 0 }, fileContents.size());
+      const auto before = fileContents.left(offset);
+      const auto line = before.count('\n') + 1;
+      const auto column = offset - before.lastIndexOf('\n');
+      *error = QStringLiteral("%1:%2:%3: %4").arg(jsonPath).arg(line).arg(column).arg(jsonParseError.errorString());
+    }
+    return {};
+  }
+  if (jsonDoc.isEmpty()) {
+    if (error) {
+      *error = QStringLiteral("%1: empty document").arg(jsonPath);
+    }
+    return {};
+  }
+
+  return jsonDoc;
 }
 
 void setColor(QJsonObject& jsonObj, const QString& key, const QColor& value) {
@@ -185,27 +209,111 @@ bool jsonObjHasAllKeys(const QJsonObject& obj, const QVector<QString>& keys) {
   }
   return true;
 }
+
+std::optional<ThemeMeta> readMeta(const QJsonObject& jsonObj) {
+  auto const metaObj = jsonObj.value(QStringLiteral("meta")).toObject();
+  if (!jsonObjHasAllKeys(metaObj, {
+                                    QStringLiteral("name"),
+                                    QStringLiteral("version"),
+                                    QStringLiteral("author"),
+                                  }))
+    return std::nullopt;
+
+  return ThemeMeta{
+    tryGetString(metaObj, QStringLiteral("name"), {}),
+    tryGetString(metaObj, QStringLiteral("version"), {}),
+    tryGetString(metaObj, QStringLiteral("author"), {}),
+  };
+}
 } // namespace
 
 Theme::Theme() {
   initializeFonts();
   initializePalette();
+  updateContentHash();
 }
 
+Theme::Theme(ValuesOnly) {}
+
 std::optional<Theme> Theme::fromJsonPath(const QString& jsonPath) {
   return fromJsonDoc(readJsonDoc(jsonPath));
 }
 
+std::optional<Theme> Theme::fromJsonPath(const QString& jsonPath, QString& error) {
+  auto themeOpt = valuesFromJsonPath(jsonPath, error);
+  if (themeOpt.has_value()) {
+    themeOpt->generateFontsAndPalette();
+  }
+  return themeOpt;
+}
+
 std::optional<Theme> Theme::fromJsonDoc(const QJsonDocument& jsonDoc) {
-  Theme theme;
+  auto themeOpt = valuesFromJsonDoc(jsonDoc);
+  if (themeOpt.has_value()) {
+    themeOpt->generateFontsAndPalette();
+  }
+  return themeOpt;
+}
+
+std::optional<Theme> Theme::valuesFromJsonPath(const QString& jsonPath) {
+  return valuesFromJsonDoc(readJsonDoc(jsonPath));
+}
+
+std::optional<Theme> Theme::valuesFromJsonPath(const QString& jsonPath, QString& error) {
+  const auto jsonDoc = readJsonDoc(jsonPath, &error);
+  if (jsonDoc.isNull())
+    return std::nullopt;
+
+  auto themeOpt = valuesFromJsonDoc(jsonDoc);
+  if (!themeOpt.has_value()) {
+    error = QStringLiteral("%1: not a valid theme").arg(jsonPath);
+  }
+  return themeOpt;
+}
+
+std::optional<Theme> Theme::valuesFromJsonDoc(const QJsonDocument& jsonDoc) {
+  Theme theme{ ValuesOnly{} };
   if (theme.initializeFromJson(jsonDoc)) {
-    theme.initializeFonts();
-    theme.initializePalette();
+    theme.updateContentHash();
     return theme;
   }
   return std::nullopt;
 }
 
+void Theme::generateFontsAndPalette() {
+  initializeFonts();
+  initializePalette();
+}
+
+std::optional<ThemeMeta> Theme::metaFromJsonPath(const QString& jsonPath) {
+  const auto jsonDoc = readJsonDoc(jsonPath);
+  if (!jsonDoc.isObject())
+    return std::nullopt;
+
+  return readMeta(jsonDoc.object());
+}
+
+std::size_t Theme::contentHash() const {
+  return _contentHash;
+}
+
+void Theme::updateContentHash() {
+  // Generated values (fonts, palette) are not hashed, on purpose: they only depend on the other values.
+  auto seed = qHashMulti(0, meta.name, meta.version, meta.author);
+#define QLEMENTINE_HASH_COLOR(NAME) seed = qHash(static_cast<quint64>(NAME.rgba64()), seed);
+#define QLEMENTINE_HASH_VALUE(NAME) seed = qHash(NAME, seed);
+#define QLEMENTINE_HASH_SIZE(NAME) seed = qHashMulti(seed, NAME.width(), NAME.height());
+  QLEMENTINE_THEME_COLOR_FIELDS(QLEMENTINE_HASH_COLOR)
+  QLEMENTINE_THEME_BOOL_FIELDS(QLEMENTINE_HASH_VALUE)
+  QLEMENTINE_THEME_INT_FIELDS(QLEMENTINE_HASH_VALUE)
+  QLEMENTINE_THEME_DOUBLE_FIELDS(QLEMENTINE_HASH_VALUE)
+  QLEMENTINE_THEME_SIZE_FIELDS(QLEMENTINE_HASH_SIZE)
+#undef QLEMENTINE_HASH_COLOR
+#undef QLEMENTINE_HASH_VALUE
+#undef QLEMENTINE_HASH_SIZE
+  _contentHash = seed;
+}
+
 void Theme::initializeFonts() {
   // Fonts.
   const auto defaultFont =
@@ -330,19 +438,11 @@ bool Theme::initializeFromJson(QJsonDocument const& jsonDoc) {
   const auto jsonObj = jsonDoc.object();
   if (!jsonObj.isEmpty()) {
     // Parse metadata.
-    auto const metaObj = jsonObj.value(QStringLiteral("meta")).toObject();
-    if (!jsonObjHasAllKeys(metaObj, {
-                                      QStringLiteral("name"),
-                                      QStringLiteral("version"),
-                                      QStringLiteral("author"),
-                                    }))
+    const auto metaOpt = readMeta(jsonObj);
+    if (!metaOpt.has_value())
       return false;
 
-    meta = ThemeMeta{
-      tryGetString(metaObj, QStringLiteral("name"), {}),
-      tryGetString(metaObj, QStringLiteral("version"), {}),
-      tryGetString(metaObj, QStringLiteral("author"), {}),
-    };
+    meta = metaOpt.value();
 
     // Parse all values.
     TRY_GET_COLOR_ATTRIBUTE(jsonObj, backgroundColorMain1);
@@ -635,123 +735,70 @@ QJsonDocument Theme::toJson() const {
 }
 
 bool Theme::operator==(const Theme& other) const {
-  // All generated values are not used in this equality test, on purpose.
-  // TODO Remove this and instead use spaceship operator when C++20 is available on macOS/XCode.
-  // clang-format off
-  return meta == other.meta
-    && backgroundColorMain1 == other.backgroundColorMain1
-    && backgroundColorMain2 == other.backgroundColorMain2
-    && backgroundColorMain3 == other.backgroundColorMain3
-    && backgroundColorMain4 == other.backgroundColorMain4
-
-    && backgroundColorWorkspace == other.backgroundColorWorkspace
-
-    && neutralColorDisabled == other.neutralColorDisabled
-    && neutralColor == other.neutralColor
-    && neutralColorHovered == other.neutralColorHovered
-    && neutralColorPressed == other.neutralColorPressed
-
-    && focusColor == other.focusColor
-
-    && primaryColor == other.primaryColor
-    && primaryColorHovered == other.primaryColorHovered
-    && primaryColorPressed == other.primaryColorPressed
-    && primaryColorDisabled == other.primaryColorDisabled
-
-    && primaryColorForeground == other.primaryColorForeground
-    && primaryColorForegroundHovered == other.primaryColorForegroundHovered
-    && primaryColorForegroundPressed == other.primaryColorForegroundPressed
-    && primaryColorForegroundDisabled == other.primaryColorForegroundDisabled
-
-    && primaryAlternativeColor == other.primaryAlternativeColor
-    && primaryAlternativeColorHovered == other.primaryAlternativeColorHovered
-    && primaryAlternativeColorPressed == other.primaryAlternativeColorPressed
-    && primaryAlternativeColorDisabled == other.primaryAlternativeColorDisabled
-
-    && secondaryColor == other.secondaryColor
-    && secondaryColorHovered == other.secondaryColorHovered
-    && secondaryColorPressed == other.secondaryColorPressed
-    && secondaryColorDisabled == other.secondaryColorDisabled
-
-    && secondaryAlternativeColor == other.secondaryAlternativeColor
-    && secondaryAlternativeColorHovered == other.secondaryAlternativeColorHovered
-    && secondaryAlternativeColorPressed == other.secondaryAlternativeColorPressed
-    && secondaryAlternativeColorDisabled == other.secondaryAlternativeColorDisabled
-
-    && secondaryColorForeground == other.secondaryColorForeground
-    && secondaryColorForegroundHovered == other.secondaryColorForegroundHovered
-    && secondaryColorForegroundPressed == other.secondaryColorForegroundPressed
-    && secondaryColorForegroundDisabled == other.secondaryColorForegroundDisabled
-
-    && statusColorSuccess == other.statusColorSuccess
-    && statusColorSuccessHovered == other.statusColorSuccessHovered
-    && statusColorSuccessPressed == other.statusColorSuccessPressed
-    && statusColorSuccessDisabled == other.statusColorSuccessDisabled
-    && statusColorInfo == other.statusColorInfo
-    && statusColorInfoHovered == other.statusColorInfoHovered
-    && statusColorInfoPressed == other.statusColorInfoPressed
-    && statusColorInfoDisabled == other.statusColorInfoDisabled
-    && statusColorWarning == other.statusColorWarning
-    && statusColorWarningHovered == other.statusColorWarningHovered
-    && statusColorWarningPressed == other.statusColorWarningPressed
-    && statusColorWarningDisabled == other.statusColorWarningDisabled
-    && statusColorError == other.statusColorError
-    && statusColorErrorHovered == other.statusColorErrorHovered
-    && statusColorErrorPressed == other.statusColorErrorPressed
-    && statusColorErrorDisabled == other.statusColorErrorDisabled
-    && statusColorForeground == other.statusColorForeground
-    && statusColorForegroundHovered == other.statusColorForegroundHovered
-    && statusColorForegroundPressed == other.statusColorForegroundPressed
-    && statusColorForegroundDisabled == other.statusColorForegroundDisabled
-
-    && shadowColor1 == other.shadowColor1
-    && shadowColor2 == other.shadowColor2
-    && shadowColor3 == other.shadowColor3
-
-    && borderColor == other.borderColor
-    && borderColorHovered == other.borderColorHovered
-    && borderColorPressed == other.borderColorPressed
-    && borderColorDisabled == other.borderColorDisabled
-
-    && useSystemFonts == other.useSystemFonts
-
-    && animationDuration == other.animationDuration
-    && focusAnimationDuration == other.focusAnimationDuration
-    && sliderAnimationDuration == other.sliderAnimationDuration
-    && borderRadius == other.borderRadius
-    && checkBoxBorderRadius == other.checkBoxBorderRadius
-    && menuItemBorderRadius == other.menuItemBorderRadius
-    && menuBarItemBorderRadius == other.menuBarItemBorderRadius
-    && borderWidth == other.borderWidth
-    && controlHeightLarge == other.controlHeightLarge
-    && controlHeightMedium == other.controlHeightMedium
-    && controlHeightSmall == other.controlHeightSmall
-    && controlDefaultWidth == other.controlDefaultWidth
-    && dialMarkLength == other.dialMarkLength
-    && dialMarkThickness == other.dialMarkThickness
-    && dialTickLength == other.dialTickLength
-    && dialTickSpacing == other.dialTickSpacing
-    && dialGrooveThickness == other.dialGrooveThickness
-    && focusBorderWidth == other.focusBorderWidth
-    && iconSize == other.iconSize
-    && iconSizeMedium == other.iconSizeMedium
-    && iconSizeLarge == other.iconSizeLarge
-    && iconSizeExtraSmall == other.iconSizeExtraSmall
-    && sliderTickSize == other.sliderTickSize
-    && sliderTickThickness == other.sliderTickThickness
-    && sliderGrooveHeight == other.sliderGrooveHeight
-    && progressBarGrooveHeight == other.progressBarGrooveHeight
-    && spacing == other.spacing
-    && scrollBarThicknessFull == other.scrollBarThicknessFull
-    && scrollBarThicknessSmall == other.scrollBarThicknessSmall
-    && scrollBarMargin == other.scrollBarMargin
-    && tabBarPaddingTop == other.tabBarPaddingTop
-    ;
-  // clang-format on
+  // Different hashes are enough to tell that themes differ, which is the common case.
+  if (_contentHash != other._contentHash)
+    return false;
+
+  // Equal hashes may be a collision: compare the values themselves, like the hash does.
+  if (meta != other.meta)
+    return false;
+#define QLEMENTINE_COMPARE_COLOR(NAME)                                                                                 \
+  if (NAME.rgba64() != other.NAME.rgba64())                                                                            \
+    return false;
+#define QLEMENTINE_COMPARE_VALUE(NAME)                                                                                 \
+  if (NAME != other.NAME)                                                                                              \
+    return false;
+  QLEMENTINE_THEME_COLOR_FIELDS(QLEMENTINE_COMPARE_COLOR)
+  QLEMENTINE_THEME_BOOL_FIELDS(QLEMENTINE_COMPARE_VALUE)
+  QLEMENTINE_THEME_INT_FIELDS(QLEMENTINE_COMPARE_VALUE)
+  QLEMENTINE_THEME_DOUBLE_FIELDS(QLEMENTINE_COMPARE_VALUE)
+  QLEMENTINE_THEME_SIZE_FIELDS(QLEMENTINE_COMPARE_VALUE)
+#undef QLEMENTINE_COMPARE_COLOR
+#undef QLEMENTINE_COMPARE_VALUE
+  return true;
 }
 
 bool Theme::operator!=(const Theme& other) const {
   return !(*this == other);
 }
 
+SharedTheme::SharedTheme()
+  : _d(std::make_shared<const Theme>()) {}
+
+SharedTheme::SharedTheme(const Theme& theme)
+  : _d(std::make_shared<const Theme>(theme)) {}
+
+SharedTheme::SharedTheme(Theme&& theme)
+  : _d(std::make_shared<const Theme>(std::move(theme))) {}
+
+SharedTheme::SharedTheme(std::shared_ptr<const Theme> d)
+  : _d(std::move(d)) {}
+
+bool SharedTheme::operator==(const SharedTheme& other) const {
+  return _d == other._d || *_d == *other._d;
+}
+
+bool SharedTheme::operator!=(const SharedTheme& other) const {
+  return !(*this == other);
+}
+
+ThemeBuilder::ThemeBuilder(SharedTheme base)
+  : _base(std::move(base)) {}
+
+Theme& ThemeBuilder::theme() {
+  if (!_theme) {
+    _theme = std::make_shared<Theme>(*_base);
+  }
+  return *_theme;
+}
+
+SharedTheme ThemeBuilder::build() {
+  if (_theme) {
+    _theme->updateContentHash();
+    // The result is shared, so further modifications must be done on a new copy.
+    _base = SharedTheme(std::shared_ptr<const Theme>(std::move(_theme)));
+  }
+  return _base;
+}
+
 } // namespace oclero::qlementine
@@ -0,0 +1,318 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <oclero/qlementine/style/Theme.hpp>
+
+#include "style/ThemeFields.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <cstring>
+
+// Binary theme format, all integers being little-endian:
+//
+// Header (16 bytes)
+//   char[4]   magic "QLTH"
+//   quint32   format version (Theme::binaryFormatVersion)
+//   quint32   payload size, in bytes
+//   quint32   checksum of the payload (FNV-1a)
+// Payload
+//   quint32   colors, as resolved #AARRGGBB values
+//   quint32   bools, 0 or 1
+//   qint32    ints
+//   quint64   doubles, as IEEE 754 bits
+//   qint32[2] sizes, width then height
+//   meta name, version and author, each as a quint32 byte count followed by UTF-8 bytes
+//
+// All the values but the meta are at fixed offsets, given by the order in ThemeFields.hpp.
+
+namespace oclero::qlementine {
+namespace {
+constexpr char binaryMagic[4] = { 'Q', 'L', 'T', 'H' };
+constexpr auto headerSize = 16;
+
+#define QLEMENTINE_COUNT_FIELD(NAME) +1
+constexpr auto colorCount = 0 QLEMENTINE_THEME_COLOR_FIELDS(QLEMENTINE_COUNT_FIELD);
+constexpr auto boolCount = 0 QLEMENTINE_THEME_BOOL_FIELDS(QLEMENTINE_COUNT_FIELD);
+constexpr auto intCount = 0 QLEMENTINE_THEME_INT_FIELDS(QLEMENTINE_COUNT_FIELD);
+constexpr auto doubleCount = 0 QLEMENTINE_THEME_DOUBLE_FIELDS(QLEMENTINE_COUNT_FIELD);
+constexpr auto sizeCount = 0 QLEMENTINE_THEME_SIZE_FIELDS(QLEMENTINE_COUNT_FIELD);
+#undef QLEMENTINE_COUNT_FIELD
+
+// Size of the part of the payload where values are at fixed offsets.
+constexpr auto fixedPayloadSize = colorCount * 4 + boolCount * 4 + intCount * 4 + doubleCount * 8 + sizeCount * 8;
+
+quint32 checksum(const char* data, qsizetype size) {
+  // FNV-1a: stable across platforms and Qt versions, unlike qHash.
+  auto hash = quint32{ 2166136261u };
+  for (qsizetype i = 0; i < size; ++i) {
+    hash ^= static_cast<quint8>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+void writeU32(QByteArray& data, quint32 value) {
+  char buffer[4];
+  qToLittleEndian(value, buffer);
+  data.append(buffer, sizeof(buffer));
+}
+
+void writeU64(QByteArray& data, quint64 value) {
+  char buffer[8];
+  qToLittleEndian(value, buffer);
+  data.append(buffer, sizeof(buffer));
+}
+
+void writeDouble(QByteArray& data, double value) {
+  quint64 bits{ 0 };
+  std::memcpy(&bits, &value, sizeof(bits));
+  writeU64(data, bits);
+}
+
+void writeString(QByteArray& data, const QString& value) {
+  const auto utf8 = value.toUtf8();
+  writeU32(data, static_cast<quint32>(utf8.size()));
+  data.append(utf8);
+}
+
+/// Reads values from a buffer it doesn't own (e.g. a memory-mapped file), checking bounds.
+class BinaryReader {
+public:
+  BinaryReader(const char* data, qsizetype size)
+    : _data(data)
+    , _end(data + size) {}
+
+  quint32 readU32() {
+    const auto value = qFromLittleEndian<quint32>(_data);
+    _data += 4;
+    return value;
+  }
+
+  quint64 readU64() {
+    const auto value = qFromLittleEndian<quint64>(_data);
+    _data += 8;
+    return value;
+  }
+
+  double readDouble() {
+    const auto bits = readU64();
+    double value{ 0. };
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  bool tryReadString(QString& value) {
+    if (_end - _data < 4)
+      return false;
+    const auto size = readU32();
+    if (static_cast<quint64>(_end - _data) < size)
+      return false;
+    value = QString::fromUtf8(_data, static_cast<qsizetype>(size));
+    _data += size;
+    return true;
+  }
+
+  bool atEnd() const {
+    return _data == _end;
+  }
+
+private:
+  const char* _data{ nullptr };
+  const char* _end{ nullptr };
+};
+
+/// Checks the header of the binary theme, and gets the payload (without copying it), or a null QByteArray if invalid.
+QByteArray validatedPayload(const QByteArray& data) {
+  if (data.size() < headerSize + fixedPayloadSize)
+    return {};
+
+  const auto* bytes = data.constData();
+  if (std::memcmp(bytes, binaryMagic, sizeof(binaryMagic)) != 0)
+    return {};
+
+  BinaryReader header(bytes + sizeof(binaryMagic), headerSize - sizeof(binaryMagic));
+  const auto version = header.readU32();
+  const auto payloadSize = header.readU32();
+  const auto payloadChecksum = header.readU32();
+  if (version != Theme::binaryFormatVersion || payloadSize != static_cast<quint32>(data.size() - headerSize))
+    return {};
+
+  const auto* payload = bytes + headerSize;
+  if (checksum(payload, payloadSize) != payloadChecksum)
+    return {};
+
+  return QByteArray::fromRawData(payload, payloadSize);
+}
+
+/// Maps the file in memory, read-only, and reads it with the function.
+template<typename ReadFunc>
+auto readMappedFile(const QString& path, ReadFunc&& readFunc) -> decltype(readFunc(QByteArray{})) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly))
+    return std::nullopt;
+
+  const auto fileSize = file.size();
+  auto* mapped = file.map(0, fileSize);
+  if (!mapped) {
+    // Some file engines can't map files (e.g. compressed Qt resources).
+    return readFunc(file.readAll());
+  }
+
+  // Don't copy the mapped bytes.
+  auto result = readFunc(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), static_cast<qsizetype>(fileSize)));
+  file.unmap(mapped);
+  return result;
+}
+
+QString jsonPathForBinaryPath(const QString& binaryPath) {
+  const QFileInfo fileInfo(binaryPath);
+  return fileInfo.dir().filePath(fileInfo.completeBaseName() + QStringLiteral(".json"));
+}
+} // namespace
+
+std::optional<Theme> Theme::fromBinaryPath(const QString& binaryPath) {
+  auto themeOpt = valuesFromBinaryPath(binaryPath);
+  if (themeOpt.has_value()) {
+    themeOpt->generateFontsAndPalette();
+  }
+  return themeOpt;
+}
+
+std::optional<Theme> Theme::valuesFromBinaryPath(const QString& binaryPath) {
+  if (auto theme = readMappedFile(binaryPath, &Theme::valuesFromBinary)) {
+    return theme;
+  }
+
+  // The binary file is missing, corrupted, or from another format version: use the source instead.
+  const auto jsonPath = jsonPathForBinaryPath(binaryPath);
+  if (QFileInfo::exists(jsonPath)) {
+    return valuesFromJsonPath(jsonPath);
+  }
+  return std::nullopt;
+}
+
+std::optional<ThemeMeta> Theme::metaFromBinaryPath(const QString& binaryPath) {
+  const auto readMeta = [](const QByteArray& data) -> std::optional<ThemeMeta> {
+    const auto payload = validatedPayload(data);
+    if (payload.isNull())
+      return std::nullopt;
+
+    // The meta is after the values at fixed offsets.
+    ThemeMeta meta;
+    BinaryReader reader(payload.constData() + fixedPayloadSize, payload.size() - fixedPayloadSize);
+    if (!reader.tryReadString(meta.name) || !reader.tryReadString(meta.version) || !reader.tryReadString(meta.author))
+      return std::nullopt;
+    return meta;
+  };
+  if (auto meta = readMappedFile(binaryPath, readMeta)) {
+    return meta;
+  }
+
+  const auto jsonPath = jsonPathForBinaryPath(binaryPath);
+  if (QFileInfo::exists(jsonPath)) {
+    return metaFromJsonPath(jsonPath);
+  }
+  return std::nullopt;
+}
+
+std::optional<Theme> Theme::fromBinary(const QByteArray& data) {
+  auto themeOpt = valuesFromBinary(data);
+  if (themeOpt.has_value()) {
+    themeOpt->generateFontsAndPalette();
+  }
+  return themeOpt;
+}
+
+std::optional<Theme> Theme::valuesFromBinary(const QByteArray& data) {
+  const auto payload = validatedPayload(data);
+  if (payload.isNull())
+    return std::nullopt;
+
+  Theme theme{ ValuesOnly{} };
+  BinaryReader reader(payload.constData(), payload.size());
+#define QLEMENTINE_READ_COLOR(NAME) theme.NAME = QColor::fromRgba(reader.readU32());
+#define QLEMENTINE_READ_BOOL(NAME) theme.NAME = reader.readU32() != 0;
+#define QLEMENTINE_READ_INT(NAME) theme.NAME = static_cast<int>(static_cast<qint32>(reader.readU32()));
+#define QLEMENTINE_READ_DOUBLE(NAME) theme.NAME = reader.readDouble();
+#define QLEMENTINE_READ_SIZE(NAME)                                                                                     \
+  {                                                                                                                    \
+    const auto width = static_cast<qint32>(reader.readU32());                                                          \
+    const auto height = static_cast<qint32>(reader.readU32());                                                         \
+    theme.NAME = QSize{ width, height };                                                                               \
+  }
+  QLEMENTINE_THEME_COLOR_FIELDS(QLEMENTINE_READ_COLOR)
+  QLEMENTINE_THEME_BOOL_FIELDS(QLEMENTINE_READ_BOOL)
+  QLEMENTINE_THEME_INT_FIELDS(QLEMENTINE_READ_INT)
+  QLEMENTINE_THEME_DOUBLE_FIELDS(QLEMENTINE_READ_DOUBLE)
+  QLEMENTINE_THEME_SIZE_FIELDS(QLEMENTINE_READ_SIZE)
+#undef QLEMENTINE_READ_COLOR
+#undef QLEMENTINE_READ_BOOL
+#undef QLEMENTINE_READ_INT
+#undef QLEMENTINE_READ_DOUBLE
+#undef QLEMENTINE_READ_SIZE
+
+  if (!reader.tryReadString(theme.meta.name) || !reader.tryReadString(theme.meta.version)
+      || !reader.tryReadString(theme.meta.author) || !reader.atEnd())
+    return std::nullopt;
+
+  // Fonts and palette depend on the machine (DPI, system fonts), so they can't be stored.
+  theme.updateContentHash();
+  return theme;
+}
+
+QByteArray Theme::toBinary() const {
+  QByteArray payload;
+  payload.reserve(fixedPayloadSize + 128);
+#define QLEMENTINE_WRITE_COLOR(NAME) writeU32(payload, NAME.rgba());
+#define QLEMENTINE_WRITE_BOOL(NAME) writeU32(payload, NAME ? 1u : 0u);
+#define QLEMENTINE_WRITE_INT(NAME) writeU32(payload, static_cast<quint32>(static_cast<qint32>(NAME)));
+#define QLEMENTINE_WRITE_DOUBLE(NAME) writeDouble(payload, NAME);
+#define QLEMENTINE_WRITE_SIZE(NAME)                                                                                    \
+  writeU32(payload, static_cast<quint32>(static_cast<qint32>(NAME.width())));                                          \
+  writeU32(payload, static_cast<quint32>(static_cast<qint32>(NAME.height())));
+  QLEMENTINE_THEME_COLOR_FIELDS(QLEMENTINE_WRITE_COLOR)
+  QLEMENTINE_THEME_BOOL_FIELDS(QLEMENTINE_WRITE_BOOL)
+  QLEMENTINE_THEME_INT_FIELDS(QLEMENTINE_WRITE_INT)
+  QLEMENTINE_THEME_DOUBLE_FIELDS(QLEMENTINE_WRITE_DOUBLE)
+  QLEMENTINE_THEME_SIZE_FIELDS(QLEMENTINE_WRITE_SIZE)
+#undef QLEMENTINE_WRITE_COLOR
+#undef QLEMENTINE_WRITE_BOOL
+#undef QLEMENTINE_WRITE_INT
+#undef QLEMENTINE_WRITE_DOUBLE
+#undef QLEMENTINE_WRITE_SIZE
+  writeString(payload, meta.name);
+  writeString(payload, meta.version);
+  writeString(payload, meta.author);
+
+  QByteArray result;
+  result.reserve(headerSize + payload.size());
+  result.append(binaryMagic, sizeof(binaryMagic));
+  writeU32(result, binaryFormatVersion);
+  writeU32(result, static_cast<quint32>(payload.size()));
+  writeU32(result, checksum(payload.constData(), payload.size()));
+  result.append(payload);
+  return result;
+}
+
+bool Theme::convertJsonToBinary(const QString& jsonPath, const QString& binaryPath) {
+  const auto theme = fromJsonPath(jsonPath);
+  if (!theme.has_value())
+    return false;
+
+  // Never leave a partially written file, that would be rejected at load time anyway.
+  QSaveFile file(binaryPath);
+  if (!file.open(QIODevice::WriteOnly))
+    return false;
+
+  const auto data = theme->toBinary();
+  if (file.write(data) != data.size())
+    return false;
+
+  return file.commit();
+}
+} // namespace oclero::qlementine
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ThemeDiff.hpp"
+#include "ThemeFields.hpp"
+
+namespace oclero::qlementine {
+ThemeChanges diffThemes(const Theme& oldTheme, const Theme& newTheme) {
+  ThemeChanges result{ ThemeChange::None };
+
+  if (oldTheme.meta != newTheme.meta) {
+    result |= ThemeChange::Meta;
+  }
+
+#define QLEMENTINE_DIFF_FIELD(NAME, CHANGE)                                                                            \
+  if (!result.testFlag(CHANGE) && oldTheme.NAME != newTheme.NAME) {                                                    \
+    result |= CHANGE;                                                                                                  \
+  }
+#define QLEMENTINE_DIFF_COLOR(NAME) QLEMENTINE_DIFF_FIELD(NAME, ThemeChange::Colors)
+#define QLEMENTINE_DIFF_FONT(NAME) QLEMENTINE_DIFF_FIELD(NAME, ThemeChange::Fonts)
+#define QLEMENTINE_DIFF_METRIC(NAME) QLEMENTINE_DIFF_FIELD(NAME, ThemeChange::Metrics)
+  QLEMENTINE_THEME_COLOR_FIELDS(QLEMENTINE_DIFF_COLOR)
+  QLEMENTINE_DIFF_COLOR(palette)
+
+  QLEMENTINE_THEME_BOOL_FIELDS(QLEMENTINE_DIFF_FONT)
+  QLEMENTINE_THEME_FONT_SIZE_FIELDS(QLEMENTINE_DIFF_FONT)
+  // Fonts are generated, but also depend on the screen and system fonts when they were generated.
+  QLEMENTINE_DIFF_FONT(fontRegular)
+  QLEMENTINE_DIFF_FONT(fontBold)
+  QLEMENTINE_DIFF_FONT(fontH1)
+  QLEMENTINE_DIFF_FONT(fontH2)
+  QLEMENTINE_DIFF_FONT(fontH3)
+  QLEMENTINE_DIFF_FONT(fontH4)
+  QLEMENTINE_DIFF_FONT(fontH5)
+  QLEMENTINE_DIFF_FONT(fontCaption)
+  QLEMENTINE_DIFF_FONT(fontMonospace)
+
+  QLEMENTINE_THEME_METRIC_INT_FIELDS(QLEMENTINE_DIFF_METRIC)
+  QLEMENTINE_THEME_DOUBLE_FIELDS(QLEMENTINE_DIFF_METRIC)
+  QLEMENTINE_THEME_SIZE_FIELDS(QLEMENTINE_DIFF_METRIC)
+#undef QLEMENTINE_DIFF_COLOR
+#undef QLEMENTINE_DIFF_FONT
+#undef QLEMENTINE_DIFF_METRIC
+#undef QLEMENTINE_DIFF_FIELD
+
+  return result;
+}
+} // namespace oclero::qlementine
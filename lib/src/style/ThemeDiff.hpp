@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <oclero/qlementine/style/Theme.hpp>
+
+#include <QFlags>
+
+#include <cstdint>
+
+namespace oclero::qlementine {
+/// What differs between two themes, to only invalidate what depends on it.
+enum class ThemeChange : std::uint8_t {
+  None = 0,
+  /// Name, version or author: nothing to repaint.
+  Meta = 1 << 0,
+  /// Colors and palette: repaint, but no relayout.
+  Colors = 1 << 1,
+  /// Sizes, radiuses, spacings, durations: size hints change, so widgets must be laid out again.
+  Metrics = 1 << 2,
+  /// Font sizes or families: font metrics and size hints change.
+  Fonts = 1 << 3,
+};
+Q_DECLARE_FLAGS(ThemeChanges, ThemeChange)
+Q_DECLARE_OPERATORS_FOR_FLAGS(ThemeChanges)
+
+ThemeChanges diffThemes(const Theme& oldTheme, const Theme& newTheme);
+} // namespace oclero::qlementine
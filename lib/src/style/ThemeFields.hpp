@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Lists of the Theme's values, by type, in a stable order.
+// Used to serialize, hash or compare all the values without having to repeat the ~150 names.
+// NB: Changing these lists changes the binary theme format, so Theme's binaryFormatVersion must be increased.
+
+#define QLEMENTINE_THEME_COLOR_FIELDS(X)                                                                               \
+  X(backgroundColorMain1)                                                                                              \
+  X(backgroundColorMain2)                                                                                              \
+  X(backgroundColorMain3)                                                                                              \
+  X(backgroundColorMain4)                                                                                              \
+  X(backgroundColorMainTransparent)                                                                                    \
+  X(backgroundColorWorkspace)                                                                                          \
+  X(backgroundColorTabBar)                                                                                             \
+  X(neutralColor)                                                                                                      \
+  X(neutralColorHovered)                                                                                               \
+  X(neutralColorPressed)                                                                                               \
+  X(neutralColorDisabled)                                                                                              \
+  X(neutralColorTransparent)                                                                                           \
+  X(focusColor)                                                                                                        \
+  X(primaryColor)                                                                                                      \
+  X(primaryColorHovered)                                                                                               \
+  X(primaryColorPressed)                                                                                               \
+  X(primaryColorDisabled)                                                                                              \
+  X(primaryColorTransparent)                                                                                           \
+  X(primaryColorForeground)                                                                                            \
+  X(primaryColorForegroundHovered)                                                                                     \
+  X(primaryColorForegroundPressed)                                                                                     \
+  X(primaryColorForegroundDisabled)                                                                                    \
+  X(primaryColorForegroundTransparent)                                                                                 \
+  X(primaryAlternativeColor)                                                                                           \
+  X(primaryAlternativeColorHovered)                                                                                    \
+  X(primaryAlternativeColorPressed)                                                                                    \
+  X(primaryAlternativeColorDisabled)                                                                                   \
+  X(primaryAlternativeColorTransparent)                                                                                \
+  X(secondaryColor)                                                                                                    \
+  X(secondaryColorHovered)                                                                                             \
+  X(secondaryColorPressed)                                                                                             \
+  X(secondaryColorDisabled)                                                                                            \
+  X(secondaryColorTransparent)                                                                                         \
+  X(secondaryColorForeground)                                                                                          \
+  X(secondaryColorForegroundHovered)                                                                                   \
+  X(secondaryColorForegroundPressed)                                                                                   \
+  X(secondaryColorForegroundDisabled)                                                                                  \
+  X(secondaryColorForegroundTransparent)                                                                               \
+  X(secondaryAlternativeColor)                                                                                         \
+  X(secondaryAlternativeColorHovered)                                                                                  \
+  X(secondaryAlternativeColorPressed)                                                                                  \
+  X(secondaryAlternativeColorDisabled)                                                                                 \
+  X(secondaryAlternativeColorTransparent)                                                                              \
+  X(statusColorSuccess)                                                                                                \
+  X(statusColorSuccessHovered)                                                                                         \
+  X(statusColorSuccessPressed)                                                                                         \
+  X(statusColorSuccessDisabled)                                                                                        \
+  X(statusColorInfo)                                                                                                   \
+  X(statusColorInfoHovered)                                                                                            \
+  X(statusColorInfoPressed)                                                                                            \
+  X(statusColorInfoDisabled)                                                                                           \
+  X(statusColorWarning)                                                                                                \
+  X(statusColorWarningHovered)                                                                                         \
+  X(statusColorWarningPressed)                                                                                         \
+  X(statusColorWarningDisabled)                                                                                        \
+  X(statusColorError)                                                                                                  \
+  X(statusColorErrorHovered)                                                                                           \
+  X(statusColorErrorPressed)                                                                                           \
+  X(statusColorErrorDisabled)                                                                                          \
+  X(statusColorForeground)                                                                                             \
+  X(statusColorForegroundHovered)                                                                                      \
+  X(statusColorForegroundPressed)                                                                                      \
+  X(statusColorForegroundDisabled)                                                                                     \
+  X(shadowColor1)                                                                                                      \
+  X(shadowColor2)                                                                                                      \
+  X(shadowColor3)                                                                                                      \
+  X(shadowColorTransparent)                                                                                            \
+  X(borderColor)                                                                                                       \
+  X(borderColorHovered)                                                                                                \
+  X(borderColorPressed)                                                                                                \
+  X(borderColorDisabled)                                                                                               \
+  X(borderColorTransparent)                                                                                            \
+  X(semiTransparentColor1)                                                                                             \
+  X(semiTransparentColor2)                                                                                             \
+  X(semiTransparentColor3)                                                                                             \
+  X(semiTransparentColor4)                                                                                             \
+  X(semiTransparentColorTransparent)
+
+#define QLEMENTINE_THEME_BOOL_FIELDS(X) X(useSystemFonts)
+
+#define QLEMENTINE_THEME_INT_FIELDS(X)                                                                                 \
+  QLEMENTINE_THEME_FONT_SIZE_FIELDS(X)                                                                                 \
+  QLEMENTINE_THEME_METRIC_INT_FIELDS(X)
+
+// Values the fonts are generated from.
+#define QLEMENTINE_THEME_FONT_SIZE_FIELDS(X)                                                                           \
+  X(fontSize)                                                                                                          \
+  X(fontSizeMonospace)                                                                                                 \
+  X(fontSizeH1)                                                                                                        \
+  X(fontSizeH2)                                                                                                        \
+  X(fontSizeH3)                                                                                                        \
+  X(fontSizeH4)                                                                                                        \
+  X(fontSizeH5)                                                                                                        \
+  X(fontSizeS1)
+
+#define QLEMENTINE_THEME_METRIC_INT_FIELDS(X)                                                                          \
+  X(animationDuration)                                                                                                 \
+  X(focusAnimationDuration)                                                                                            \
+  X(sliderAnimationDuration)                                                                                           \
+  X(borderWidth)                                                                                                       \
+  X(controlHeightLarge)                                                                                                \
+  X(controlHeightMedium)                                                                                               \
+  X(controlHeightSmall)                                                                                                \
+  X(controlDefaultWidth)                                                                                               \
+  X(dialMarkLength)                                                                                                    \
+  X(dialMarkThickness)                                                                                                 \
+  X(dialTickLength)                                                                                                    \
+  X(dialTickSpacing)                                                                                                   \
+  X(dialGrooveThickness)                                                                                               \
+  X(focusBorderWidth)                                                                                                  \
+  X(sliderTickSize)                                                                                                    \
+  X(sliderTickSpacing)                                                                                                 \
+  X(sliderTickThickness)                                                                                               \
+  X(sliderGrooveHeight)                                                                                                \
+  X(progressBarGrooveHeight)                                                                                           \
+  X(spacing)                                                                                                           \
+  X(scrollBarThicknessFull)                                                                                            \
+  X(scrollBarThicknessSmall)                                                                                           \
+  X(scrollBarMargin)                                                                                                   \
+  X(tabBarPaddingTop)                                                                                                  \
+  X(tabBarTabMaxWidth)                                                                                                 \
+  X(tabBarTabMinWidth)
+
+#define QLEMENTINE_THEME_DOUBLE_FIELDS(X)                                                                              \
+  X(borderRadius)                                                                                                      \
+  X(checkBoxBorderRadius)                                                                                              \
+  X(menuItemBorderRadius)                                                                                              \
+  X(menuBarItemBorderRadius)
+
+#define QLEMENTINE_THEME_SIZE_FIELDS(X)                                                                                \
+  X(iconSize)                                                                                                          \
+  X(iconSizeMedium)                                                                                                    \
+  X(iconSizeLarge)                                                                                                     \
+  X(iconSizeExtraSmall)
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "ThemeFileWatcher.hpp"
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QThreadPool>
+
+#include <utility>
+
+namespace oclero::qlementine {
+namespace {
+// Long enough to merge the writes of a single save, short enough to feel immediate.
+constexpr auto debounceDelay = 150;
+} // namespace
+
+ThemeFileWatcher::ThemeFileWatcher(LoadedFunc onLoaded, ErrorFunc onError)
+  : _onLoaded(std::move(onLoaded))
+  , _onError(std::move(onError))
+  , _latestReload(std::make_shared<quint64>(0)) {
+  _debounceTimer.setSingleShot(true);
+  _debounceTimer.setInterval(debounceDelay);
+  QObject::connect(&_debounceTimer, &QTimer::timeout, &_debounceTimer, [this]() {
+    reload();
+  });
+  QObject::connect(&_watcher, &QFileSystemWatcher::fileChanged, &_watcher, [this]() {
+    onFileChanged();
+  });
+  // Editors that save by replacing the file make it disappear for a moment, so it must be watched again.
+  QObject::connect(&_watcher, &QFileSystemWatcher::directoryChanged, &_watcher, [this]() {
+    if (!_watcher.files().contains(_path)) {
+      onFileChanged();
+    }
+  });
+}
+
+ThemeFileWatcher::~ThemeFileWatcher() = default;
+
+const QString& ThemeFileWatcher::path() const {
+  return _path;
+}
+
+void ThemeFileWatcher::setPath(const QString& path) {
+  if (path == _path)
+    return;
+
+  if (!_watcher.files().isEmpty()) {
+    _watcher.removePaths(_watcher.files());
+  }
+  if (!_watcher.directories().isEmpty()) {
+    _watcher.removePaths(_watcher.directories());
+  }
+  _debounceTimer.stop();
+  // Results of loads still running are now obsolete.
+  ++*_latestReload;
+  _path = path;
+
+  if (!_path.isEmpty()) {
+    const auto fileInfo = QFileInfo(_path);
+    _watcher.addPath(fileInfo.absolutePath());
+    if (fileInfo.exists()) {
+      _watcher.addPath(_path);
+    }
+  }
+}
+
+void ThemeFileWatcher::onFileChanged() {
+  if (_path.isEmpty())
+    return;
+
+  // The file is no longer watched once it has been replaced.
+  if (!_watcher.files().contains(_path) && QFileInfo::exists(_path)) {
+    _watcher.addPath(_path);
+  }
+  _debounceTimer.start();
+}
+
+void ThemeFileWatcher::reload() {
+  if (!QFileInfo::exists(_path))
+    return;
+
+  const auto reloadId = ++*_latestReload;
+  const auto latestReload = std::weak_ptr<quint64>(_latestReload);
+  const auto path = _path;
+  // Only the file is read and parsed in another thread: fonts and palette need the GUI thread.
+  QThreadPool::globalInstance()->start([this, latestReload, reloadId, path]() {
+    QString error;
+    auto themeOpt = Theme::valuesFromJsonPath(path, error);
+    // The application lives longer than the watcher, so the result is delivered through it, in the GUI thread.
+    QMetaObject::invokeMethod(
+      QCoreApplication::instance(),
+      [this, latestReload, reloadId, themeOpt = std::move(themeOpt), error]() mutable {
+        // Ignore the result if the watcher has been destroyed, or if the file has changed again meanwhile.
+        const auto latest = latestReload.lock();
+        if (!latest || *latest != reloadId)
+          return;
+
+        if (themeOpt.has_value()) {
+          themeOpt->generateFontsAndPalette();
+          _onLoaded(SharedTheme(std::move(themeOpt.value())));
+        } else {
+          _onError(error);
+        }
+      },
+      Qt::QueuedConnection);
+  });
+}
+} // namespace oclero::qlementine
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <oclero/qlementine/style/Theme.hpp>
+
+#include <QFileSystemWatcher>
+#include <QString>
+#include <QTimer>
+
+#include <functional>
+#include <memory>
+
+namespace oclero::qlementine {
+/// Reloads a JSON theme file each time it is saved.
+/// Changes are debounced, since editors often write a file in several steps, and the file is parsed in a
+/// background thread. The theme is completed and callbacks are called in the GUI thread, only for the latest change.
+class ThemeFileWatcher {
+public:
+  using LoadedFunc = std::function<void(const SharedTheme& theme)>;
+  using ErrorFunc = std::function<void(const QString& error)>;
+
+  ThemeFileWatcher(LoadedFunc onLoaded, ErrorFunc onError);
+  ~ThemeFileWatcher();
+
+  const QString& path() const;
+  /// Starts watching the file. An empty path stops watching.
+  void setPath(const QString& path);
+
+private:
+  void onFileChanged();
+  void reload();
+
+  LoadedFunc _onLoaded;
+  ErrorFunc _onError;
+  QString _path;
+  QFileSystemWatcher _watcher;
+  QTimer _debounceTimer;
+  // Identifies the latest reload. Background loads check it, and whether the watcher still exists, through a weak_ptr.
+  std::shared_ptr<quint64> _latestReload;
+};
+} // namespace oclero::qlementine
@@ -4,8 +4,30 @@
 #include <oclero/qlementine/style/ThemeManager.hpp>
 
 #include <QDir>
+#include <QThreadPool>
+
+#include <memory>
 
 namespace oclero::qlementine {
+namespace {
+bool isBinaryThemePath(const QString& path) {
+  return QFileInfo(path).suffix().toLower() == QString::fromLatin1(Theme::binaryFileSuffix);
+}
+
+std::optional<Theme> loadTheme(const QString& path) {
+  return isBinaryThemePath(path) ? Theme::fromBinaryPath(path) : Theme::fromJsonPath(path);
+}
+
+/// Only reads the values, so it can be called from any thread (see Theme::generateFontsAndPalette()).
+std::optional<Theme> loadThemeValues(const QString& path) {
+  return isBinaryThemePath(path) ? Theme::valuesFromBinaryPath(path) : Theme::valuesFromJsonPath(path);
+}
+
+std::optional<ThemeMeta> loadThemeMeta(const QString& path) {
+  return isBinaryThemePath(path) ? Theme::metaFromBinaryPath(path) : Theme::metaFromJsonPath(path);
+}
+} // namespace
+
 ThemeManager::ThemeManager(QObject* parent)
   : ThemeManager(nullptr, parent) {}
 
@@ -30,19 +52,32 @@ void ThemeManager::setStyle(QlementineStyle* style) {
   }
 }
 
-const std::vector<Theme>& ThemeManager::themes() const {
-  return _themes;
+std::vector<SharedTheme> ThemeManager::themes() const {
+  std::vector<SharedTheme> result;
+  result.reserve(_entries.size());
+  for (auto i = 0; i < themeCount(); ++i) {
+    result.emplace_back(ensureLoaded(i));
+  }
+  return result;
+}
+
+const SharedTheme& ThemeManager::theme(int index) const {
+  return ensureLoaded(index);
 }
 
 void ThemeManager::addTheme(const Theme& theme) {
-  _themes.emplace_back(theme);
-  Q_EMIT themeCountChanged();
-  if (_currentIndex < 0) {
-    setCurrentThemeIndex(0);
-  }
+  addTheme(SharedTheme(theme));
+}
+
+void ThemeManager::addTheme(const SharedTheme& theme) {
+  addEntry(Entry{ theme->meta, {}, theme, {} });
+}
+
+const ThemeMeta& ThemeManager::themeMeta(int index) const {
+  return _entries.at(index).meta;
 }
 
-void ThemeManager::loadDirectory(const QString& path) {
+void ThemeManager::loadDirectory(const QString& path, LoadingMode mode) {
   QDir dir(path);
   if (!dir.exists())
     return;
@@ -50,20 +85,50 @@ void ThemeManager::loadDirectory(const QString& path) {
   dir.setFilter(QDir::Filter::Files | QDir::Filter::NoDotAndDotDot);
   dir.setSorting(QDir::SortFlag::Name | QDir::SortFlag::IgnoreCase);
   const auto files = dir.entryInfoList();
+  const auto binarySuffix = QString::fromLatin1(Theme::binaryFileSuffix);
   for (const auto& file : files) {
     QFileInfo fileInfo(file);
-    if (fileInfo.suffix().toLower() == QStringLiteral("json")) {
-      const auto themeOpt = Theme::fromJsonPath(file.absoluteFilePath());
+    const auto suffix = fileInfo.suffix().toLower();
+    if (suffix == QStringLiteral("json")) {
+      // Skip the JSON source of a compiled theme, to not load it twice.
+      // Compiled themes are way faster to load, and fall back to their JSON source if invalid.
+      const auto binaryPath = dir.filePath(fileInfo.completeBaseName() + '.' + binarySuffix);
+      if (QFileInfo::exists(binaryPath))
+        continue;
+    } else if (suffix != binarySuffix) {
+      continue;
+    }
+
+    const auto filePath = file.absoluteFilePath();
+    if (mode == LoadingMode::Eager) {
+      auto themeOpt = loadTheme(filePath);
       if (themeOpt.has_value()) {
-        addTheme(themeOpt.value());
+        addTheme(SharedTheme(std::move(themeOpt.value())));
       }
+      continue;
     }
+
+    // Only the metadata is needed to list the theme.
+    const auto metaOpt = loadThemeMeta(filePath);
+    if (!metaOpt.has_value())
+      continue;
+
+    Entry entry{ metaOpt.value(), filePath, std::nullopt, {} };
+    if (mode == LoadingMode::Parallel) {
+      // Files are read and parsed in background. Fonts and palette are generated later, in the GUI thread.
+      auto promise = std::make_shared<std::promise<std::optional<Theme>>>();
+      entry.pendingTheme = promise->get_future().share();
+      QThreadPool::globalInstance()->start([promise, filePath]() {
+        promise->set_value(loadThemeValues(filePath));
+      });
+    }
+    addEntry(std::move(entry));
   }
 }
 
 QString ThemeManager::currentTheme() const {
   if (_currentIndex > -1 && _currentIndex < themeCount()) {
-    return _themes.at(_currentIndex).meta.name;
+    return _entries.at(_currentIndex).meta.name;
   }
   return {};
 }
@@ -88,7 +153,7 @@ void ThemeManager::setCurrentThemeIndex(int index) {
 }
 
 int ThemeManager::themeCount() const {
-  return static_cast<int>(_themes.size());
+  return static_cast<int>(_entries.size());
 }
 
 void ThemeManager::setNextTheme() {
@@ -110,25 +175,52 @@ void ThemeManager::setPreviousTheme() {
 }
 
 int ThemeManager::themeIndex(const QString& key) const {
-  const auto it = std::find_if(_themes.begin(), _themes.end(), [&key](const auto& theme) {
-    return theme.meta.name == key;
+  const auto it = std::find_if(_entries.begin(), _entries.end(), [&key](const auto& entry) {
+    return entry.meta.name == key;
   });
-  if (it != _themes.end())
-    return static_cast<int>(std::distance(_themes.begin(), it));
+  if (it != _entries.end())
+    return static_cast<int>(std::distance(_entries.begin(), it));
   return -1;
 }
 
+void ThemeManager::addEntry(Entry&& entry) {
+  _entries.emplace_back(std::move(entry));
+  Q_EMIT themeCountChanged();
+  if (_currentIndex < 0) {
+    setCurrentThemeIndex(0);
+  }
+}
+
+const SharedTheme& ThemeManager::ensureLoaded(int index) const {
+  auto& entry = _entries.at(index);
+  if (!entry.theme.has_value()) {
+    auto themeOpt = entry.pendingTheme.valid() ? entry.pendingTheme.get() : loadThemeValues(entry.path);
+    entry.pendingTheme = {};
+    if (themeOpt.has_value()) {
+      themeOpt->generateFontsAndPalette();
+    } else {
+      // The file has changed since its metadata was read: keep the theme listed, with default values.
+      themeOpt.emplace();
+      themeOpt->meta = entry.meta;
+      themeOpt->updateContentHash();
+    }
+    entry.theme = SharedTheme(std::move(themeOpt.value()));
+  }
+  return entry.theme.value();
+}
+
 void ThemeManager::synchronizeThemeOnStyle() {
   if (!_style)
     return;
 
-  if (_themes.empty())
+  if (_entries.empty())
     return;
 
   if (_currentIndex >= 0 && _currentIndex < themeCount()) {
-    _style->setTheme(_themes.at(_currentIndex));
+    // Only a pointer is copied, since the style shares the loaded theme.
+    _style->setTheme(ensureLoaded(_currentIndex));
   } else {
-    addTheme(_style->theme());
+    addTheme(_style->sharedTheme());
     setCurrentThemeIndex(themeCount() - 1);
   }
 }
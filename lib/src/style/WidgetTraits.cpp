@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "WidgetTraits.hpp"
+
+#include <oclero/qlementine/utils/StyleUtils.hpp>
+
+#include <QAbstractItemView>
+#include <QAbstractSpinBox>
+#include <QComboBox>
+#include <QDateTimeEdit>
+#include <QDial>
+#include <QLineEdit>
+#include <QMenu>
+#include <QMenuBar>
+#include <QPlainTextEdit>
+#include <QTabBar>
+
+#include <algorithm>
+
+namespace oclero::qlementine {
+WidgetTraits computeWidgetTraits(const QWidget* widget) {
+  WidgetTraits result{ WidgetTrait::None };
+  if (!widget)
+    return result;
+
+  const auto* parent = widget->parentWidget();
+  const auto* grandParent = parent ? parent->parentWidget() : nullptr;
+  const auto* greatGrandParent = grandParent ? grandParent->parentWidget() : nullptr;
+
+  result.setFlag(WidgetTrait::LineEdit, qobject_cast<const QLineEdit*>(widget) != nullptr);
+  // The QExpandingLineEdit class is used by QStyleItemDelegate when the cell context type is text.
+  result.setFlag(WidgetTrait::ExpandingLineEdit,
+    widget->metaObject()->className() == QStringLiteral("QExpandingLineEdit"));
+  result.setFlag(WidgetTrait::PlainTextEdit, qobject_cast<const QPlainTextEdit*>(widget) != nullptr);
+  result.setFlag(WidgetTrait::Menu, qobject_cast<const QMenu*>(widget) != nullptr);
+  result.setFlag(WidgetTrait::Dial, qobject_cast<const QDial*>(widget) != nullptr);
+  result.setFlag(WidgetTrait::DateTimeEdit, qobject_cast<const QDateTimeEdit*>(widget) != nullptr);
+  result.setFlag(WidgetTrait::LineEditIconButton, widget->inherits("QLineEditIconButton"));
+  result.setFlag(WidgetTrait::MenuBarExtension, widget->inherits("QMenuBarExtension"));
+  result.setFlag(WidgetTrait::ParentIsTabBar, qobject_cast<const QTabBar*>(parent) != nullptr);
+  result.setFlag(WidgetTrait::ParentIsMenuBar, qobject_cast<const QMenuBar*>(parent) != nullptr);
+  result.setFlag(WidgetTrait::ParentIsComboBox, qobject_cast<const QComboBox*>(parent) != nullptr);
+  result.setFlag(WidgetTrait::ParentIsSpinBox, qobject_cast<const QAbstractSpinBox*>(parent) != nullptr);
+  result.setFlag(WidgetTrait::GrandParentIsItemView, qobject_cast<const QAbstractItemView*>(grandParent) != nullptr);
+  result.setFlag(
+    WidgetTrait::GreatGrandParentIsItemView, qobject_cast<const QAbstractItemView*>(greatGrandParent) != nullptr);
+  result.setFlag(WidgetTrait::HoverEvents, shouldHaveHoverEvents(widget));
+  result.setFlag(WidgetTrait::MouseTracking, shouldHaveMouseTracking(widget));
+  return result;
+}
+
+WidgetTraits WidgetTraitsTable::insert(const QWidget* widget) {
+  if (!widget)
+    return WidgetTrait::None;
+
+  auto& entry = _entries[widget];
+  entry = makeEntry(widget);
+  purge();
+  return entry.traits;
+}
+
+void WidgetTraitsTable::remove(const QWidget* widget) {
+  _entries.erase(widget);
+}
+
+WidgetTraits WidgetTraitsTable::traits(const QWidget* widget) const {
+  if (!widget)
+    return WidgetTrait::None;
+
+  // Widgets that are not polished by the style are stored too, so they are not classified at each paint.
+  auto& entry = _entries[widget];
+  if (!isUpToDate(entry, widget)) {
+    entry = makeEntry(widget);
+    purge();
+  }
+  return entry.traits;
+}
+
+WidgetTraitsTable::Entry WidgetTraitsTable::makeEntry(const QWidget* widget) {
+  Entry entry;
+  entry.widget = widget;
+  entry.parent = widget->parentWidget();
+  entry.grandParent = entry.parent ? entry.parent->parentWidget() : nullptr;
+  entry.greatGrandParent = entry.grandParent ? entry.grandParent->parentWidget() : nullptr;
+  entry.traits = computeWidgetTraits(widget);
+  return entry;
+}
+
+bool WidgetTraitsTable::isUpToDate(const Entry& entry, const QWidget* widget) {
+  if (entry.widget != widget)
+    return false;
+
+  const auto* parent = widget->parentWidget();
+  const auto* grandParent = parent ? parent->parentWidget() : nullptr;
+  const auto* greatGrandParent = grandParent ? grandParent->parentWidget() : nullptr;
+  return entry.parent == parent && entry.grandParent == grandParent && entry.greatGrandParent == greatGrandParent;
+}
+
+void WidgetTraitsTable::purge() const {
+  if (_entries.size() < _purgeSize)
+    return;
+
+  for (auto it = _entries.begin(); it != _entries.end();) {
+    if (it->second.widget.isNull()) {
+      it = _entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // Amortized: the next purge happens when the number of entries has doubled.
+  _purgeSize = std::max<std::size_t>(256, _entries.size() * 2);
+}
+} // namespace oclero::qlementine
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QWidget>
+#include <QFlags>
+#include <QPointer>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace oclero::qlementine {
+/// What the style needs to know about a widget (and its ancestors) to draw it.
+enum class WidgetTrait : std::uint32_t {
+  None = 0,
+  LineEdit = 1 << 0,
+  ExpandingLineEdit = 1 << 1,
+  PlainTextEdit = 1 << 2,
+  Menu = 1 << 3,
+  Dial = 1 << 4,
+  DateTimeEdit = 1 << 5,
+  LineEditIconButton = 1 << 6,
+  MenuBarExtension = 1 << 7,
+  ParentIsTabBar = 1 << 8,
+  ParentIsMenuBar = 1 << 9,
+  ParentIsComboBox = 1 << 10,
+  ParentIsSpinBox = 1 << 11,
+  GrandParentIsItemView = 1 << 12,
+  GreatGrandParentIsItemView = 1 << 13,
+  HoverEvents = 1 << 14,
+  MouseTracking = 1 << 15,
+};
+Q_DECLARE_FLAGS(WidgetTraits, WidgetTrait)
+Q_DECLARE_OPERATORS_FOR_FLAGS(WidgetTraits)
+
+/// Classifies the widget. This is made of many casts, so prefer WidgetTraitsTable::traits().
+WidgetTraits computeWidgetTraits(const QWidget* widget);
+
+/// Widget traits computed once per widget,
+/// so the style doesn't need to cast them again each time they are painted or measured.
+class WidgetTraitsTable {
+public:
+  /// Computes and stores the traits of the widget.
+  WidgetTraits insert(const QWidget* widget);
+
+  /// Forgets the widget.
+  void remove(const QWidget* widget);
+
+  /// Gets the stored traits, or computes and stores them if the widget is unknown or one of its ancestors changed.
+  WidgetTraits traits(const QWidget* widget) const;
+
+private:
+  struct Entry {
+    // Null once the widget is destroyed, even if another widget gets the same address.
+    QPointer<const QWidget> widget;
+    // The traits depend on these ancestors.
+    const QWidget* parent{ nullptr };
+    const QWidget* grandParent{ nullptr };
+    const QWidget* greatGrandParent{ nullptr };
+    WidgetTraits traits;
+  };
+
+  static Entry makeEntry(const QWidget* widget);
+  static bool isUpToDate(const Entry& entry, const QWidget* widget);
+  /// Removes the entries of destroyed widgets, when the table has grown enough since last time.
+  void purge() const;
+
+  mutable std::unordered_map<const QWidget*, Entry> _entries;
+  mutable std::size_t _purgeSize{ 256 };
+};
+} // namespace oclero::qlementine
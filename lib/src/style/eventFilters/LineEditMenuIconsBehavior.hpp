@@ -118,58 +118,4 @@ public:
     });
   }
 };
-
-class LineEditMenuEventFilter : public QObject {
-public:
-  explicit LineEditMenuEventFilter(QWidget* parent)
-    : QObject(parent) {
-    assert(parent);
-    // Might be a menu's submenu.
-    if (auto* menu = qobject_cast<QMenu*>(parent)) {
-      new LineEditMenuIconsBehavior(menu);
-    } else {
-      // The QLineEdit.
-      parent->installEventFilter(this);
-    }
-  }
-
-protected:
-  bool eventFilter(QObject*, QEvent* evt) override {
-    if (evt->type() == QEvent::ChildPolished) {
-      constexpr auto propertyName = "qlementine_tweak_menu_icons";
-      auto* child = static_cast<QChildEvent*>(evt)->child();
-
-      const auto tweaked = child->property(propertyName).toBool();
-      if (!tweaked) {
-        child->setProperty(propertyName, true);
-
-        // QLineEdit child of QSpinBox.
-        if (auto* lineEdit = qobject_cast<QLineEdit*>(child)) {
-          lineEdit->installEventFilter(this);
-
-        }
-        // Qmenu that needs tweaking.
-        else if (auto* menu = qobject_cast<QMenu*>(child)) {
-          new LineEditMenuIconsBehavior(menu);
-
-          // Forward auto icon color mode from parent to the menu.
-          if (const auto* menuParent = menu->parentWidget()) {
-            if (const auto* style = qobject_cast<oclero::qlementine::QlementineStyle*>(menuParent->style())) {
-              const auto autoIconColor = style->autoIconColor(menuParent);
-              QlementineStyle::setAutoIconColor(menu, autoIconColor);
-            }
-          }
-        }
-        // Case of a QPlainTextEdit (inherits QAbstractScrollArea).
-        else if (child->objectName() == "qt_scrollarea_viewport") {
-          if (auto* childWidget = qobject_cast<QWidget*>(child)) {
-            childWidget->installEventFilter(this);
-          }
-        }
-      }
-    }
-
-    return false;
-  }
-};
 } // namespace oclero::qlementine
@@ -28,9 +28,11 @@
 
 #define ADD_COLOR_EDITOR(NAME, DESCRIPTION) \
   { \
-    const auto pair = makeColorEditorAndLabel(#NAME, DESCRIPTION, &owner, theme.NAME, [this](const QColor& c) { \
-      theme.NAME = c; \
-      Q_EMIT owner.themeChanged(theme); \
+    const auto pair = makeColorEditorAndLabel(#NAME, DESCRIPTION, &owner, theme->NAME, [this](const QColor& c) { \
+      ThemeBuilder builder(theme); \
+      builder->NAME = c; \
+      theme = builder.build(); \
+      Q_EMIT owner.themeChanged(*theme); \
     }); \
     this->NAME##Editor = pair.second; \
     formLayout->addRow(pair.first, pair.second); \
@@ -39,8 +41,10 @@
 #define ADD_METADATA_TEXT_EDITOR(NAME, DESCRIPTION) \
   { \
     const auto pair = makeTextEditorAndLabel(#NAME, DESCRIPTION, &owner, [this](const QString& s) { \
-      theme.meta.NAME = s; \
-      Q_EMIT owner.themeChanged(theme); \
+      ThemeBuilder builder(theme); \
+      builder->meta.NAME = s; \
+      theme = builder.build(); \
+      Q_EMIT owner.themeChanged(*theme); \
     }); \
     this->NAME##Editor = pair.second; \
     formLayout->addRow(pair.first, pair.second); \
@@ -48,12 +52,12 @@
 
 #define UPDATE_COLOR_EDITOR(NAME) \
   this->NAME##Editor->blockSignals(true); \
-  this->NAME##Editor->setColor(theme.NAME); \
+  this->NAME##Editor->setColor(theme->NAME); \
   this->NAME##Editor->blockSignals(false);
 
 #define UPDATE_METADATA_TEXT_EDITOR(NAME) \
   this->NAME##Editor->blockSignals(true); \
-  this->NAME##Editor->setText(theme.meta.NAME); \
+  this->NAME##Editor->setText(theme->meta.NAME); \
   this->NAME##Editor->blockSignals(false);
 
 namespace oclero::qlementine {
@@ -251,7 +255,7 @@ struct ThemeEditor::Impl {
         const auto fileName =
           QFileDialog::getSaveFileName(&owner, "Save JSON theme", previousPath, "JSON Files (*.json)");
         if (!fileName.isEmpty()) {
-          const auto jsonDoc = theme.toJson();
+          const auto jsonDoc = theme->toJson();
           const auto data = QByteArray(jsonDoc.toJson(QJsonDocument::JsonFormat::Indented).replace("    ", "  "));
           QFile file(fileName);
           if (file.open(QIODevice::ReadWrite)) {
@@ -497,7 +501,7 @@ struct ThemeEditor::Impl {
   }
 
   ThemeEditor& owner;
-  Theme theme;
+  SharedTheme theme;
 };
 
 ThemeEditor::ThemeEditor(QWidget* parent)
@@ -509,14 +513,24 @@ ThemeEditor::ThemeEditor(QWidget* parent)
 ThemeEditor::~ThemeEditor() = default;
 
 const Theme& ThemeEditor::theme() const {
+  return *_impl->theme;
+}
+
+const SharedTheme& ThemeEditor::sharedTheme() const {
   return _impl->theme;
 }
 
 void ThemeEditor::setTheme(const Theme& theme) {
+  if (theme != *_impl->theme) {
+    setTheme(SharedTheme(theme));
+  }
+}
+
+void ThemeEditor::setTheme(const SharedTheme& theme) {
   if (theme != _impl->theme) {
     _impl->theme = theme;
     _impl->updateUi();
-    Q_EMIT themeChanged(_impl->theme);
+    Q_EMIT themeChanged(*_impl->theme);
   }
 }
 } // namespace oclero::qlementine
@@ -7,6 +7,8 @@
 
 #include <QDebug>
 
+#include <algorithm>
+
 namespace oclero::qlementine {
 constexpr auto HEX_BASE = 16;
 
@@ -79,6 +81,14 @@ QColor getColorSourceOver(const QColor& bg, const QColor& fg) {
   return finalColor;
 }
 
+QColor interpolateColor(const QColor& from, const QColor& to, qreal progress) {
+  const auto interpolate = [progress](int a, int b) {
+    return std::clamp(static_cast<int>(a + (b - a) * progress), 0, 255);
+  };
+  return QColor(interpolate(from.red(), to.red()), interpolate(from.green(), to.green()),
+    interpolate(from.blue(), to.blue()), interpolate(from.alpha(), to.alpha()));
+}
+
 std::optional<QColor> tryGetColorFromVariantList(QVariantList const& variantList) {
   const auto variantListSize = variantList.size();
   if (variantListSize == 3 || variantListSize == 4) {
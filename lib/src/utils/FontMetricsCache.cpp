@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "FontMetricsCache.hpp"
+
+#include <QGuiApplication>
+#include <QScreen>
+
+#include <atomic>
+
+namespace oclero::qlementine {
+namespace {
+// Increased by invalidateAll(). Caches compare it to the value they were filled with.
+std::atomic<quint64> fontMetricsEpoch{ 1 };
+
+int logicalDpi(const QPaintDevice* device) {
+  if (device) {
+    return device->logicalDpiY();
+  }
+  const auto* screen = QGuiApplication::primaryScreen();
+  return screen ? qRound(screen->logicalDotsPerInchY()) : 96;
+}
+} // namespace
+
+const QFontMetrics& FontMetricsCache::get(const Theme& theme, Font font, const QPaintDevice* device) {
+  const auto epoch = fontMetricsEpoch.load(std::memory_order_relaxed);
+  if (theme.contentHash() != _themeHash || epoch != _epoch) {
+    clear();
+    _themeHash = theme.contentHash();
+    _epoch = epoch;
+  }
+
+  const auto dpi = logicalDpi(device);
+  const auto key = static_cast<std::uint32_t>(dpi) << 8 | static_cast<std::uint32_t>(font);
+  const auto it = _metrics.find(key);
+  if (it != _metrics.end()) {
+    return it->second;
+  }
+  return _metrics.emplace(key, QFontMetrics(themeFont(theme, font), device)).first->second;
+}
+
+void FontMetricsCache::clear() {
+  _metrics.clear();
+  _themeHash = 0;
+  _epoch = 0;
+}
+
+void FontMetricsCache::invalidateAll() {
+  ++fontMetricsEpoch;
+}
+
+const QFont& FontMetricsCache::themeFont(const Theme& theme, Font font) {
+  switch (font) {
+    case Font::Bold:
+      return theme.fontBold;
+    case Font::Caption:
+      return theme.fontCaption;
+    case Font::H1:
+      return theme.fontH1;
+    case Font::H2:
+      return theme.fontH2;
+    case Font::H3:
+      return theme.fontH3;
+    case Font::H4:
+      return theme.fontH4;
+    case Font::H5:
+      return theme.fontH5;
+    case Font::Monospace:
+      return theme.fontMonospace;
+    case Font::Regular:
+    default:
+      return theme.fontRegular;
+  }
+}
+} // namespace oclero::qlementine
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <oclero/qlementine/style/Theme.hpp>
+
+#include <QFontMetrics>
+#include <QPaintDevice>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace oclero::qlementine {
+/// Metrics of the theme's fonts, computed once per font and per logical DPI.
+/// Screens with different DPIs get their own metrics, so a window moved to another screen is measured correctly,
+/// and windows on the same kind of screen share them.
+class FontMetricsCache {
+public:
+  /// Fonts of the Theme.
+  enum class Font : std::uint8_t {
+    Regular,
+    Bold,
+    Caption,
+    H1,
+    H2,
+    H3,
+    H4,
+    H5,
+    Monospace,
+  };
+
+  /// Metrics of the font, for the DPI of the device (e.g. the widget), or of the primary screen if there is none.
+  /// The metrics of the previous theme are forgotten when the theme changes.
+  const QFontMetrics& get(const Theme& theme, Font font, const QPaintDevice* device);
+
+  void clear();
+
+  /// Makes all the caches forget their metrics, e.g. when system fonts or screens have changed.
+  static void invalidateAll();
+
+private:
+  static const QFont& themeFont(const Theme& theme, Font font);
+
+  std::size_t _themeHash{ 0 };
+  quint64 _epoch{ 0 };
+  // Key is the DPI and the font. References to values are stable.
+  std::unordered_map<std::uint32_t, QFontMetrics> _metrics;
+};
+} // namespace oclero::qlementine
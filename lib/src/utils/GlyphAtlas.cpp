@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "GlyphAtlas.hpp"
+
+#include <QCoreApplication>
+#include <QPaintDevice>
+#include <QHashFunctions>
+
+#include <algorithm>
+#include <cmath>
+
+namespace oclero::qlementine {
+namespace {
+// Glyphs bigger than this are not worth caching.
+constexpr auto maxGlyphExtent = 64;
+// Pages are allocated when needed, and all cleared when the last one is full.
+constexpr auto pageExtent = 512;
+constexpr auto maxPageCount = 4;
+// Number of steps of an animation (e.g. the check mark being drawn) that can be cached.
+constexpr auto progressStepCount = 32;
+
+bool isIntegral(qreal value) {
+  return std::abs(value - std::round(value)) < 0.001;
+}
+} // namespace
+
+QPointer<GlyphAtlas> GlyphAtlas::_instance;
+
+GlyphAtlas::GlyphAtlas(QObject* parent)
+  : QObject(parent) {}
+
+GlyphAtlas& GlyphAtlas::instance() {
+  if (!_instance) {
+    // Owned by the application, so the pixmaps are destroyed before the QGuiApplication.
+    _instance = new GlyphAtlas(QCoreApplication::instance());
+  }
+  return *_instance;
+}
+
+bool GlyphAtlas::Key::operator==(const Key& other) const {
+  return glyph == other.glyph && antialiasing == other.antialiasing && penStyle == other.penStyle
+         && capStyle == other.capStyle && joinStyle == other.joinStyle && brushStyle == other.brushStyle
+         && progressStep == other.progressStep && width == other.width && height == other.height
+         && penWidth == other.penWidth && devicePixelRatio == other.devicePixelRatio && penColor == other.penColor
+         && brushColor == other.brushColor;
+}
+
+std::size_t GlyphAtlas::KeyHash::operator()(const Key& key) const {
+  auto seed = qHashMulti(0, static_cast<int>(key.glyph), key.antialiasing, key.penStyle, key.capStyle, key.joinStyle,
+    key.brushStyle, key.progressStep, key.width, key.height);
+  return qHashMulti(seed, key.penWidth, key.devicePixelRatio, key.penColor, key.brushColor);
+}
+
+void GlyphAtlas::draw(Glyph glyph, const QRect& rect, QPainter* p, qreal progress, PaintFunc paintFunc) {
+  const auto& pen = p->pen();
+  const auto& brush = p->brush();
+  const auto* device = p->device();
+  const auto dpr = device ? device->devicePixelRatio() : 1.;
+
+  // Only cache what can be blitted at the exact same pixels as if it was painted.
+  const auto canUseAtlas =
+    rect.width() > 0 && rect.height() > 0 && rect.width() <= maxGlyphExtent && rect.height() <= maxGlyphExtent
+    && p->transform().type() <= QTransform::TxTranslate
+    && p->compositionMode() == QPainter::CompositionMode_SourceOver
+    && (pen.style() == Qt::NoPen
+        || (pen.style() == Qt::SolidLine && !pen.isCosmetic() && pen.brush().style() == Qt::SolidPattern))
+    && (brush.style() == Qt::NoBrush || brush.style() == Qt::SolidPattern);
+  if (!canUseAtlas) {
+    paintFunc(rect, p, progress);
+    return;
+  }
+
+  // Round caps may overflow the rect.
+  const auto margin = pen.style() == Qt::NoPen ? 1 : static_cast<int>(std::ceil(pen.widthF())) + 1;
+  const auto devicePos = p->transform().map(QPointF(rect.topLeft() - QPoint(margin, margin))) * dpr;
+  if (!isIntegral(devicePos.x()) || !isIntegral(devicePos.y())) {
+    paintFunc(rect, p, progress);
+    return;
+  }
+
+  const auto progressStep = static_cast<int>(std::round(std::clamp(progress, 0., 1.) * progressStepCount));
+  Key key;
+  key.glyph = glyph;
+  key.antialiasing = p->testRenderHint(QPainter::Antialiasing);
+  key.penStyle = static_cast<std::uint8_t>(pen.style());
+  key.capStyle = static_cast<std::uint8_t>(pen.capStyle() >> 4);
+  key.joinStyle = static_cast<std::uint8_t>(pen.joinStyle() >> 6);
+  key.brushStyle = static_cast<std::uint8_t>(brush.style());
+  key.progressStep = progressStep;
+  key.width = rect.width();
+  key.height = rect.height();
+  key.penWidth = pen.style() == Qt::NoPen ? 0 : static_cast<int>(std::round(pen.widthF() * 64.));
+  key.devicePixelRatio = static_cast<int>(std::round(dpr * 100.));
+  key.penColor = pen.style() == Qt::NoPen ? 0 : pen.color().rgba();
+  key.brushColor = brush.style() == Qt::NoBrush ? 0 : brush.color().rgba();
+
+  const auto steppedProgress = progressStep / static_cast<qreal>(progressStepCount);
+  const auto* location = findOrCreate(key, rect, p, steppedProgress, dpr, margin, paintFunc);
+  if (!location) {
+    paintFunc(rect, p, progress);
+    return;
+  }
+
+  const auto& sourceRect = location->sourceRect;
+  const auto targetRect =
+    QRectF(QPointF(rect.topLeft() - QPoint(margin, margin)), QSizeF(sourceRect.size()) / dpr);
+  p->drawPixmap(targetRect, _pages[location->page], QRectF(sourceRect));
+}
+
+void GlyphAtlas::clear() {
+  _locations.clear();
+  _pages.clear();
+  _shelfCursor = {};
+  _shelfHeight = 0;
+}
+
+const GlyphAtlas::Location* GlyphAtlas::findOrCreate(
+  const Key& key, const QRect& rect, QPainter* p, qreal progress, qreal dpr, int margin, PaintFunc paintFunc) {
+  const auto it = _locations.find(key);
+  if (it != _locations.end()) {
+    return &it->second;
+  }
+
+  const auto logicalSize = rect.size() + QSize(margin * 2, margin * 2);
+  const auto deviceSize =
+    QSize(static_cast<int>(std::ceil(logicalSize.width() * dpr)), static_cast<int>(std::ceil(logicalSize.height() * dpr)));
+  Location location;
+  if (!allocate(deviceSize, location)) {
+    return nullptr;
+  }
+
+  // Rasterize the glyph with the same painter state, in the allocated cell.
+  {
+    QPainter painter(&_pages[location.page]);
+    painter.setRenderHint(QPainter::Antialiasing, key.antialiasing);
+    painter.setPen(p->pen());
+    painter.setBrush(p->brush());
+    painter.setClipRect(location.sourceRect);
+    painter.translate(location.sourceRect.topLeft());
+    painter.scale(dpr, dpr);
+    paintFunc(QRect(QPoint(margin, margin), rect.size()), &painter, progress);
+  }
+
+  return &_locations.emplace(key, location).first->second;
+}
+
+bool GlyphAtlas::allocate(const QSize& size, Location& location) {
+  if (size.width() > pageExtent || size.height() > pageExtent)
+    return false;
+
+  // Go to the next shelf, or the next page, when there is no more room.
+  if (!_pages.empty() && _shelfCursor.x() + size.width() > pageExtent) {
+    _shelfCursor = QPoint(0, _shelfCursor.y() + _shelfHeight);
+    _shelfHeight = 0;
+  }
+  if (_pages.empty() || _shelfCursor.y() + size.height() > pageExtent) {
+    if (_pages.size() >= static_cast<std::size_t>(maxPageCount)) {
+      // Full: start again from scratch, glyphs that are still used will be rasterized again.
+      clear();
+    }
+    QPixmap page(pageExtent, pageExtent);
+    page.fill(Qt::transparent);
+    _pages.emplace_back(std::move(page));
+    _shelfCursor = {};
+    _shelfHeight = 0;
+  }
+
+  location.page = _pages.size() - 1;
+  location.sourceRect = QRect(_shelfCursor, size);
+  _shelfCursor.rx() += size.width();
+  _shelfHeight = std::max(_shelfHeight, size.height());
+  return true;
+}
+} // namespace oclero::qlementine
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QObject>
+#include <QPainter>
+#include <QPixmap>
+#include <QPointer>
+#include <QRect>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace oclero::qlementine {
+/// Small indicators that can be rasterized once in the GlyphAtlas.
+enum class Glyph : std::uint8_t {
+  ComboBoxIndicator,
+  CheckBoxIndicator,
+  PartiallyCheckedCheckBoxIndicator,
+  RadioButtonIndicator,
+  SpinBoxPlus,
+  SpinBoxMinus,
+  SpinBoxArrowUp,
+  SpinBoxArrowDown,
+  ArrowRight,
+  ArrowLeft,
+  ArrowDown,
+  ArrowUp,
+  SubMenuIndicator,
+  DoubleArrowRightIndicator,
+  ToolBarExtensionIndicator,
+  CloseIndicator,
+};
+
+/// Small indicator glyphs (check marks, arrows, etc.) are rasterized once per size, pen, brush,
+/// animation progress step and device pixel ratio in a few large pixmaps, then blitted.
+/// When the painter state doesn't allow it (e.g. rotation, large size), the glyph is painted as usual.
+class GlyphAtlas : public QObject {
+public:
+  /// Paints the glyph in the rect, with the painter's pen and brush.
+  using PaintFunc = void (*)(const QRect& rect, QPainter* p, qreal progress);
+
+  static GlyphAtlas& instance();
+
+  /// Draws the glyph from the atlas if possible, or with paintFunc otherwise.
+  void draw(Glyph glyph, const QRect& rect, QPainter* p, qreal progress, PaintFunc paintFunc);
+
+  /// Forgets all the glyphs (e.g. when the theme changes).
+  void clear();
+
+private:
+  explicit GlyphAtlas(QObject* parent);
+
+  struct Key {
+    Glyph glyph{ Glyph::ArrowDown };
+    bool antialiasing{ true };
+    std::uint8_t penStyle{ 0 };
+    std::uint8_t capStyle{ 0 };
+    std::uint8_t joinStyle{ 0 };
+    std::uint8_t brushStyle{ 0 };
+    int progressStep{ 0 };
+    int width{ 0 };
+    int height{ 0 };
+    int penWidth{ 0 }; // In 1/64th of pixel.
+    int devicePixelRatio{ 0 }; // In 1/100th.
+    QRgb penColor{ 0 };
+    QRgb brushColor{ 0 };
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct Location {
+    std::size_t page{ 0 };
+    QRect sourceRect; // In device pixels.
+  };
+
+  const Location* findOrCreate(
+    const Key& key, const QRect& rect, QPainter* p, qreal progress, qreal dpr, int margin, PaintFunc paintFunc);
+  bool allocate(const QSize& size, Location& location);
+
+  static QPointer<GlyphAtlas> _instance;
+  std::vector<QPixmap> _pages;
+  // Shelf packing in the last page.
+  QPoint _shelfCursor;
+  int _shelfHeight{ 0 };
+  std::unordered_map<Key, Location, KeyHash> _locations;
+};
+} // namespace oclero::qlementine
@@ -8,16 +8,24 @@
 #include <oclero/qlementine/utils/ColorUtils.hpp>
 #include <oclero/qlementine/utils/WidgetUtils.hpp>
 
+#include "FontMetricsCache.hpp"
+#include "GlyphAtlas.hpp"
+
 #include <QTextLayout>
 #include <QTextLine>
 #include <QPaintDevice>
 #include <QPainter>
 #include <QPainterPath>
 #include <QPixmapCache>
+#include <QProxyStyle>
 #include <QWindow>
 #include <QApplication>
+#include <QThread>
 
 #include <cmath>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
 
 static constexpr auto QLEMENTINE_PI_4 = 3.14159265358979323846 / 4.;
 
@@ -132,7 +140,87 @@ void drawEllipseBorder(QPainter* p, QRectF const& rect, QColor const& color, qre
   p->drawEllipse(borderRect);
 }
 
-QPainterPath getMultipleRadiusesRectPath(QRectF const& rect, RadiusesF const& radiuses) {
+namespace {
+enum class PathKind : std::uint8_t {
+  MultipleRadiusesRect,
+  RoundedRect,
+  Tab,
+  MenuIndicator,
+  RoundedTriangle,
+};
+
+/// Paths only depend on their size and radiuses, and are the same frame after frame.
+/// They are built once at the origin, then translated to where they are drawn.
+class PathCache {
+public:
+  template<typename Builder>
+  const QPainterPath& get(PathKind kind, const QSizeF& size, const RadiusesF& radiuses, Builder&& build) {
+    const auto key = Key{ kind, size.width(), size.height(), radiuses };
+    const auto it = _index.find(key);
+    if (it != _index.end()) {
+      // Move the path to the front of the list, as the most recently used.
+      _paths.splice(_paths.begin(), _paths, it->second);
+      return it->second->second;
+    }
+
+    // Sizes change when widgets are resized: don't let the cache grow forever.
+    // Paths used by widgets that are still visible are used again soon, so the least recently used are dropped.
+    if (_paths.size() >= maxPathCount) {
+      _index.erase(_paths.back().first);
+      _paths.pop_back();
+    }
+    _paths.emplace_front(key, build(QRectF(QPointF(0., 0.), size), radiuses));
+    _index.emplace(key, _paths.begin());
+    return _paths.front().second;
+  }
+
+private:
+  static constexpr std::size_t maxPathCount = 512;
+
+  struct Key {
+    PathKind kind{ PathKind::MultipleRadiusesRect };
+    qreal width{ 0. };
+    qreal height{ 0. };
+    RadiusesF radiuses;
+
+    bool operator==(const Key& other) const {
+      return kind == other.kind && width == other.width && height == other.height && radiuses == other.radiuses;
+    }
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const {
+      return qHashMulti(0, static_cast<int>(key.kind), key.width, key.height, key.radiuses.topLeft,
+        key.radiuses.topRight, key.radiuses.bottomRight, key.radiuses.bottomLeft);
+    }
+  };
+
+  // Most recently used first.
+  std::list<std::pair<Key, QPainterPath>> _paths;
+  std::unordered_map<Key, std::list<std::pair<Key, QPainterPath>>::iterator, KeyHash> _index;
+};
+
+// Painting may also happen in other threads (e.g. in a QImage), so each thread has its own cache.
+PathCache& pathCache() {
+  thread_local PathCache cache;
+  return cache;
+}
+
+/// Draws the path, built at the origin, at the position.
+void drawPathAt(QPainter* p, const QPainterPath& path, const QPointF& pos) {
+  const auto transformBackup = p->transform();
+  p->translate(pos);
+  p->drawPath(path);
+  p->setTransform(transformBackup);
+}
+
+/// Gets the path, built at the origin, translated at the position.
+QPainterPath pathAt(const QPainterPath& path, const QPointF& pos) {
+  // The cached path is shared when no translation is needed.
+  return pos.isNull() ? path : path.translated(pos);
+}
+
+QPainterPath makeMultipleRadiusesRectPath(QRectF const& rect, RadiusesF const& radiuses) {
   QPainterPath path;
   const auto w = static_cast<qreal>(rect.width());
   const auto h = static_cast<qreal>(rect.height());
@@ -180,6 +268,157 @@ QPainterPath getMultipleRadiusesRectPath(QRectF const& rect, RadiusesF const& ra
   return path;
 }
 
+const QPainterPath& cachedMultipleRadiusesRectPath(QSizeF const& size, RadiusesF const& radiuses) {
+  return pathCache().get(PathKind::MultipleRadiusesRect, size, radiuses, makeMultipleRadiusesRectPath);
+}
+} // namespace
+
+QPainterPath getMultipleRadiusesRectPath(QRectF const& rect, RadiusesF const& radiuses) {
+  return pathAt(cachedMultipleRadiusesRectPath(rect.size(), radiuses), rect.topLeft());
+}
+
+namespace {
+// Set by NinePatchRoundedRectsScope, so each style (and thread) decides for its own drawing.
+thread_local bool ninePatchEnabled = false;
+constexpr std::size_t maxNinePatchCount = 256;
+
+enum class NinePatchKind : std::uint8_t {
+  Fill,
+  Border,
+};
+
+struct NinePatchKey {
+  NinePatchKind kind{ NinePatchKind::Fill };
+  int radius{ 0 }; // In 1/64th of pixel.
+  int borderWidth{ 0 }; // In 1/64th of pixel.
+  int devicePixelRatio{ 1 };
+  QRgb color{ 0 };
+
+  bool operator==(const NinePatchKey& other) const {
+    return kind == other.kind && radius == other.radius && borderWidth == other.borderWidth
+           && devicePixelRatio == other.devicePixelRatio && color == other.color;
+  }
+};
+
+struct NinePatchKeyHash {
+  std::size_t operator()(const NinePatchKey& key) const {
+    return qHashMulti(0, static_cast<int>(key.kind), key.radius, key.borderWidth, key.devicePixelRatio, key.color);
+  }
+};
+
+/// The nine-patches themselves are in the QPixmapCache, so they are evicted with the other generated pixmaps.
+std::unordered_map<NinePatchKey, QPixmapCache::Key, NinePatchKeyHash>& ninePatchKeys() {
+  static std::unordered_map<NinePatchKey, QPixmapCache::Key, NinePatchKeyHash> keys;
+  return keys;
+}
+
+bool isWholeNumber(qreal value) {
+  return std::abs(value - std::round(value)) < 0.001;
+}
+
+void drawRoundedRectBorderPath(
+  QPainter* p, QRectF const& rect, QColor const& color, qreal const borderWidth, qreal const radius) {
+  p->setRenderHint(QPainter::RenderHint::Antialiasing);
+  p->setPen(QPen{ color, borderWidth, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin });
+  p->setBrush(Qt::NoBrush);
+  const auto halfBorderW = borderWidth / 2.;
+  const auto borderRect = rect.marginsRemoved({ halfBorderW, halfBorderW, halfBorderW, halfBorderW });
+  const auto borderRadius = radius - halfBorderW;
+  if (borderRadius < 0.1) {
+    p->drawRect(borderRect);
+  } else {
+    p->drawRoundedRect(borderRect, borderRadius, borderRadius);
+  }
+}
+
+/// Draws the rounded rect (or its border) by stretching a nine-patch rendered once, if it gives the same pixels.
+/// The corners are copied as is, and the 1-pixel wide edges and center are stretched.
+bool drawNinePatch(
+  QPainter* p, QRectF const& rect, NinePatchKind kind, QColor const& color, qreal const borderWidth, qreal radius) {
+  if (!ninePatchEnabled)
+    return false;
+
+  const auto* device = p->device();
+  const auto dpr = device ? device->devicePixelRatio() : 1.;
+  const auto& transform = p->transform();
+  if (!isWholeNumber(dpr) || transform.type() > QTransform::TxTranslate
+      || p->compositionMode() != QPainter::CompositionMode_SourceOver)
+    return false;
+
+  // The rect must be on whole pixels, and big enough to contain the corners.
+  const auto topLeft = transform.map(rect.topLeft());
+  if (!isWholeNumber(topLeft.x()) || !isWholeNumber(topLeft.y()) || !isWholeNumber(rect.width())
+      || !isWholeNumber(rect.height()))
+    return false;
+  const auto margin = static_cast<int>(std::ceil(std::max(radius, borderWidth))) + 1;
+  const auto patchExtent = margin * 2 + 1;
+  if (rect.width() < patchExtent || rect.height() < patchExtent)
+    return false;
+
+  const auto intDpr = static_cast<int>(std::round(dpr));
+  const auto key = NinePatchKey{ kind, static_cast<int>(std::round(radius * 64.)),
+    static_cast<int>(std::round(borderWidth * 64.)), intDpr, color.rgba() };
+  auto& keys = ninePatchKeys();
+  const auto it = keys.find(key);
+  QPixmap patch;
+  if (it == keys.end() || !QPixmapCache::find(it->second, &patch)) {
+    // In device pixels.
+    patch = QPixmap(patchExtent * intDpr, patchExtent * intDpr);
+    patch.fill(Qt::transparent);
+    {
+      QPainter patchPainter(&patch);
+      patchPainter.scale(intDpr, intDpr);
+      const auto patchRect = QRectF(0., 0., patchExtent, patchExtent);
+      if (kind == NinePatchKind::Fill) {
+        patchPainter.setRenderHint(QPainter::RenderHint::Antialiasing, true);
+        patchPainter.setPen(Qt::NoPen);
+        patchPainter.setBrush(color);
+        patchPainter.drawRoundedRect(patchRect, radius, radius);
+      } else {
+        drawRoundedRectBorderPath(&patchPainter, patchRect, color, borderWidth, radius);
+      }
+    }
+    if (keys.size() >= maxNinePatchCount) {
+      keys.clear();
+    }
+    keys[key] = QPixmapCache::insert(patch);
+  }
+
+  // Source in device pixels, target in logical pixels.
+  const auto marginPx = margin * intDpr;
+  const auto patchPx = patchExtent * intDpr;
+  const qreal sources[4] = { 0., static_cast<qreal>(marginPx), static_cast<qreal>(patchPx - marginPx),
+    static_cast<qreal>(patchPx) };
+  const qreal targetsX[4] = { rect.left(), rect.left() + margin, rect.right() - margin, rect.right() };
+  const qreal targetsY[4] = { rect.top(), rect.top() + margin, rect.bottom() - margin, rect.bottom() };
+
+  // The stretched parts are uniform, so there is no need for filtering.
+  const auto smoothBackup = p->testRenderHint(QPainter::SmoothPixmapTransform);
+  p->setRenderHint(QPainter::SmoothPixmapTransform, false);
+  for (auto row = 0; row < 3; ++row) {
+    for (auto column = 0; column < 3; ++column) {
+      const auto target = QRectF(QPointF(targetsX[column], targetsY[row]),
+        QPointF(targetsX[column + 1], targetsY[row + 1]));
+      const auto source =
+        QRectF(QPointF(sources[column], sources[row]), QPointF(sources[column + 1], sources[row + 1]));
+      p->drawPixmap(target, patch, source);
+    }
+  }
+  p->setRenderHint(QPainter::SmoothPixmapTransform, smoothBackup);
+  return true;
+}
+} // namespace
+
+NinePatchRoundedRectsScope::NinePatchRoundedRectsScope(bool enabled)
+  : _previous(ninePatchEnabled) {
+  // Nine-patches are QPixmaps, that can only be used in the GUI thread.
+  ninePatchEnabled = enabled && qApp && QThread::currentThread() == qApp->thread();
+}
+
+NinePatchRoundedRectsScope::~NinePatchRoundedRectsScope() {
+  ninePatchEnabled = _previous;
+}
+
 void drawRoundedRect(QPainter* p, QRectF const& rect, QBrush const& brush, qreal const radius) {
   if (radius < 0.1) {
     p->fillRect(rect, brush);
@@ -187,19 +426,20 @@ void drawRoundedRect(QPainter* p, QRectF const& rect, QBrush const& brush, qreal
     p->setRenderHint(QPainter::RenderHint::Antialiasing, true);
     p->setPen(Qt::NoPen);
     p->setBrush(brush);
-    p->drawRoundedRect(rect, radius, radius);
+    if (brush.style() != Qt::SolidPattern || !drawNinePatch(p, rect, NinePatchKind::Fill, brush.color(), 0., radius)) {
+      p->drawRoundedRect(rect, radius, radius);
+    }
   }
 }
 
 void drawRoundedRectF(QPainter* p, QRectF const& rect, QBrush const& brush, RadiusesF const& radiuses) {
-  if (radiuses.hasSameRadius()) {
+  if (radiuses.hasSameRadius() || radiuses < 0.1) {
     drawRoundedRect(p, rect, brush, radiuses.topLeft);
   } else {
-    const auto path = getMultipleRadiusesRectPath(rect, radiuses);
     p->setRenderHint(QPainter::Antialiasing, true);
     p->setPen(Qt::NoPen);
     p->setBrush(brush);
-    p->drawPath(path);
+    drawPathAt(p, cachedMultipleRadiusesRectPath(rect.size(), radiuses), rect.topLeft());
   }
 }
 
@@ -210,35 +450,34 @@ void drawRoundedRect(QPainter* p, QRect const& rect, QBrush const& brush, qreal
     p->setRenderHint(QPainter::RenderHint::Antialiasing, true);
     p->setPen(Qt::NoPen);
     p->setBrush(brush);
-    p->drawRoundedRect(rect, radius, radius);
+    if (brush.style() != Qt::SolidPattern
+        || !drawNinePatch(p, QRectF(rect), NinePatchKind::Fill, brush.color(), 0., radius)) {
+      p->drawRoundedRect(rect, radius, radius);
+    }
   }
 }
 
 void drawRoundedRect(QPainter* p, QRect const& rect, QBrush const& brush, RadiusesF const& radiuses) {
-  if (radiuses.hasSameRadius()) {
+  if (radiuses.hasSameRadius() || radiuses < 0.1) {
     drawRoundedRect(p, rect, brush, radiuses.topLeft);
   } else {
-    const auto path = getMultipleRadiusesRectPath(rect, radiuses);
     p->setRenderHint(QPainter::Antialiasing, true);
     p->setPen(Qt::NoPen);
     p->setBrush(brush);
-    p->drawPath(path);
+    drawPathAt(p, cachedMultipleRadiusesRectPath(QSizeF(rect.size()), radiuses), QPointF(rect.topLeft()));
   }
 }
 
 void drawRoundedRectBorder(
   QPainter* p, QRectF const& rect, QColor const& color, qreal const borderWidth, qreal const radius) {
   if (borderWidth > 0) {
-    p->setRenderHint(QPainter::RenderHint::Antialiasing);
-    p->setPen(QPen{ color, borderWidth, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin });
-    p->setBrush(Qt::NoBrush);
-    const auto halfBorderW = borderWidth / 2.;
-    const auto borderRect = rect.marginsRemoved({ halfBorderW, halfBorderW, halfBorderW, halfBorderW });
-    const auto borderRadius = radius - halfBorderW;
-    if (borderRadius < 0.1) {
-      p->drawRect(borderRect);
+    if (radius - borderWidth / 2. >= 0.1 && drawNinePatch(p, rect, NinePatchKind::Border, color, borderWidth, radius)) {
+      // Leave the painter in the same state as if the border was drawn with a pen.
+      p->setRenderHint(QPainter::RenderHint::Antialiasing);
+      p->setPen(QPen{ color, borderWidth, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin });
+      p->setBrush(Qt::NoBrush);
     } else {
-      p->drawRoundedRect(borderRect, borderRadius, borderRadius);
+      drawRoundedRectBorderPath(p, rect, color, borderWidth, radius);
     }
   }
 }
@@ -264,8 +503,7 @@ void drawRoundedRectBorder(
       if (borderRadiuses < 0.1) {
         p->drawRect(borderRect);
       } else {
-        const auto path = getMultipleRadiusesRectPath(borderRect, borderRadiuses);
-        p->drawPath(path);
+        drawPathAt(p, cachedMultipleRadiusesRectPath(borderRect.size(), borderRadiuses), borderRect.topLeft());
       }
     }
   }
@@ -291,13 +529,13 @@ void drawRectBorder(QPainter* p, QRectF const& rect, QColor const& color, qreal
   }
 }
 
-void drawRoundedTriangle(QPainter* p, QRectF const& rect, qreal const radius) {
+namespace {
+QPainterPath makeRoundedTrianglePath(QRectF const& rect, RadiusesF const& radiuses) {
   const auto w = rect.width();
   const auto h = rect.height();
   const auto x = rect.x();
   const auto y = rect.y();
-
-  p->setRenderHint(QPainter::Antialiasing, true);
+  const auto radius = radiuses.topLeft;
 
   const auto p1 = QPointF(x + w / 2., y);
   const auto p2 = QPointF(x + w, y + h);
@@ -332,10 +570,17 @@ void drawRoundedTriangle(QPainter* p, QRectF const& rect, qreal const radius) {
 
   const auto tr_x = (angle1.translation.x() + angle2.translation.x() + angle3.translation.x());
   const auto tr_y = (angle1.translation.y() + angle2.translation.y() + angle3.translation.y());
+  path.translate(tr_x, tr_y);
 
-  p->translate(tr_x, tr_y);
-  p->drawPath(path);
-  p->translate(-tr_x, -tr_y);
+  return path;
+}
+} // namespace
+
+void drawRoundedTriangle(QPainter* p, QRectF const& rect, qreal const radius) {
+  p->setRenderHint(QPainter::Antialiasing, true);
+  const auto& path =
+    pathCache().get(PathKind::RoundedTriangle, rect.size(), RadiusesF{ radius }, makeRoundedTrianglePath);
+  drawPathAt(p, path, rect.topLeft());
 }
 
 void drawCheckerboard(
@@ -365,11 +610,23 @@ void drawProgressBarValueRect(QPainter* p, QRect const& rect, QColor const& colo
   const auto x = inverted ? rect.x() + rect.width() - w : rect.x();
   const auto valueRect = QRect{ x, rect.y(), w, rect.height() };
 
-  QPainterPath clipPath;
-  clipPath.addRoundedRect(rect, radius, radius);
+  if (radius < 0.1) {
+    p->fillRect(valueRect.intersected(rect), color);
+    return;
+  }
+
+  const auto& clipPath = pathCache().get(
+    PathKind::RoundedRect, QSizeF(rect.size()), RadiusesF{ radius }, [](QRectF const& r, RadiusesF const& radiuses) {
+      QPainterPath path;
+      path.addRoundedRect(r, radiuses.topLeft, radiuses.topLeft);
+      return path;
+    });
   p->save();
   {
+    // The clip path is set in the current coordinates, so it remains in place when the transform is restored.
+    p->translate(rect.topLeft());
     p->setClipPath(clipPath);
+    p->translate(-rect.topLeft());
     p->fillRect(valueRect, color);
   }
   p->restore();
@@ -418,7 +675,8 @@ void drawDebugRect(const QRect& rect, QPainter* p) {
 }
 
 
-QPainterPath getMenuIndicatorPath(const QRect& rect) {
+namespace {
+QPainterPath makeMenuIndicatorPath(QRectF const& rect, RadiusesF const& /*radiuses*/) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -436,8 +694,23 @@ QPainterPath getMenuIndicatorPath(const QRect& rect) {
   return indicatorPath;
 }
 
+const QPainterPath& cachedMenuIndicatorPath(const QSize& size) {
+  return pathCache().get(PathKind::MenuIndicator, QSizeF(size), RadiusesF{}, makeMenuIndicatorPath);
+}
+} // namespace
 
-void drawComboBoxIndicator(const QRect& rect, QPainter* p) {
+QPainterPath getMenuIndicatorPath(const QRect& rect) {
+  return pathAt(cachedMenuIndicatorPath(rect.size()), QPointF(rect.topLeft()));
+}
+
+void drawMenuIndicator(const QRect& rect, QPainter* p) {
+  drawPathAt(p, cachedMenuIndicatorPath(rect.size()), QPointF(rect.topLeft()));
+}
+
+
+// Indicators are painted once in the GlyphAtlas, then blitted.
+namespace {
+void paintComboBoxIndicator(const QRect& rect, QPainter* p, qreal /*progress*/) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -463,7 +736,7 @@ void drawComboBoxIndicator(const QRect& rect, QPainter* p) {
   p->drawPath(indicatorPath2);
 }
 
-void drawCheckBoxIndicator(const QRect& rect, QPainter* p, qreal progress) {
+void paintCheckBoxIndicator(const QRect& rect, QPainter* p, qreal progress) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -496,7 +769,7 @@ void drawCheckBoxIndicator(const QRect& rect, QPainter* p, qreal progress) {
   p->drawPath(indicatorPath);
 }
 
-void drawPartiallyCheckedCheckBoxIndicator(const QRect& rect, QPainter* p, qreal progress) {
+void paintPartiallyCheckedCheckBoxIndicator(const QRect& rect, QPainter* p, qreal progress) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -522,7 +795,7 @@ void drawPartiallyCheckedCheckBoxIndicator(const QRect& rect, QPainter* p, qreal
   p->drawPath(indicatorPath);
 }
 
-void drawRadioButtonIndicator(const QRect& rect, QPainter* p, qreal progress) {
+void paintRadioButtonIndicator(const QRect& rect, QPainter* p, qreal progress) {
   constexpr auto intendedRatio = 8. / 16.;
 
   const auto indicatorW = rect.width() * intendedRatio * progress;
@@ -532,63 +805,65 @@ void drawRadioButtonIndicator(const QRect& rect, QPainter* p, qreal progress) {
   p->drawEllipse(ellipseRect);
 }
 
-void drawSpinBoxArrowIndicator(const QRect& rect, QPainter* p, QAbstractSpinBox::ButtonSymbols buttonSymbol,
-  QStyle::SubControl subControl, QSize const& iconSize) {
-  if (buttonSymbol == QAbstractSpinBox::NoButtons)
-    return;
+void paintSpinBoxPlus(const QRect& rect, QPainter* p, qreal /*progress*/) {
+  const auto x = rect.x();
+  const auto y = rect.y();
+  const auto w = rect.width();
+  const auto h = rect.height();
+  const auto p1 = QPointF(x + w / 2, y); //NOLINT (we do want integer division here)
+  const auto p2 = QPointF(x + w / 2, y + h); //NOLINT (we do want integer division here)
+  p->drawLine(p1, p2);
 
-  const auto iconSizeW = std::min(rect.width(), iconSize.width());
-  const auto iconSizeH = std::min(rect.height(), iconSize.height());
-  const auto iconRectX = rect.x() + (rect.width() - iconSizeW) / 2;
-  const auto iconRectY = rect.y() + (rect.height() - iconSizeH) / 2;
-  const auto iconRect = QRect(iconRectX, iconRectY, iconSizeW, iconSizeH);
+  const auto p3 = QPointF(x, y + h / 2); //NOLINT (we do want integer division here)
+  const auto p4 = QPointF(x + w, y + h / 2); //NOLINT (we do want integer division here)
+  p->drawLine(p3, p4);
+}
 
-  const auto x = iconRect.x();
-  const auto y = iconRect.y();
-  const auto w = iconRect.width();
-  const auto h = iconRect.height();
+void paintSpinBoxMinus(const QRect& rect, QPainter* p, qreal /*progress*/) {
+  const auto x = rect.x();
+  const auto y = rect.y();
+  const auto w = rect.width();
+  const auto h = rect.height();
+  const auto p1 = QPointF(x, y + h / 2); //NOLINT (we do want integer division here)
+  const auto p2 = QPointF(x + w, y + h / 2); //NOLINT (we do want integer division here)
+  p->drawLine(p1, p2);
+}
 
-  if (buttonSymbol == QAbstractSpinBox::PlusMinus) {
-    if (subControl == QStyle::SC_SpinBoxUp) {
-      const auto p1 = QPointF(x + w / 2, y); //NOLINT (we do want integer division here)
-      const auto p2 = QPointF(x + w / 2, y + h); //NOLINT (we do want integer division here)
-      p->drawLine(p1, p2);
+void paintSpinBoxArrowUp(const QRect& rect, QPainter* p, qreal /*progress*/) {
+  const auto x = rect.x();
+  const auto y = rect.y();
+  const auto w = rect.width();
+  const auto h = rect.height();
+  constexpr auto intendedSize = 8.;
+  const auto p1 = QPointF{ (1. / intendedSize) * w + x, (5. / intendedSize) * h + y };
+  const auto p2 = QPointF{ (4. / intendedSize) * w + x, (2. / intendedSize) * h + y };
+  const auto p3 = QPointF{ (7. / intendedSize) * w + x, (5. / intendedSize) * h + y };
 
-      const auto p3 = QPointF(x, y + h / 2); //NOLINT (we do want integer division here)
-      const auto p4 = QPointF(x + w, y + h / 2); //NOLINT (we do want integer division here)
-      p->drawLine(p3, p4);
-    } else if (subControl == QStyle::SC_SpinBoxDown) {
-      const auto p1 = QPointF(x, y + h / 2); //NOLINT (we do want integer division here)
-      const auto p2 = QPointF(x + w, y + h / 2); //NOLINT (we do want integer division here)
-      p->drawLine(p1, p2);
-    }
-  } else if (buttonSymbol == QAbstractSpinBox::UpDownArrows) {
-    constexpr auto intendedSize = 8.;
-    if (subControl == QStyle::SC_SpinBoxUp) {
-      const auto p1 = QPointF{ (1. / intendedSize) * w + x, (5. / intendedSize) * h + y };
-      const auto p2 = QPointF{ (4. / intendedSize) * w + x, (2. / intendedSize) * h + y };
-      const auto p3 = QPointF{ (7. / intendedSize) * w + x, (5. / intendedSize) * h + y };
+  QPainterPath path;
+  path.moveTo(p1);
+  path.lineTo(p2);
+  path.lineTo(p3);
+  p->drawPath(path);
+}
 
-      QPainterPath path;
-      path.moveTo(p1);
-      path.lineTo(p2);
-      path.lineTo(p3);
-      p->drawPath(path);
-    } else if (subControl == QStyle::SC_SpinBoxDown) {
-      const auto p1 = QPointF{ (1. / intendedSize) * w + x, (3. / intendedSize) * h + y };
-      const auto p2 = QPointF{ (4. / intendedSize) * w + x, (6. / intendedSize) * h + y };
-      const auto p3 = QPointF{ (7. / intendedSize) * w + x, (3. / intendedSize) * h + y };
+void paintSpinBoxArrowDown(const QRect& rect, QPainter* p, qreal /*progress*/) {
+  const auto x = rect.x();
+  const auto y = rect.y();
+  const auto w = rect.width();
+  const auto h = rect.height();
+  constexpr auto intendedSize = 8.;
+  const auto p1 = QPointF{ (1. / intendedSize) * w + x, (3. / intendedSize) * h + y };
+  const auto p2 = QPointF{ (4. / intendedSize) * w + x, (6. / intendedSize) * h + y };
+  const auto p3 = QPointF{ (7. / intendedSize) * w + x, (3. / intendedSize) * h + y };
 
-      QPainterPath path;
-      path.moveTo(p1);
-      path.lineTo(p2);
-      path.lineTo(p3);
-      p->drawPath(path);
-    }
-  }
+  QPainterPath path;
+  path.moveTo(p1);
+  path.lineTo(p2);
+  path.lineTo(p3);
+  p->drawPath(path);
 }
 
-void drawArrowRight(const QRect& rect, QPainter* p) {
+void paintArrowRight(const QRect& rect, QPainter* p, qreal /*progress*/) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -605,7 +880,7 @@ void drawArrowRight(const QRect& rect, QPainter* p) {
   p->drawPath(path);
 }
 
-void drawArrowLeft(const QRect& rect, QPainter* p) {
+void paintArrowLeft(const QRect& rect, QPainter* p, qreal /*progress*/) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -622,7 +897,7 @@ void drawArrowLeft(const QRect& rect, QPainter* p) {
   p->drawPath(path);
 }
 
-void drawArrowDown(const QRect& rect, QPainter* p) {
+void paintArrowDown(const QRect& rect, QPainter* p, qreal /*progress*/) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -639,7 +914,7 @@ void drawArrowDown(const QRect& rect, QPainter* p) {
   p->drawPath(path);
 }
 
-void drawArrowUp(const QRect& rect, QPainter* p) {
+void paintArrowUp(const QRect& rect, QPainter* p, qreal /*progress*/) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -656,7 +931,7 @@ void drawArrowUp(const QRect& rect, QPainter* p) {
   p->drawPath(path);
 }
 
-void drawSubMenuIndicator(const QRect& rect, QPainter* p) {
+void paintSubMenuIndicator(const QRect& rect, QPainter* p, qreal /*progress*/) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -673,7 +948,7 @@ void drawSubMenuIndicator(const QRect& rect, QPainter* p) {
   p->drawPath(path);
 }
 
-void drawDoubleArrowRightIndicator(const QRect& rect, QPainter* p) {
+void paintDoubleArrowRightIndicator(const QRect& rect, QPainter* p, qreal /*progress*/) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -703,7 +978,7 @@ void drawDoubleArrowRightIndicator(const QRect& rect, QPainter* p) {
   }
 }
 
-void drawToolBarExtensionIndicator(const QRect& rect, QPainter* p) {
+void paintToolBarExtensionIndicator(const QRect& rect, QPainter* p, qreal /*progress*/) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -733,7 +1008,7 @@ void drawToolBarExtensionIndicator(const QRect& rect, QPainter* p) {
   }
 }
 
-void drawCloseIndicator(const QRect& rect, QPainter* p) {
+void paintCloseIndicator(const QRect& rect, QPainter* p, qreal /*progress*/) {
   const auto w = rect.width();
   const auto h = rect.width();
   const auto x = rect.x();
@@ -751,6 +1026,83 @@ void drawCloseIndicator(const QRect& rect, QPainter* p) {
     p->drawLine(p3, p4);
   }
 }
+} // namespace
+
+void drawComboBoxIndicator(const QRect& rect, QPainter* p) {
+  GlyphAtlas::instance().draw(Glyph::ComboBoxIndicator, rect, p, 1., paintComboBoxIndicator);
+}
+
+void drawCheckBoxIndicator(const QRect& rect, QPainter* p, qreal progress) {
+  GlyphAtlas::instance().draw(Glyph::CheckBoxIndicator, rect, p, progress, paintCheckBoxIndicator);
+}
+
+void drawPartiallyCheckedCheckBoxIndicator(const QRect& rect, QPainter* p, qreal progress) {
+  GlyphAtlas::instance().draw(
+    Glyph::PartiallyCheckedCheckBoxIndicator, rect, p, progress, paintPartiallyCheckedCheckBoxIndicator);
+}
+
+void drawRadioButtonIndicator(const QRect& rect, QPainter* p, qreal progress) {
+  GlyphAtlas::instance().draw(Glyph::RadioButtonIndicator, rect, p, progress, paintRadioButtonIndicator);
+}
+
+void drawSpinBoxArrowIndicator(const QRect& rect, QPainter* p, QAbstractSpinBox::ButtonSymbols buttonSymbol,
+  QStyle::SubControl subControl, QSize const& iconSize) {
+  if (buttonSymbol == QAbstractSpinBox::NoButtons)
+    return;
+
+  const auto iconSizeW = std::min(rect.width(), iconSize.width());
+  const auto iconSizeH = std::min(rect.height(), iconSize.height());
+  const auto iconRectX = rect.x() + (rect.width() - iconSizeW) / 2;
+  const auto iconRectY = rect.y() + (rect.height() - iconSizeH) / 2;
+  const auto iconRect = QRect(iconRectX, iconRectY, iconSizeW, iconSizeH);
+
+  auto& atlas = GlyphAtlas::instance();
+  if (buttonSymbol == QAbstractSpinBox::PlusMinus) {
+    if (subControl == QStyle::SC_SpinBoxUp) {
+      atlas.draw(Glyph::SpinBoxPlus, iconRect, p, 1., paintSpinBoxPlus);
+    } else if (subControl == QStyle::SC_SpinBoxDown) {
+      atlas.draw(Glyph::SpinBoxMinus, iconRect, p, 1., paintSpinBoxMinus);
+    }
+  } else if (buttonSymbol == QAbstractSpinBox::UpDownArrows) {
+    if (subControl == QStyle::SC_SpinBoxUp) {
+      atlas.draw(Glyph::SpinBoxArrowUp, iconRect, p, 1., paintSpinBoxArrowUp);
+    } else if (subControl == QStyle::SC_SpinBoxDown) {
+      atlas.draw(Glyph::SpinBoxArrowDown, iconRect, p, 1., paintSpinBoxArrowDown);
+    }
+  }
+}
+
+void drawArrowRight(const QRect& rect, QPainter* p) {
+  GlyphAtlas::instance().draw(Glyph::ArrowRight, rect, p, 1., paintArrowRight);
+}
+
+void drawArrowLeft(const QRect& rect, QPainter* p) {
+  GlyphAtlas::instance().draw(Glyph::ArrowLeft, rect, p, 1., paintArrowLeft);
+}
+
+void drawArrowDown(const QRect& rect, QPainter* p) {
+  GlyphAtlas::instance().draw(Glyph::ArrowDown, rect, p, 1., paintArrowDown);
+}
+
+void drawArrowUp(const QRect& rect, QPainter* p) {
+  GlyphAtlas::instance().draw(Glyph::ArrowUp, rect, p, 1., paintArrowUp);
+}
+
+void drawSubMenuIndicator(const QRect& rect, QPainter* p) {
+  GlyphAtlas::instance().draw(Glyph::SubMenuIndicator, rect, p, 1., paintSubMenuIndicator);
+}
+
+void drawDoubleArrowRightIndicator(const QRect& rect, QPainter* p) {
+  GlyphAtlas::instance().draw(Glyph::DoubleArrowRightIndicator, rect, p, 1., paintDoubleArrowRightIndicator);
+}
+
+void drawToolBarExtensionIndicator(const QRect& rect, QPainter* p) {
+  GlyphAtlas::instance().draw(Glyph::ToolBarExtensionIndicator, rect, p, 1., paintToolBarExtensionIndicator);
+}
+
+void drawCloseIndicator(const QRect& rect, QPainter* p) {
+  GlyphAtlas::instance().draw(Glyph::CloseIndicator, rect, p, 1., paintCloseIndicator);
+}
 
 void drawTreeViewIndicator(const QRect& rect, QPainter* p, bool open) {
   if (open) {
@@ -1109,7 +1461,8 @@ void drawDial(QPainter* p, QRect const& dialRect, int min, int max, double value
   p->drawLine(p1, p2);
 }
 
-QPainterPath getTabPath(QRect const& rect, const RadiusesF& radiuses) {
+namespace {
+QPainterPath makeTabPath(QRectF const& rect, const RadiusesF& radiuses) {
   QPainterPath path;
   const auto w = static_cast<qreal>(rect.width());
   const auto h = static_cast<qreal>(rect.height());
@@ -1157,22 +1510,35 @@ QPainterPath getTabPath(QRect const& rect, const RadiusesF& radiuses) {
   return path;
 }
 
+const QPainterPath& cachedTabPath(QSize const& size, const RadiusesF& radiuses) {
+  return pathCache().get(PathKind::Tab, QSizeF(size), radiuses, makeTabPath);
+}
+} // namespace
+
+QPainterPath getTabPath(QRect const& rect, const RadiusesF& radiuses) {
+  return pathAt(cachedTabPath(rect.size(), radiuses), QPointF(rect.topLeft()));
+}
+
 void drawTab(QPainter* p, QRect const& rect, const RadiusesF& radius, const QColor& bgColor, bool drawShadow,
   const QColor& shadowColor) {
   if (drawShadow) {
     drawTabShadow(p, rect, radius, shadowColor);
   }
-  const auto path = getTabPath(rect, radius);
+  if (radius < 0.1) {
+    p->fillRect(rect, bgColor);
+    return;
+  }
   p->setRenderHint(QPainter::Antialiasing, true);
   p->setPen(Qt::NoPen);
   p->setBrush(bgColor);
-  p->drawPath(path);
+  drawPathAt(p, cachedTabPath(rect.size(), radius), QPointF(rect.topLeft()));
 }
 
 void drawTabShadow(QPainter* p, QRect const& rect, const RadiusesF& radius, const QColor& color) {
   // Draw the tab in a temporary buffer.
-  const auto path = getTabPath(rect, radius);
-  const auto pathRect = path.boundingRect().toAlignedRect();
+  const auto& path = cachedTabPath(rect.size(), radius);
+  const auto pathOriginRect = path.boundingRect().toAlignedRect();
+  const auto pathRect = pathOriginRect.translated(rect.topLeft());
   QPixmap pathPixmap(pathRect.size());
   {
     pathPixmap.fill(Qt::transparent);
@@ -1180,7 +1546,7 @@ void drawTabShadow(QPainter* p, QRect const& rect, const RadiusesF& radius, cons
     pixmapPainter.setRenderHint(QPainter::Antialiasing, true);
     pixmapPainter.setPen(Qt::NoPen);
     pixmapPainter.setBrush(Qt::black);
-    pixmapPainter.drawPath(path.translated(-pathRect.x(), -pathRect.y()));
+    drawPathAt(&pixmapPainter, path, -QPointF(pathOriginRect.topLeft()));
   }
 
   // Get the blurred version of the temporary buffer.
@@ -1260,6 +1626,15 @@ QString removeTrailingWhitespaces(const QString& str) {
   return {};
 }
 
+namespace {
+// Shortcuts are drawn with the theme's regular font, so its metrics are computed once per screen DPI.
+// Only used from the GUI thread.
+const QFontMetrics& shortcutFontMetrics(const Theme& theme, const QPaintDevice* device) {
+  static FontMetricsCache cache;
+  return cache.get(theme, FontMetricsCache::Font::Regular, device);
+}
+} // namespace
+
 QString displayedShortcutString(const QKeySequence& shortcut) {
   auto shortcutStr = shortcut.toString(QKeySequence::SequenceFormat::NativeText);
   shortcutStr.replace(QApplication::translate("QShortcut", "Left"), QChar(0x2190));
@@ -1278,8 +1653,7 @@ void drawShortcut(QPainter& p, const QKeySequence& shortcut, const QRect& rect,
   p.setRenderHint(QPainter::Antialiasing, true);
   constexpr auto radius = 3.;
   constexpr auto borderW = 1;
-  const auto& font = theme.fontRegular;
-  const auto fm = QFontMetrics(font);
+  const auto& fm = shortcutFontMetrics(theme, p.device());
   const auto parts = shortcutStr.split('+', Qt::SkipEmptyParts, Qt::CaseInsensitive);
   const auto spacing = theme.spacing / 2;
   const auto paddingV = theme.spacing / 4;
@@ -1324,15 +1698,14 @@ void drawShortcut(QPainter& p, const QKeySequence& shortcut, const QRect& rect,
   }
 }
 
-QSize shortcutSizeHint(const QKeySequence& shortcut, const Theme& theme) {
+QSize shortcutSizeHint(const QKeySequence& shortcut, const Theme& theme, const QPaintDevice* device) {
   const auto shortcutStr = displayedShortcutString(shortcut);
   if (shortcutStr.isEmpty())
     return { 0, 0 };
 
   constexpr auto radius = 3.;
   constexpr auto borderW = 1;
-  const auto& font = theme.fontRegular;
-  const auto fm = QFontMetrics(font);
+  const auto& fm = shortcutFontMetrics(theme, device);
   const auto parts = shortcutStr.split('+', Qt::SkipEmptyParts, Qt::CaseInsensitive);
 
   const auto spacing = theme.spacing / 2;
@@ -1358,19 +1731,38 @@ QSize shortcutSizeHint(const QKeySequence& shortcut, const Theme& theme) {
   return QSize{ w, h };
 }
 
+namespace {
+/// The QlementineStyle used by the widget, even if it is wrapped in QProxyStyles.
+const QlementineStyle* findQlementineStyle(const QWidget* widget) {
+  const auto* style = widget ? widget->style() : QApplication::style();
+  while (style) {
+    if (const auto* qlementineStyle = qobject_cast<const QlementineStyle*>(style))
+      return qlementineStyle;
+
+    const auto* proxyStyle = qobject_cast<const QProxyStyle*>(style);
+    style = proxyStyle ? proxyStyle->baseStyle() : nullptr;
+  }
+  return nullptr;
+}
+} // namespace
+
 QPixmap getPixmap(
   QIcon const& icon, const QSize& iconSize, MouseState const mouse, CheckState const checked, const QWidget* widget) {
   const auto iconMode = getIconMode(mouse);
   const auto iconState = getIconState(checked);
   const auto devicePixelRatio = widget ? widget->devicePixelRatio() : qApp->devicePixelRatio();
+  // The disabled pixmap is generated by the style, so it depends on the theme.
+  const auto* style = findQlementineStyle(widget);
+  const auto themeGeneration = style ? style->themeGeneration() : 0;
   // Qt icon pixmap cache is broken when devicePixelRatio > 1.0.
-  auto cacheKey = QString("qlementine_icon_pixmap_%1_%2_%3_%4_%5_%6")
+  auto cacheKey = QString("qlementine_icon_pixmap_%1_%2_%3_%4_%5_%6_%7")
                     .arg(icon.cacheKey())
                     .arg(iconSize.width())
                     .arg(iconSize.height())
                     .arg(devicePixelRatio)
                     .arg(static_cast<int>(iconMode))
-                    .arg(static_cast<int>(iconState));
+                    .arg(static_cast<int>(iconState))
+                    .arg(themeGeneration);
   QPixmap pixmap;
   if (QPixmapCache::find(cacheKey, &pixmap)) {
     return pixmap;
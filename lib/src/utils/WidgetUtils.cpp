@@ -8,6 +8,7 @@
 #include <QFrame>
 #include <QBoxLayout>
 #include <QLayout>
+#include <QWindow>
 
 namespace oclero::qlementine {
 QWidget* makeHorizontalLine(QWidget* parentWidget, int maxWidth) {
@@ -91,4 +92,21 @@ void clearFocus(QWidget* widget, bool recursive) {
     }
   }
 }
+
+bool isWidgetVisibleOnScreen(const QWidget* widget) {
+  if (!widget || !widget->isVisible())
+    return false;
+
+  const auto* window = widget->window();
+  if (window->isMinimized())
+    return false;
+
+  if (const auto* windowHandle = window->windowHandle()) {
+    if (!windowHandle->isExposed())
+      return false;
+  }
+
+  // The widget may be scrolled out of its viewport, or be covered by its parents' bounds.
+  return !widget->visibleRegion().isEmpty();
+}
 } // namespace oclero::qlementine
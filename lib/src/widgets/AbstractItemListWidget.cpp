@@ -7,16 +7,22 @@
 #include <oclero/qlementine/widgets/RoundedFocusFrame.hpp>
 #include <oclero/qlementine/utils/ImageUtils.hpp>
 #include <oclero/qlementine/utils/FontUtils.hpp>
+#include <oclero/qlementine/utils/ColorUtils.hpp>
 
 #include <QPainter>
 #include <QKeyEvent>
 #include <QMouseEvent>
+#include <QPaintEvent>
 
 #include <cmath>
+#include <algorithm>
 
 namespace oclero::qlementine {
 constexpr auto animationFactor = 1;
 
+// Arbitrary loop duration for the items animation tick: the tick runs until no item is transitioning anymore.
+constexpr auto itemsAnimationLoopDuration = 1000;
+
 AbstractItemListWidget::AbstractItemListWidget(QWidget* parent)
   : QWidget(parent) {
   setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Fixed);
@@ -35,6 +41,17 @@ AbstractItemListWidget::AbstractItemListWidget(QWidget* parent)
   // Badge.
   _badgeFont = qlementineStyle ? qlementineStyle->fontForTextRole(qlementine::TextRole::Caption) : this->font();
   _badgeFont.setBold(true);
+
+  // Items animations: a single tick for all the items.
+  _itemsAnimation.setStartValue(0.);
+  _itemsAnimation.setEndValue(1.);
+  _itemsAnimation.setDuration(itemsAnimationLoopDuration);
+  _itemsAnimation.setLoopCount(-1);
+  QObject::connect(&_itemsAnimation, &QVariantAnimation::valueChanged, this, [this]() {
+    stepItemsAnimations();
+  });
+
+  connectToThemeChanges();
 }
 
 AbstractItemListWidget ::~AbstractItemListWidget() = default;
@@ -50,11 +67,13 @@ int AbstractItemListWidget::currentIndex() const {
 void AbstractItemListWidget::setCurrentIndex(int index) {
   index = index < 0 || index > itemCount() - 1 ? -1 : index;
   if (index != _currentIndex) {
+    const auto previousIndex = _currentIndex;
     _currentIndex = index;
     _focusedIndex = index;
     update();
     updateCurrentIndexAnimation();
-    updateItemsAnimations();
+    updateItemAnimation(previousIndex);
+    updateItemAnimation(index);
     Q_EMIT currentIndexChanged();
   }
 }
@@ -78,91 +97,38 @@ void AbstractItemListWidget::setCurrentData(const QVariant& currentData) {
 
 int AbstractItemListWidget::addItem(
   const QString& text, const QIcon& icon, const QString& badge, const QVariant& itemData) {
-  const auto* style = this->style();
-  const auto animDuration = style->styleHint(QStyle::SH_Widget_Animation_Duration) * animationFactor;
-
-  auto* bgColorAnimation = new QVariantAnimation(this);
-  QObject::connect(bgColorAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-    update();
-  });
-
-  auto* fgColorAnimation = new QVariantAnimation(this);
-  QObject::connect(fgColorAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-    update();
-  });
-
-  auto* badgeBgColorAnimation = new QVariantAnimation(this);
-  QObject::connect(badgeBgColorAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-    update();
-  });
-
-  auto* badgeFgColorAnimation = new QVariantAnimation(this);
-  QObject::connect(badgeFgColorAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-    update();
-  });
-
-  const Item newItem{
-    true,
-    text,
-    icon,
-    badge,
-    QVariant(itemData),
-    QRect{},
-    QSize{ 0, 0 },
-    bgColorAnimation,
-    fgColorAnimation,
-    badgeBgColorAnimation,
-    badgeFgColorAnimation,
-  };
+  Item newItem;
+  newItem.text = text;
+  newItem.icon = icon;
+  newItem.badge = badge;
+  newItem.data = itemData;
   _items.emplace_back(newItem);
 
   if (_currentIndex == -1) {
     _currentIndex = 0;
   }
 
-  update();
-  updateGeometry();
-  updateItemsAnimations();
+  // The new item directly gets its colors, without transition.
+  const auto index = itemCount() - 1;
+  auto& item = _items.back();
+  const auto [bgColor, fgColor, badgeBgColor, badgeFgColor] = getItemBgAndFgColor(index, getItemMouseState(index, item));
+  item.colors = ItemColors{ bgColor, fgColor, badgeBgColor, badgeFgColor };
+  item.startColors = item.colors;
+  item.endColors = item.colors;
+
+  invalidateItemsLayout();
   updateCurrentIndexAnimation();
   Q_EMIT itemCountChanged();
   Q_EMIT currentIndexChanged();
 
-  const auto [bgColor, fgColor, badgeBgColor, badgeFgColor] = getItemBgAndFgColor(itemCount(), MouseState::Normal);
-  bgColorAnimation->setDuration(animDuration);
-  bgColorAnimation->setStartValue(QVariant::fromValue<QColor>(bgColor));
-  bgColorAnimation->setEndValue(QVariant::fromValue<QColor>(bgColor));
-  bgColorAnimation->setEasingCurve(QEasingCurve::Type::InOutCubic);
-
-  fgColorAnimation->setStartValue(QVariant::fromValue<QColor>(fgColor));
-  fgColorAnimation->setEndValue(QVariant::fromValue<QColor>(fgColor));
-  fgColorAnimation->setDuration(animDuration);
-  fgColorAnimation->setEasingCurve(QEasingCurve::Type::InOutCubic);
-
-  badgeBgColorAnimation->setStartValue(QVariant::fromValue<QColor>(badgeBgColor));
-  badgeBgColorAnimation->setEndValue(QVariant::fromValue<QColor>(badgeBgColor));
-  badgeBgColorAnimation->setDuration(animDuration);
-  badgeBgColorAnimation->setEasingCurve(QEasingCurve::Type::InOutCubic);
-
-  badgeFgColorAnimation->setStartValue(QVariant::fromValue<QColor>(badgeFgColor));
-  badgeFgColorAnimation->setEndValue(QVariant::fromValue<QColor>(badgeFgColor));
-  badgeFgColorAnimation->setDuration(animDuration);
-  badgeFgColorAnimation->setEasingCurve(QEasingCurve::Type::InOutCubic);
-
-  return itemCount() - 1;
+  return index;
 }
 
 void AbstractItemListWidget::removeItem(int index) {
   if (index >= 0 && index < itemCount()) {
-    auto& item = _items[index];
-    delete item.bgColorAnimation;
-    delete item.fgColorAnimation;
-    delete item.badgeBgAnimation;
-    delete item.badgeFgAnimation;
-
     _items.erase(_items.begin() + index);
 
-    updateGeometry();
-    update();
+    invalidateItemsLayout();
 
     if (_currentIndex == index) {
       setCurrentIndex(std::max(-1, index - 1));
@@ -198,8 +164,7 @@ QVariant AbstractItemListWidget::getItemData(int index) const {
 void AbstractItemListWidget::setItemText(int index, const QString& text) {
   if (index >= 0 && index < itemCount()) {
     _items[index].text = text;
-    updateGeometry();
-    update();
+    invalidateItemsLayout();
   }
 }
 
@@ -213,8 +178,7 @@ QString AbstractItemListWidget::getItemText(int index) const {
 void AbstractItemListWidget::setItemIcon(int index, const QIcon& icon) {
   if (index >= 0 && index < itemCount()) {
     _items[index].icon = icon;
-    updateGeometry();
-    update();
+    invalidateItemsLayout();
   }
 }
 
@@ -227,9 +191,14 @@ QIcon AbstractItemListWidget::getItemIcon(int index) const {
 
 void AbstractItemListWidget::setItemBadge(int index, const QString& badge) {
   if (index >= 0 && index < itemCount()) {
-    _items[index].badge = badge;
-    updateGeometry();
-    update();
+    auto& item = _items[index];
+    item.badge = badge;
+    if (_itemsSizeHintsValid && computeItemSizeHint(item) == item.sizeHint) {
+      // The layout doesn't change: only the item needs to be repainted.
+      update(item.rect);
+    } else {
+      invalidateItemsLayout();
+    }
   }
 }
 
@@ -243,8 +212,8 @@ QString AbstractItemListWidget::getItemBadge(int index) const {
 void AbstractItemListWidget::setItemEnabled(int index, bool enabled) {
   if (index >= 0 && index < itemCount()) {
     _items[index].enabled = enabled;
-    updateItemsAnimations();
-    update();
+    updateItemAnimation(index);
+    update(_items[index].rect);
   }
 }
 
@@ -270,8 +239,7 @@ const QSize& AbstractItemListWidget::iconSize() const {
 void AbstractItemListWidget::setIconSize(const QSize& size) {
   if (size != _iconSize) {
     _iconSize = size;
-    updateGeometry();
-    update();
+    invalidateItemsLayout();
     Q_EMIT iconSizeChanged();
   }
 }
@@ -293,18 +261,24 @@ void AbstractItemListWidget::setItemsShouldExpand(bool expand) {
 }
 
 int AbstractItemListWidget::itemAtPos(const QPoint& pos) const {
-  const auto padding = style()->pixelMetric(QStyle::PM_LayoutHorizontalSpacing) / 2;
-  const auto itemSpacing = style()->pixelMetric(QStyle::PM_LayoutHorizontalSpacing) / 2;
-  const auto itemCount = this->itemCount();
-  for (auto itemIndex = 0; itemIndex < itemCount; ++itemIndex) {
-    const auto& itemRect = _items[itemIndex].rect;
-    const auto leftPadding = itemIndex == 0 ? padding : itemSpacing / 2;
-    const auto rightPadding = itemIndex == 0 ? padding : itemSpacing / 2;
-    if (hitTestItemRect(pos, itemRect, leftPadding, rightPadding)) {
-      return itemIndex;
-    }
-  }
-  return -1;
+  // Padding values are cached by updateItemRects(), so no style query is made on mouse move.
+  const auto padding = _hitTestPadding;
+  const auto itemSpacing = _hitTestPadding;
+  const auto paddingAt = [&](int itemIndex) {
+    return itemIndex == 0 ? padding : itemSpacing / 2;
+  };
+
+  // Items are laid out from left to right, so their hit-test extents are sorted:
+  // find the first item whose right extent reaches the position.
+  const auto it = std::lower_bound(_items.cbegin(), _items.cend(), pos.x(), [&](const Item& item, int x) {
+    const auto itemIndex = static_cast<int>(&item - _items.data());
+    return item.rect.x() + item.rect.width() + paddingAt(itemIndex) < x;
+  });
+  if (it == _items.cend())
+    return -1;
+
+  const auto itemIndex = static_cast<int>(std::distance(_items.cbegin(), it));
+  return hitTestItemRect(pos, it->rect, paddingAt(itemIndex), paddingAt(itemIndex)) ? itemIndex : -1;
 }
 
 bool AbstractItemListWidget::hitTestItemRect(
@@ -345,14 +319,13 @@ void AbstractItemListWidget::keyReleaseEvent(QKeyEvent* e) {
 
 void AbstractItemListWidget::enterEvent(QEnterEvent* e) {
   QWidget::enterEvent(e);
-  update();
+  // The hovered item will be updated by mouseMoveEvent().
 }
 
 void AbstractItemListWidget::leaveEvent(QEvent* e) {
   QWidget::leaveEvent(e);
-  setHoveredIndex(-1, false);
-  setPressedIndex(-1, false);
-  updateItemsAnimations();
+  setHoveredIndex(-1);
+  setPressedIndex(-1);
 }
 
 void AbstractItemListWidget::mousePressEvent(QMouseEvent* e) {
@@ -369,11 +342,10 @@ void AbstractItemListWidget::mouseReleaseEvent(QMouseEvent* e) {
     const auto index = itemAtPos(e->pos());
     const auto pressedBackup = _pressedIndex;
     // Update item states.
-    setPressedIndex(-1, false);
+    setPressedIndex(-1);
     if (index == -1) {
-      setHoveredIndex(index, false);
+      setHoveredIndex(index);
     }
-    updateItemsAnimations();
 
     // Current index.
     if (index == pressedBackup && index != -1) {
@@ -392,8 +364,14 @@ void AbstractItemListWidget::mouseMoveEvent(QMouseEvent* e) {
 }
 
 QSize AbstractItemListWidget::sizeHint() const {
+  // The size hint is cached until the items layout is invalidated.
+  if (_sizeHintCache.isValid())
+    return _sizeHintCache;
+
   // Make a first pass to ask every item how much space they need if space was unlimited.
-  const_cast<AbstractItemListWidget*>(this)->updateItemsSizeHints();
+  if (!_itemsSizeHintsValid) {
+    const_cast<AbstractItemListWidget*>(this)->updateItemsSizeHints();
+  }
 
   // Get constant values from style.
   const auto padding = getPadding();
@@ -411,11 +389,11 @@ QSize AbstractItemListWidget::sizeHint() const {
   neededW += spacings + padding.left() + padding.right();
   neededH += padding.top() + padding.bottom();
 
-  return { neededW, neededH };
+  _sizeHintCache = QSize{ neededW, neededH };
+  return _sizeHintCache;
 }
 
-void AbstractItemListWidget::updateItemsSizeHints() {
-  // Get values identical for every item.
+QSize AbstractItemListWidget::computeItemSizeHint(const Item& item) const {
   const auto itemPadding = getItemPadding();
   const auto itemSpacing = getItemSpacing();
   const auto fm = QFontMetrics(labelFont(), this);
@@ -427,42 +405,50 @@ void AbstractItemListWidget::updateItemsSizeHints() {
   const auto badgeH = badgeFm.height() + badgePadding.top() + badgePadding.bottom();
   const auto itemH = std::max({ textH, iconH, badgeH }) + itemPadding.top() + itemPadding.bottom();
 
-  // Compute necessary size for every item.
-  for (auto& item : _items) {
-    auto itemW = itemPadding.left() + itemPadding.right();
-    auto elementCount = 0;
+  auto itemW = itemPadding.left() + itemPadding.right();
+  auto elementCount = 0;
 
-    if (!item.icon.isNull()) {
-      itemW += iconW;
-      ++elementCount;
-    }
+  if (!item.icon.isNull()) {
+    itemW += iconW;
+    ++elementCount;
+  }
 
-    if (!item.text.isEmpty()) {
-      itemW += qlementine::textWidth(fm, item.text);
-      ++elementCount;
-    }
+  if (!item.text.isEmpty()) {
+    itemW += qlementine::textWidth(fm, item.text);
+    ++elementCount;
+  }
 
-    if (!item.badge.isEmpty()) {
-      const auto badgeW =
-        std::max(badgeH, badgePadding.left() + badgePadding.right() + qlementine::textWidth(badgeFm, item.badge));
-      itemW += badgeW;
-      ++elementCount;
-    }
+  if (!item.badge.isEmpty()) {
+    const auto badgeW =
+      std::max(badgeH, badgePadding.left() + badgePadding.right() + qlementine::textWidth(badgeFm, item.badge));
+    itemW += badgeW;
+    ++elementCount;
+  }
+
+  // Spacings.
+  itemW += elementCount > 1 ? (elementCount - 1) * itemSpacing : 0;
 
-    // Spacings.
-    itemW += elementCount > 1 ? (elementCount - 1) * itemSpacing : 0;
+  return QSize{ itemW, itemH };
+}
 
-    item.sizeHint = QSize{ itemW, itemH };
+void AbstractItemListWidget::updateItemsSizeHints() {
+  // Compute necessary size for every item.
+  for (auto& item : _items) {
+    item.sizeHint = computeItemSizeHint(item);
   }
+  _itemsSizeHintsValid = true;
 }
 
 void AbstractItemListWidget::updateItemRects() {
   // Make a first pass to ask every item how much space they need if space was unlimited.
-  updateItemsSizeHints();
+  if (!_itemsSizeHintsValid) {
+    updateItemsSizeHints();
+  }
 
   // Get constant values.
   const auto padding = getPadding();
   const auto spacing = getSpacing();
+  _hitTestPadding = style()->pixelMetric(QStyle::PM_LayoutHorizontalSpacing) / 2;
 
   // Check if items can take the space they want.
   const auto totalRect = rect();
@@ -520,6 +506,15 @@ void AbstractItemListWidget::updateItemRects() {
   }
 }
 
+void AbstractItemListWidget::invalidateItemsLayout() {
+  // Items will be measured again, and the widget layout will be computed again.
+  _itemsSizeHintsValid = false;
+  _sizeHintCache = QSize{};
+  updateItemRects();
+  updateGeometry();
+  update();
+}
+
 MouseState AbstractItemListWidget::getItemMouseState(int index, const Item& item) const {
   if (!isEnabled() || !item.enabled)
     return MouseState::Disabled;
@@ -598,29 +593,70 @@ void AbstractItemListWidget::updateCurrentIndexAnimation(bool immediate) {
 
 void AbstractItemListWidget::updateItemsAnimations() {
   for (auto i = 0; i < itemCount(); ++i) {
-    auto& item = _items[i];
+    updateItemAnimation(i);
+  }
+}
+
+void AbstractItemListWidget::updateItemAnimation(int index) {
+  if (index < 0 || index >= itemCount())
+    return;
+
+  auto& item = _items[index];
+  const auto itemMouse = getItemMouseState(index, item);
+  const auto [itemBgColor, itemFgColor, badgeBgColor, badgeFgColor] = getItemBgAndFgColor(index, itemMouse);
+  const auto targetColors = ItemColors{ itemBgColor, itemFgColor, badgeBgColor, badgeFgColor };
+  if (targetColors == item.endColors)
+    return;
 
-    const auto itemMouse = getItemMouseState(i, item);
-    const auto [itemBgColor, itemFgColor, badgeBgColor, badgeFgColor] = getItemBgAndFgColor(i, itemMouse);
-    item.bgColorAnimation->stop();
-    item.fgColorAnimation->stop();
-    item.badgeBgAnimation->stop();
-    item.badgeFgAnimation->stop();
+  item.startColors = item.colors;
+  item.endColors = targetColors;
 
-    item.bgColorAnimation->setStartValue(item.bgColorAnimation->currentValue().value<QColor>());
-    item.fgColorAnimation->setStartValue(item.fgColorAnimation->currentValue().value<QColor>());
-    item.badgeBgAnimation->setStartValue(item.badgeBgAnimation->currentValue().value<QColor>());
-    item.badgeFgAnimation->setStartValue(item.badgeFgAnimation->currentValue().value<QColor>());
+  const auto animDuration = style()->styleHint(QStyle::SH_Widget_Animation_Duration) * animationFactor;
+  if (animDuration <= 0 || !isVisible()) {
+    // No need to animate.
+    item.colors = targetColors;
+    item.animationStartTime = -1;
+  } else {
+    if (_itemsAnimation.state() != QAbstractAnimation::Running) {
+      _itemsAnimation.start();
+    }
+    _itemsAnimationDuration = animDuration;
+    item.animationStartTime = _itemsAnimation.currentTime();
+  }
+  update(item.rect);
+}
 
-    item.bgColorAnimation->setEndValue(QVariant::fromValue<QColor>(itemBgColor));
-    item.fgColorAnimation->setEndValue(QVariant::fromValue<QColor>(itemFgColor));
-    item.badgeBgAnimation->setEndValue(QVariant::fromValue<QColor>(badgeBgColor));
-    item.badgeFgAnimation->setEndValue(QVariant::fromValue<QColor>(badgeFgColor));
+void AbstractItemListWidget::stepItemsAnimations() {
+  static const auto easingCurve = QEasingCurve(QEasingCurve::Type::InOutCubic);
+
+  // Total time elapsed since the tick started, loops included.
+  const auto currentTime = _itemsAnimation.currentTime();
+  auto transitioningItemCount = 0;
+
+  // Only transitioning items are stepped and repainted.
+  for (auto& item : _items) {
+    if (item.animationStartTime < 0)
+      continue;
+
+    const auto elapsed = currentTime - item.animationStartTime;
+    const auto progress =
+      _itemsAnimationDuration > 0 ? std::clamp(elapsed / static_cast<qreal>(_itemsAnimationDuration), 0., 1.) : 1.;
+    if (progress < 1.) {
+      const auto easedProgress = easingCurve.valueForProgress(progress);
+      item.colors.bg = interpolateColor(item.startColors.bg, item.endColors.bg, easedProgress);
+      item.colors.fg = interpolateColor(item.startColors.fg, item.endColors.fg, easedProgress);
+      item.colors.badgeBg = interpolateColor(item.startColors.badgeBg, item.endColors.badgeBg, easedProgress);
+      item.colors.badgeFg = interpolateColor(item.startColors.badgeFg, item.endColors.badgeFg, easedProgress);
+      ++transitioningItemCount;
+    } else {
+      item.colors = item.endColors;
+      item.animationStartTime = -1;
+    }
+    update(item.rect);
+  }
 
-    item.bgColorAnimation->start();
-    item.fgColorAnimation->start();
-    item.badgeBgAnimation->start();
-    item.badgeFgAnimation->start();
+  if (transitioningItemCount == 0) {
+    _itemsAnimation.stop();
   }
 }
 
@@ -636,18 +672,26 @@ void AbstractItemListWidget::setFocusedIndex(int index) {
 void AbstractItemListWidget::setHoveredIndex(int index, bool updateAnims) {
   index = index < 0 || index > itemCount() - 1 ? -1 : index;
   if (index != _hoveredIndex) {
+    const auto previousIndex = _hoveredIndex;
     _hoveredIndex = index;
-    if (updateAnims)
-      updateItemsAnimations();
+    if (updateAnims) {
+      // Only the items whose state changed need a transition.
+      updateItemAnimation(previousIndex);
+      updateItemAnimation(index);
+    }
   }
 }
 
 void AbstractItemListWidget::setPressedIndex(int index, bool updateAnims) {
   index = index < 0 || index > itemCount() - 1 ? -1 : index;
   if (index != _pressedIndex) {
+    const auto previousIndex = _pressedIndex;
     _pressedIndex = index;
-    if (updateAnims)
-      updateItemsAnimations();
+    if (updateAnims) {
+      // Only the items whose state changed need a transition.
+      updateItemAnimation(previousIndex);
+      updateItemAnimation(index);
+    }
   }
 }
 
@@ -667,24 +711,35 @@ void AbstractItemListWidget::initStyleOptionFocus(QStyleOptionFocusRoundedRect&
   opt.radiuses = getItemRadius();
 }
 
-void AbstractItemListWidget::paintEvent(QPaintEvent*) {
+void AbstractItemListWidget::paintEvent(QPaintEvent* e) {
   QPainter p(this);
   p.setRenderHint(QPainter::Antialiasing, true);
 
+  // Only draw what intersects the damaged region.
+  const auto& region = e->region();
+
   // Background.
-  drawBackground(p);
+  if (region.intersects(actualRect())) {
+    drawBackground(p);
+  }
 
   // Items backgrounds.
   for (const auto& item : _items) {
-    drawItemBackground(p, item);
+    if (region.intersects(item.rect)) {
+      drawItemBackground(p, item);
+    }
   }
 
   // Current item background (drawn above items backgrounds).
-  drawCurrentItemIndicator(p);
+  if (region.intersects(getAnimatedCurrentItemRect())) {
+    drawCurrentItemIndicator(p);
+  }
 
   // Items foregrounds.
   for (const auto& item : _items) {
-    drawItemForeground(p, item);
+    if (region.intersects(item.rect)) {
+      drawItemForeground(p, item);
+    }
   }
 }
 
@@ -715,7 +770,10 @@ void AbstractItemListWidget::showEvent(QShowEvent* e) {
     _currentIndexAnimation.setDuration(animDuration);
     _currentIndexAnimation.setEasingCurve(QEasingCurve::Type::InOutCubic);
     QObject::connect(&_currentIndexAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-      update();
+      // Only repaint the area swept by the current item indicator.
+      const auto currentItemRect = getAnimatedCurrentItemRect();
+      update(_currentItemIndicatorRect.united(currentItemRect));
+      _currentItemIndicatorRect = currentItemRect;
     });
   }
 
@@ -730,12 +788,28 @@ bool AbstractItemListWidget::event(QEvent* e) {
 }
 
 void AbstractItemListWidget::changeEvent(QEvent* e) {
-  if (QEvent::EnabledChange == e->type()) {
+  const auto type = e->type();
+  if (QEvent::EnabledChange == type) {
     updateItemsAnimations();
+  } else if (QEvent::FontChange == type || QEvent::StyleChange == type) {
+    if (QEvent::StyleChange == type) {
+      connectToThemeChanges();
+    }
+    invalidateItemsLayout();
   }
   QWidget::changeEvent(e);
 }
 
+void AbstractItemListWidget::connectToThemeChanges() {
+  // A theme may change metrics without changing the font, so no FontChange event would be received.
+  QObject::disconnect(_themeChangedConnection);
+  if (auto* qlementineStyle = qobject_cast<QlementineStyle*>(style())) {
+    _themeChangedConnection = QObject::connect(qlementineStyle, &QlementineStyle::themeChanged, this, [this]() {
+      invalidateItemsLayout();
+    });
+  }
+}
+
 QMargins AbstractItemListWidget::getPadding() const {
   const auto* style = this->style();
   const auto left = style->pixelMetric(QStyle::PM_LayoutLeftMargin) / 4;
@@ -796,7 +870,7 @@ void AbstractItemListWidget::drawItemBackground(QPainter& p, const Item& item) c
   const auto currentItemRect = getAnimatedCurrentItemRect();
   const auto radius = getItemRadius();
   if (shouldDrawItemBgForCurrent() || itemRect.x() != currentItemRect.x()) {
-    const auto itemBgColor = item.bgColorAnimation->currentValue().value<QColor>();
+    const auto& itemBgColor = item.colors.bg;
     p.setPen(Qt::NoPen);
     p.setBrush(itemBgColor);
     p.drawRoundedRect(itemRect, radius, radius);
@@ -818,7 +892,7 @@ void AbstractItemListWidget::drawItemForeground(QPainter& p, const Item& item) c
   const auto itemContentX = itemRect.x() + (itemRect.width() - itemContentW) / 2;
   const auto itemContentY = itemRect.y();
   const auto itemContentRect = QRect{ QPoint{ itemContentX, itemContentY }, QSize{ itemContentW, itemContentH } };
-  const auto itemFgColor = item.fgColorAnimation->currentValue().value<QColor>();
+  const auto& itemFgColor = item.colors.fg;
   const auto hasIcon = !item.icon.isNull();
   const auto hasText = !item.text.isEmpty();
   const auto hasBadge = !item.badge.isEmpty();
@@ -894,8 +968,8 @@ void AbstractItemListWidget::drawItemForeground(QPainter& p, const Item& item) c
   if (showBadge) {
     const auto badgeTextRect = badgeRect.marginsRemoved(badgePadding);
     const auto textFlags = Qt::AlignVCenter | Qt::AlignHCenter | Qt::TextSingleLine;
-    const auto badgeBgColor = item.badgeBgAnimation->currentValue().value<QColor>();
-    const auto badgeFgColor = item.badgeFgAnimation->currentValue().value<QColor>();
+    const auto& badgeBgColor = item.colors.badgeBg;
+    const auto& badgeFgColor = item.colors.badgeFg;
 
     // Draw background.
     p.setPen(Qt::NoPen);
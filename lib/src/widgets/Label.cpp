@@ -62,7 +62,8 @@ bool Label::eventFilter(QObject* obj, QEvent* e) {
 void Label::updatePaletteFromTheme() {
   if (const auto* qlementineStyle = qobject_cast<QlementineStyle*>(style())) {
     const auto& font = qlementineStyle->fontForTextRole(_role);
-    const auto palette = qlementineStyle->paletteForTextRole(_role);
+    // Always the same QPalette for the same theme, so setPalette() doesn't do anything if it hasn't changed.
+    const auto& palette = qlementineStyle->paletteForTextRole(_role);
     setFont(font);
     setPalette(palette);
     updateGeometry();
@@ -2,17 +2,153 @@
 // SPDX-License-Identifier: MIT
 #include <oclero/qlementine/widgets/LoadingSpinner.hpp>
 
+#include <oclero/qlementine/utils/WidgetUtils.hpp>
+#include <oclero/qlementine/animation/AnimationClock.hpp>
+
 #include <QStyle>
 #include <QPainter>
 #include <QPaintEvent>
-#include <QTimerEvent>
+#include <QPixmapCache>
+#include <QPointer>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QCoreApplication>
 
-#include <math.h>
+#include <cmath>
+#include <unordered_set>
 
 namespace {
+constexpr auto frameCount = 12;
+constexpr auto frameDuration = 128; // ms
+
 qreal easeOutQuad(const qreal x) {
   return x * x * x * x;
 }
+
+/// A single timer shared by all the spinners, so they are all in phase,
+/// and their cost doesn't depend on how many of them are spinning.
+class SpinnerTicker : public QObject {
+public:
+  static SpinnerTicker& instance() {
+    if (!_instance) {
+      _instance = new SpinnerTicker(QCoreApplication::instance());
+    }
+    return *_instance;
+  }
+
+  static SpinnerTicker* existingInstance() {
+    return _instance.data();
+  }
+
+  // The frame only depends on time, so it can be controlled with an AnimationClock.
+  int frame() const {
+    const auto* clock = oclero::qlementine::AnimationClock::installedClock();
+    const auto time = clock ? clock->currentTime() : _elapsedTimer.elapsed();
+    return static_cast<int>((time / frameDuration) % frameCount);
+  }
+
+  // Called at each paint of each spinner, so it must not depend on the number of spinners.
+  void subscribe(QWidget* spinner) {
+    _spinners.insert(spinner);
+
+    if (auto* clock = oclero::qlementine::AnimationClock::installedClock()) {
+      // The virtual clock drives the repaints.
+      _timer.stop();
+      QObject::connect(clock, &oclero::qlementine::AnimationClock::currentTimeChanged, this, &SpinnerTicker::tick,
+        Qt::UniqueConnection);
+    } else if (!_timer.isActive()) {
+      _timer.start();
+    }
+  }
+
+  void unsubscribe(QWidget* spinner) {
+    _spinners.erase(spinner);
+    if (_spinners.empty()) {
+      _timer.stop();
+    }
+  }
+
+private:
+  explicit SpinnerTicker(QObject* parent)
+    : QObject(parent) {
+    _timer.setInterval(frameDuration);
+    QObject::connect(&_timer, &QTimer::timeout, this, &SpinnerTicker::tick);
+    _elapsedTimer.start();
+  }
+
+  void tick() {
+    // Minimized, not exposed or scrolled out of view: paused until their next paint event.
+    for (auto it = _spinners.begin(); it != _spinners.end();) {
+      if (!oclero::qlementine::isWidgetVisibleOnScreen(*it)) {
+        it = _spinners.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    for (auto* spinner : _spinners) {
+      spinner->update();
+    }
+
+    if (_spinners.empty() || oclero::qlementine::AnimationClock::installedClock()) {
+      _timer.stop();
+    }
+  }
+
+  static QPointer<SpinnerTicker> _instance;
+  QTimer _timer;
+  QElapsedTimer _elapsedTimer;
+  std::unordered_set<QWidget*> _spinners;
+};
+
+QPointer<SpinnerTicker> SpinnerTicker::_instance;
+
+/// Gets (or renders if not in cache yet) the strip containing all the frames of the animation, side by side.
+QPixmap getSpinnerFrames(const int diameter, const QColor& color, const qreal devicePixelRatio) {
+  const auto cacheKey = QString("qlementine_spinner_%1_%2_%3")
+                          .arg(diameter)
+                          .arg(color.rgba(), 8, 16, QChar('0'))
+                          .arg(devicePixelRatio);
+  QPixmap frames;
+  if (QPixmapCache::find(cacheKey, &frames)) {
+    return frames;
+  }
+
+  const auto frameExtent = static_cast<int>(std::ceil(diameter * devicePixelRatio));
+  frames = QPixmap(frameExtent * frameCount, frameExtent);
+  frames.fill(Qt::transparent);
+
+  QPainter painter(&frames);
+  painter.setRenderHint(QPainter::Antialiasing, true);
+  painter.setPen(Qt::NoPen);
+
+  constexpr auto totalAngle = 360;
+  constexpr auto itemAngle = totalAngle / frameCount;
+  const auto itemWidth = diameter / 8.;
+  const auto itemHeight = diameter / 4.;
+  const auto itemRect = QRectF(QPointF(-itemWidth / 2., -diameter / 2.), QSizeF(itemWidth, itemHeight));
+  const auto radius = itemWidth / 2.25;
+
+  for (auto frame = 0; frame < frameCount; ++frame) {
+    painter.save();
+    painter.translate(frame * frameExtent + frameExtent / 2., frameExtent / 2.);
+    painter.scale(devicePixelRatio, devicePixelRatio);
+    painter.rotate(((frame + 1) * itemAngle) % totalAngle);
+
+    for (auto i = 0; i < frameCount; ++i) {
+      const auto alpha = 255. * easeOutQuad(i / static_cast<qreal>(frameCount - 1));
+      painter.setBrush(QColor(color.red(), color.green(), color.blue(), static_cast<int>(alpha)));
+      painter.drawRoundedRect(itemRect, radius, radius);
+      painter.rotate(itemAngle);
+    }
+
+    painter.restore();
+  }
+  painter.end();
+
+  QPixmapCache::insert(cacheKey, frames);
+  return frames;
+}
 } // namespace
 
 namespace oclero::qlementine {
@@ -23,6 +159,12 @@ LoadingSpinner::LoadingSpinner(QWidget* parent)
   setAttribute(Qt::WA_TransparentForMouseEvents);
 }
 
+LoadingSpinner::~LoadingSpinner() {
+  if (auto* ticker = SpinnerTicker::existingInstance()) {
+    ticker->unsubscribe(this);
+  }
+}
+
 bool LoadingSpinner::spinning() const {
   return _spinning;
 }
@@ -32,13 +174,9 @@ void LoadingSpinner::setSpinning(bool spinning) {
     _spinning = spinning;
 
     if (_spinning && isVisible()) {
-      _timerId = startTimer(128);
+      SpinnerTicker::instance().subscribe(this);
     } else {
-      if (_timerId != -1) {
-        killTimer(_timerId);
-      }
-      _timerId = -1;
-      _i = 0;
+      SpinnerTicker::instance().unsubscribe(this);
     }
 
     Q_EMIT spinningChanged();
@@ -62,61 +200,36 @@ void LoadingSpinner::paintEvent(QPaintEvent*) {
   if (!_spinning)
     return;
 
-  QPainter painter(this);
-  painter.setRenderHint(QPainter::Antialiasing, true);
-  painter.setPen(Qt::NoPen);
+  // The spinner may have been paused while it couldn't be seen.
+  auto& ticker = SpinnerTicker::instance();
+  ticker.subscribe(this);
 
   const auto rect = this->rect();
   const auto diameter = qMin(rect.width(), rect.height());
-  const auto ellipseTopLeft = QPointF((rect.width() - diameter) / 2., (rect.height() - diameter) / 2.);
-  const auto ellipseCenter = ellipseTopLeft + QPointF(diameter / 2., diameter / 2.);
-  painter.translate(ellipseCenter);
+  if (diameter <= 0)
+    return;
 
-  constexpr auto itemCount = 12;
-  constexpr auto totalAngle = 360;
-  constexpr auto itemAngle = totalAngle / itemCount;
-  const auto startAngle = ((_i + 1) * itemAngle) % totalAngle;
-  painter.rotate(startAngle);
-
-  const auto baseColor = palette().text().color();
-  for (auto i = 0; i < itemCount; ++i) {
-    const auto itemWidth = diameter / 8.;
-    const auto itemHeight = diameter / 4.;
-    const auto itemX = -itemWidth / 2.;
-    const auto itemY = -diameter / 2.;
-    const auto itemRect = QRectF(QPointF(itemX, itemY), QSizeF(itemWidth, itemHeight));
-    const auto radius = itemWidth / 2.25;
-    const auto alpha = 255. * easeOutQuad(i / static_cast<qreal>(itemCount - 1));
-    const auto color = QColor(baseColor.red(), baseColor.green(), baseColor.blue(), alpha);
-    painter.setBrush(color);
-    painter.drawRoundedRect(itemRect, radius, radius);
-
-    painter.rotate(itemAngle);
-  }
-}
+  // All the frames are rendered once, then each frame is just a blit.
+  const auto frames = getSpinnerFrames(diameter, palette().text().color(), devicePixelRatio());
+  const auto frameExtent = frames.height();
+  const auto targetRect =
+    QRectF(QPointF((rect.width() - diameter) / 2., (rect.height() - diameter) / 2.), QSizeF(diameter, diameter));
+  const auto sourceRect = QRectF(ticker.frame() * frameExtent, 0, frameExtent, frameExtent);
 
-void LoadingSpinner::timerEvent(QTimerEvent* evt) {
-  if (evt->timerId() == _timerId) {
-    _i = (_i + 1) % 12;
-    if (isVisible()) {
-      update();
-    }
-  }
+  QPainter painter(this);
+  painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+  painter.drawPixmap(targetRect, frames, sourceRect);
 }
 
 void LoadingSpinner::showEvent(QShowEvent* evt) {
   QWidget::showEvent(evt);
   if (_spinning) {
-    _timerId = startTimer(128);
+    SpinnerTicker::instance().subscribe(this);
   }
 }
 
 void LoadingSpinner::hideEvent(QHideEvent* evt) {
   QWidget::hideEvent(evt);
-  if (_timerId != -1) {
-    killTimer(_timerId);
-  }
-  _timerId = -1;
-  _i = 0;
+  SpinnerTicker::instance().unsubscribe(this);
 }
 } // namespace oclero::qlementine
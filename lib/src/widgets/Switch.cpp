@@ -11,10 +11,13 @@
 #include <oclero/qlementine/utils/ImageUtils.hpp>
 #include <oclero/qlementine/utils/FontUtils.hpp>
 #include <oclero/qlementine/utils/PrimitiveUtils.hpp>
+#include <oclero/qlementine/utils/ColorUtils.hpp>
 
 #include <QPainter>
 #include <QEvent>
 
+#include <cmath>
+
 namespace oclero::qlementine {
 Switch::Switch(QWidget* parent)
   : QAbstractButton(parent) {
@@ -68,9 +71,9 @@ void Switch::paintEvent(QPaintEvent*) {
   // Draw switch button.
   const auto switchRect = getSwitchRect();
   const auto switchRadius = switchRect.height() / 2.;
-  const auto& bgColor = _bgAnimation.currentValue().value<QColor>();
-  const auto& fgColor = _fgAnimation.currentValue().value<QColor>();
-  const auto& borderColor = _borderAnimation.currentValue().value<QColor>();
+  const auto& bgColor = _animationState.bgColor;
+  const auto& fgColor = _animationState.fgColor;
+  const auto& borderColor = _animationState.borderColor;
   const auto& textColor = getTextColor();
   const auto borderW = 1.0;
   const auto halfBorderW = borderW / 2.;
@@ -81,8 +84,8 @@ void Switch::paintEvent(QPaintEvent*) {
   drawRoundedRectBorder(&p, switchRect, borderColor, borderW, switchRadius);
 
   // Draw handle.
-  const auto handleXRatio = _handleAnimation.currentValue().toDouble();
-  const auto handlePadding = _handlePaddingAnimation.currentValue().toInt();
+  const auto handleXRatio = _animationState.handleXRatio;
+  const auto handlePadding = static_cast<int>(std::round(_animationState.handlePadding));
   const auto handleDiameter = static_cast<double>(switchRect.height() - handlePadding * 2);
   const auto handleGrooveWidth = switchRect.width() - handlePadding * 2 - handleDiameter;
   const auto handleX = switchRect.x() + handlePadding + handleGrooveWidth * handleXRatio;
@@ -100,7 +103,7 @@ void Switch::paintEvent(QPaintEvent*) {
     p.setBrush(Qt::NoBrush);
     p.setPen(QPen{ bgColor, checkThickness, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin });
     if (checkState() == Qt::Checked) {
-      drawCheckBoxIndicator(handleRect.toRect(), &p, _symbolAnimation.currentValue().toReal());
+      drawCheckBoxIndicator(handleRect.toRect(), &p, _animationState.symbolProgress);
     } else {
       drawCloseIndicator(handleRect.toRect().marginsRemoved({ 1, 1, 1, 1 }), &p);
     }
@@ -188,79 +191,59 @@ void Switch::nextCheckState() {
 
 void Switch::startAnimation() {
   const auto animationDuration = isVisible() ? style()->styleHint(QStyle::SH_Widget_Animation_Duration) : 0;
-
-  const auto currentBg = _bgAnimation.currentValue();
-  _bgAnimation.stop();
-  _bgAnimation.setDuration(animationDuration);
-  _bgAnimation.setStartValue(currentBg);
-  _bgAnimation.setEndValue(getBgColor());
-  _bgAnimation.start();
-
-  const auto currentBorder = _borderAnimation.currentValue();
-  _borderAnimation.stop();
-  _borderAnimation.setDuration(animationDuration);
-  _borderAnimation.setStartValue(currentBorder);
-  _borderAnimation.setEndValue(getBorderColor());
-  _borderAnimation.start();
-
-  const auto currentFg = _fgAnimation.currentValue();
-  _fgAnimation.stop();
-  _fgAnimation.setDuration(animationDuration);
-  _fgAnimation.setStartValue(currentFg);
-  _fgAnimation.setEndValue(getFgColor());
-  _fgAnimation.start();
-
-  const auto currentXRatio = _handleAnimation.currentValue();
   const auto state = checkState();
-  _handleAnimation.stop();
-  _handleAnimation.setDuration(animationDuration);
-  _handleAnimation.setStartValue(currentXRatio);
-  _handleAnimation.setEndValue(state == Qt::Checked ? 1. : (state == Qt::Unchecked ? 0. : 0.5));
-  _handleAnimation.start();
-
-  const auto currentPadding = _handlePaddingAnimation.currentValue();
-  _handlePaddingAnimation.stop();
-  _handlePaddingAnimation.setDuration(animationDuration);
-  _handlePaddingAnimation.setStartValue(currentPadding);
-  _handlePaddingAnimation.setEndValue(_fullHandlePadding * (state == Qt::PartiallyChecked ? 3. : 1.));
-  _handlePaddingAnimation.start();
-
-  const auto currentSymbol = _symbolAnimation.currentValue();
-  _symbolAnimation.stop();
-  _symbolAnimation.setDuration(animationDuration);
-  _symbolAnimation.setStartValue(currentSymbol);
-  _symbolAnimation.setEndValue(1.);
-  _symbolAnimation.start();
-}
 
-void Switch::setupAnimation() {
-  constexpr auto animationDuration = 0; // Don't animate before it is shown.
-
-  const auto& startBgColor = getBgColor();
-  _bgAnimation.setDuration(animationDuration);
-  _bgAnimation.setEasingCurve(QEasingCurve::Type::OutCubic);
-  _bgAnimation.setStartValue(startBgColor);
-  _bgAnimation.setEndValue(startBgColor);
-  QObject::connect(&_bgAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-    update();
-  });
+  _animation.stop();
+  _animationStartState = _animationState;
+  _animationEndState = AnimationState{
+    getBgColor(),
+    getBorderColor(),
+    getFgColor(),
+    state == Qt::Checked ? 1. : (state == Qt::Unchecked ? 0. : 0.5),
+    _fullHandlePadding * (state == Qt::PartiallyChecked ? 3. : 1.),
+    1.,
+  };
+
+  if (animationDuration > 0) {
+    _animation.setDuration(animationDuration);
+    _animation.start();
+  } else {
+    updateAnimationState(1.);
+  }
+}
 
-  const auto& startBorderColor = getBorderColor();
-  _borderAnimation.setDuration(animationDuration);
-  _borderAnimation.setEasingCurve(QEasingCurve::Type::OutCubic);
-  _borderAnimation.setStartValue(startBorderColor);
-  _borderAnimation.setEndValue(startBorderColor);
-  QObject::connect(&_borderAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-    update();
-  });
+void Switch::updateAnimationState(double progress) {
+  const auto& start = _animationStartState;
+  const auto& end = _animationEndState;
+  _animationState.bgColor = interpolateColor(start.bgColor, end.bgColor, progress);
+  _animationState.borderColor = interpolateColor(start.borderColor, end.borderColor, progress);
+  _animationState.fgColor = interpolateColor(start.fgColor, end.fgColor, progress);
+  _animationState.handleXRatio = start.handleXRatio + (end.handleXRatio - start.handleXRatio) * progress;
+  _animationState.handlePadding = start.handlePadding + (end.handlePadding - start.handlePadding) * progress;
+  _animationState.symbolProgress = start.symbolProgress + (end.symbolProgress - start.symbolProgress) * progress;
+
+  // Only one repaint per tick, whatever the number of animated values.
+  update();
+}
 
-  const auto& startFgColor = getFgColor();
-  _fgAnimation.setDuration(animationDuration);
-  _fgAnimation.setEasingCurve(QEasingCurve::Type::OutCubic);
-  _fgAnimation.setStartValue(startFgColor);
-  _fgAnimation.setEndValue(startFgColor);
-  QObject::connect(&_fgAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-    update();
+void Switch::setupAnimation() {
+  // Don't animate before it is shown.
+  _animationState = AnimationState{
+    getBgColor(),
+    getBorderColor(),
+    getFgColor(),
+    0.,
+    _fullHandlePadding,
+    0.,
+  };
+  _animationStartState = _animationState;
+  _animationEndState = _animationState;
+
+  _animation.setEasingCurve(QEasingCurve::Type::OutCubic);
+  _animation.setStartValue(0.);
+  _animation.setEndValue(1.);
+  QObject::connect(&_animation, &QVariantAnimation::valueChanged, this, [this](const QVariant& value) {
+    updateAnimationState(value.toDouble());
   });
 
   QObject::connect(this, &QAbstractButton::pressed, this, [this]() {
@@ -275,30 +258,6 @@ void Switch::setupAnimation() {
   QObject::connect(this, &Switch::checkStateChanged, this, [this]() {
     startAnimation();
   });
-
-  _handleAnimation.setDuration(animationDuration);
-  _handleAnimation.setEasingCurve(QEasingCurve::Type::OutCubic);
-  _handleAnimation.setStartValue(0.);
-  _handleAnimation.setEndValue(0.);
-  QObject::connect(&_handleAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-    update();
-  });
-
-  _handlePaddingAnimation.setDuration(animationDuration);
-  _handlePaddingAnimation.setEasingCurve(QEasingCurve::Type::OutCubic);
-  _handlePaddingAnimation.setStartValue(_fullHandlePadding);
-  _handlePaddingAnimation.setEndValue(_fullHandlePadding);
-  QObject::connect(&_handlePaddingAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-    update();
-  });
-
-  _symbolAnimation.setDuration(animationDuration);
-  _symbolAnimation.setEasingCurve(QEasingCurve::Type::OutCubic);
-  _symbolAnimation.setStartValue(0.);
-  _symbolAnimation.setEndValue(0.);
-  QObject::connect(&_symbolAnimation, &QVariantAnimation::valueChanged, this, [this]() {
-    update();
-  });
 }
 
 const QColor& Switch::getBgColor() const {
@@ -1765,15 +1765,16 @@ Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deseru
     themeEditorDialogLayout->addWidget(themeEditorScrollView, 1);
 
     auto* themeEditor = new ThemeEditor(themeEditorScrollView);
-    themeEditor->setTheme(qobject_cast<const QlementineStyle*>(owner.style())->theme());
+    themeEditor->setTheme(qobject_cast<const QlementineStyle*>(owner.style())->sharedTheme());
     themeEditorScrollView->setWidget(themeEditor);
 
+    // Both share the same theme, so no copy is made when it goes back and forth.
     auto* qlementineStyle = qobject_cast<QlementineStyle*>(owner.style());
-    QObject::connect(themeEditor, &ThemeEditor::themeChanged, &owner, [qlementineStyle](const Theme& theme) {
-      qlementineStyle->setTheme(theme);
+    QObject::connect(themeEditor, &ThemeEditor::themeChanged, &owner, [qlementineStyle, themeEditor]() {
+      qlementineStyle->setTheme(themeEditor->sharedTheme());
     });
     QObject::connect(qlementineStyle, &QlementineStyle::themeChanged, &owner, [qlementineStyle, themeEditor]() {
-      themeEditor->setTheme(qlementineStyle->theme());
+      themeEditor->setTheme(qlementineStyle->sharedTheme());
     });
 
     themeEditorDialog->installEventFilter(&owner);
@@ -259,11 +259,11 @@ struct ShowcaseWindow::Impl {
           auto* themeActionGroup = new QActionGroup(themeMenu);
           themeActionGroup->setExclusive(true);
 
-          const auto& themes = themeManager->themes();
           const auto currentTheme = themeManager->currentTheme();
 
-          for (const auto& theme : themes) {
-            const auto name = theme.meta.name;
+          // Only the metadata is needed: don't load all the themes.
+          for (auto i = 0; i < themeManager->themeCount(); ++i) {
+            const auto name = themeManager->themeMeta(i).name;
             const auto icon = name == "Dark" ? makeThemedIcon(Icons16::Misc_Moon) : makeThemedIcon(Icons16::Misc_Sun);
             auto* action = themeMenu->addAction(icon, name);
             action->setCheckable(true);
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: Olivier Cléro <oclero@hotmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QTextStream>
+
+#include <oclero/qlementine/style/Theme.hpp>
+
+// Compiles Qlementine JSON themes to the binary format loaded by Theme::fromBinaryPath().
+// Usage: qlementine-themec [-platform offscreen] input.json [output.qltheme]
+int main(int argc, char* argv[]) {
+  // A QGuiApplication is needed since themes compute their fonts for the screen.
+  QGuiApplication application(argc, argv);
+  QCoreApplication::setApplicationName("qlementine-themec");
+  QCoreApplication::setApplicationVersion("1.0.0");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Compiles a Qlementine JSON theme to the binary theme format.");
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addPositionalArgument("input", "JSON theme to compile.");
+  parser.addPositionalArgument("output", "Binary theme to write. Defaults to the input path with the binary suffix.");
+  parser.process(application);
+
+  QTextStream err(stderr);
+  const auto args = parser.positionalArguments();
+  if (args.isEmpty() || args.size() > 2) {
+    parser.showHelp(1);
+  }
+
+  const auto& inputPath = args.at(0);
+  const QFileInfo inputInfo(inputPath);
+  const auto outputPath =
+    args.size() > 1
+      ? args.at(1)
+      : inputInfo.dir().filePath(inputInfo.completeBaseName() + '.' + oclero::qlementine::Theme::binaryFileSuffix);
+
+  if (!oclero::qlementine::Theme::convertJsonToBinary(inputPath, outputPath)) {
+    err << "Can't compile " << inputPath << " to " << outputPath << Qt::endl;
+    return 1;
+  }
+
+  return 0;
+}